@@ -125,7 +125,10 @@ Operation:
 - call the pre-processing function on derived class to allow it to prepare for the audio buffer's arrival
 - call the frame processing function that the derived class MUST implement repeatedly until the buffer is processed
 - call the post-processing function on derived class to allow it to do any stuff that requires the buffer to be processed first
-- NOTE: if you want the derived class to process buffers instead of frames, override and implement THIS function in the derived class
+- buffer mode (pluginDescriptor.processFrames = false): no frames are built; processAudioBlock() is called once with the
+  channel buffers as they are, between the pre- and post-processing functions; it fires the MIDI events and does the
+  parameter updates with fireBufferMidiEvents() and doBufferParameterUpdates()
+- hostInfo is advanced past the buffer in both modes
 
 \param processBufferInfo - a structure of information about the current buffer to process; includes information from host (BPM, etc...)
 
@@ -133,6 +136,21 @@ Operation:
 */
 bool PluginBase::processAudioBuffers(ProcessBufferInfo& processBufferInfo)
 {
+	// --- buffer mode: the derived class works on the buffers directly
+	if (!pluginDescriptor.processFrames)
+	{
+		preProcessAudioBuffers(processBufferInfo);
+		processAudioBlock(processBufferInfo);
+
+		// --- hostInfo ends up where the frame loop would leave it
+		advanceHostInfo(processBufferInfo.hostInfo, processBufferInfo.numFramesToProcess);
+
+		postProcessAudioBuffers(processBufferInfo);
+		midiEventFrame = 0;
+
+		return true; /// processed
+	}
+
 	memset(&inputFrame, 0, sizeof(float)*MAX_CHANNEL_COUNT);
 	memset(&outputFrame, 0, sizeof(float)*MAX_CHANNEL_COUNT);
 	memset(&auxInputFrame, 0, sizeof(float)*MAX_CHANNEL_COUNT);
@@ -197,6 +215,7 @@ bool PluginBase::processAudioBuffers(ProcessBufferInfo& processBufferInfo)
 
 		// --- generally not used
 		postProcessAudioBuffers(processBufferInfo);
+		midiEventFrame = 0;
 
 		return true; /// processed
 	}
@@ -204,6 +223,72 @@ bool PluginBase::processAudioBuffers(ProcessBufferInfo& processBufferInfo)
 	return false; /// processed
 }
 
+/**
+\brief fire the MIDI events for one frame of the buffer
+
+\param midiEventQueue the buffer's queue; may be nullptr
+\param frame the buffer frame; getMidiEventFrame() returns it while the events are processed
+*/
+void PluginBase::fireFrameMidiEvents(IMidiEventQueue* midiEventQueue, uint32_t frame)
+{
+	if (!midiEventQueue)
+		return;
+
+	midiEventFrame = frame;
+	midiEventQueue->fireMidiEvents(frame);
+}
+
+/**
+\brief buffer mode: fire all of the buffer's MIDI events before it is processed
+
+NOTE:
+- the queue only fires by frame, so every frame is visited; this is one call per frame, not a frame build
+- the derived class queues the events at getMidiEventFrame() and renders them at that frame
+
+\param processInfo the buffer being processed
+*/
+void PluginBase::fireBufferMidiEvents(ProcessBufferInfo& processInfo)
+{
+	if (!processInfo.midiEventQueue)
+		return;
+
+	for (uint32_t frame = 0; frame < processInfo.numFramesToProcess; frame++)
+		fireFrameMidiEvents(processInfo.midiEventQueue, frame);
+
+	midiEventFrame = 0;
+}
+
+/**
+\brief buffer mode: run the per-frame smoothing and VST3 sample accurate updates for a run of frames;
+the bound variables end up where the frame loop would leave them
+
+\param numFrames frames to run
+*/
+void PluginBase::doBufferParameterUpdates(uint32_t numFrames)
+{
+	if (numSmoothablePluginParameters == 0)
+		return;
+
+	for (uint32_t frame = 0; frame < numFrames; frame++)
+		doSampleAccurateParameterUpdates();
+}
+
+/**
+\brief advance the host's sample index and time by a number of frames
+
+\param hostInfo the buffer's host information; may be nullptr
+\param numFrames frames processed
+*/
+void PluginBase::advanceHostInfo(HostInfo* hostInfo, uint32_t numFrames)
+{
+	if (!hostInfo)
+		return;
+
+	double sampleInterval = 1.0 / audioProcDescriptor.sampleRate;
+	hostInfo->uAbsoluteFrameBufferIndex += numFrames;
+	hostInfo->dAbsoluteFrameBufferTime += numFrames * sampleInterval;
+}
+
 /**
 \brief copy newly updated metering variables into GUI parameters for display
 
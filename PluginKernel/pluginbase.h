@@ -256,6 +256,21 @@ public:
 	/** Buffer Proc Cycle: II PluginCore overrides this method to process frames */
 	virtual bool processAudioBuffers(ProcessBufferInfo& processInfo);
 
+	/** Buffer Proc Cycle: II (buffer mode, pluginDescriptor.processFrames = false) process the whole buffer from the non-interleaved channel pointers in processInfo */
+	virtual bool processAudioBlock(ProcessBufferInfo& processInfo) { return false; }
+
+	/** fire the MIDI events for one frame; getMidiEventFrame() returns that frame while they are processed */
+	void fireFrameMidiEvents(IMidiEventQueue* midiEventQueue, uint32_t frame);
+
+	/** buffer mode: fire all of the buffer's MIDI events up front, in frame order */
+	void fireBufferMidiEvents(ProcessBufferInfo& processInfo);
+
+	/** buffer frame of the MIDI event being processed; 0 outside of the MIDI firing helpers */
+	uint32_t getMidiEventFrame() { return midiEventFrame; }
+
+	/** buffer mode: parameter smoothing and VST3 sample accurate updates for a run of frames */
+	void doBufferParameterUpdates(uint32_t numFrames);
+
 	/** Buffer Proc Cycle: III connects meter variables to outbound GUI control changes (part of ASPiK output variable binding option) */
 	bool updateOutBoundVariables();
 
@@ -590,6 +605,12 @@ protected:
 	AudioProcDescriptor audioProcDescriptor;	///< current audio processing description
 	PluginInfo pluginInfo;						///< info about the DLL (component) itself, includes path to DLL
 
+	// --- frame of the MIDI events being fired
+	uint32_t midiEventFrame = 0;				///< buffer frame of the MIDI event being processed
+
+	/** move hostInfo past the processed frames, the same way the frame loop does */
+	void advanceHostInfo(HostInfo* hostInfo, uint32_t numFrames);
+
     // --- arrays for frame processing
     float inputFrame[MAX_CHANNEL_COUNT];		///< input array for frame processing
     float outputFrame[MAX_CHANNEL_COUNT];		///< output array for frame processing
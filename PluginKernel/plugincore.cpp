@@ -549,6 +549,345 @@ bool PluginCore::initPluginParameters()
 	piParam->setBoundVariable(&unisonDetune_cents, boundVariableType::kDouble);
 	addPluginParameter(piParam);
 
+	// --- discrete control: Osc1 Type
+	piParam = new PluginParameter(controlID::osc1_type, "Osc1 Type", "Wavetable,Morphing,Sample", "Wavetable");
+	piParam->setBoundVariable(&osc1_type, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- continuous control: Osc1 Morph
+	piParam = new PluginParameter(controlID::osc1_morph, "Osc1 Morph", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&osc1_morph, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- discrete control: Osc2 Type
+	piParam = new PluginParameter(controlID::osc2_type, "Osc2 Type", "Wavetable,Morphing,Sample", "Wavetable");
+	piParam->setBoundVariable(&osc2_type, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- continuous control: Osc2 Morph
+	piParam = new PluginParameter(controlID::osc2_morph, "Osc2 Morph", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&osc2_morph, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- discrete control: Osc3 Type
+	piParam = new PluginParameter(controlID::osc3_type, "Osc3 Type", "Wavetable,Morphing,Sample", "Wavetable");
+	piParam->setBoundVariable(&osc3_type, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- continuous control: Osc3 Morph
+	piParam = new PluginParameter(controlID::osc3_morph, "Osc3 Morph", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&osc3_morph, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- discrete control: Osc4 Type
+	piParam = new PluginParameter(controlID::osc4_type, "Osc4 Type", "Wavetable,Morphing,Sample", "Wavetable");
+	piParam->setBoundVariable(&osc4_type, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- continuous control: Osc4 Morph
+	piParam = new PluginParameter(controlID::osc4_morph, "Osc4 Morph", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&osc4_morph, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: Unison Voices
+	piParam = new PluginParameter(controlID::unisonVoices, "Unison Voices", "", controlVariableType::kInt, 1.000000, 16.000000, 4.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&unisonVoices, boundVariableType::kInt);
+	addPluginParameter(piParam);
+
+	// --- discrete control: Poly Unison
+	piParam = new PluginParameter(controlID::enablePolyUnison, "Poly Unison", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
+	piParam->setBoundVariable(&enablePolyUnison, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FM 1>1
+	piParam = new PluginParameter(controlID::fm1to1, "FM 1>1", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fm1to1, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FM 1>2
+	piParam = new PluginParameter(controlID::fm1to2, "FM 1>2", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fm1to2, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FM 1>3
+	piParam = new PluginParameter(controlID::fm1to3, "FM 1>3", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fm1to3, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FM 1>4
+	piParam = new PluginParameter(controlID::fm1to4, "FM 1>4", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fm1to4, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FM 2>1
+	piParam = new PluginParameter(controlID::fm2to1, "FM 2>1", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fm2to1, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FM 2>2
+	piParam = new PluginParameter(controlID::fm2to2, "FM 2>2", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fm2to2, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FM 2>3
+	piParam = new PluginParameter(controlID::fm2to3, "FM 2>3", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fm2to3, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FM 2>4
+	piParam = new PluginParameter(controlID::fm2to4, "FM 2>4", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fm2to4, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FM 3>1
+	piParam = new PluginParameter(controlID::fm3to1, "FM 3>1", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fm3to1, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FM 3>2
+	piParam = new PluginParameter(controlID::fm3to2, "FM 3>2", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fm3to2, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FM 3>3
+	piParam = new PluginParameter(controlID::fm3to3, "FM 3>3", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fm3to3, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FM 3>4
+	piParam = new PluginParameter(controlID::fm3to4, "FM 3>4", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fm3to4, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FM 4>1
+	piParam = new PluginParameter(controlID::fm4to1, "FM 4>1", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fm4to1, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FM 4>2
+	piParam = new PluginParameter(controlID::fm4to2, "FM 4>2", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fm4to2, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FM 4>3
+	piParam = new PluginParameter(controlID::fm4to3, "FM 4>3", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fm4to3, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FM 4>4
+	piParam = new PluginParameter(controlID::fm4to4, "FM 4>4", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fm4to4, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: Filter Drive
+	piParam = new PluginParameter(controlID::filter1_saturation, "Filter Drive", "", controlVariableType::kDouble, 0.000000, 10.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&filter1_saturation, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- discrete control: Filter Oversampling
+	piParam = new PluginParameter(controlID::filter1_oversampling, "Filter Oversampling", "x1,x2,x4", "x1");
+	piParam->setBoundVariable(&filter1_oversampling, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- continuous control: Noise Seed
+	piParam = new PluginParameter(controlID::noiseSeed, "Noise Seed", "", controlVariableType::kInt, 0.000000, 65535.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&noiseSeed, boundVariableType::kInt);
+	addPluginParameter(piParam);
+
+	// --- discrete control: LFO1 Global
+	piParam = new PluginParameter(controlID::lfo1_global, "LFO1 Global", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
+	piParam->setBoundVariable(&lfo1_global, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- discrete control: LFO2 Global
+	piParam = new PluginParameter(controlID::lfo2_global, "LFO2 Global", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
+	piParam->setBoundVariable(&lfo2_global, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- discrete control: Rotor Global
+	piParam = new PluginParameter(controlID::rotor_global, "Rotor Global", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
+	piParam->setBoundVariable(&rotor_global, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- discrete control: LFO Sine Table
+	piParam = new PluginParameter(controlID::lfo_sineTable, "LFO Sine Table", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
+	piParam->setBoundVariable(&lfo_sineTable, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- discrete control: FX EQ
+	piParam = new PluginParameter(controlID::fx_eq_enable, "FX EQ", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
+	piParam->setBoundVariable(&fx_eq_enable, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FX EQ Mix
+	piParam = new PluginParameter(controlID::fx_eq_mix, "FX EQ Mix", "%", controlVariableType::kDouble, 0.000000, 100.000000, 100.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fx_eq_mix, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- discrete control: FX Comp
+	piParam = new PluginParameter(controlID::fx_comp_enable, "FX Comp", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
+	piParam->setBoundVariable(&fx_comp_enable, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FX Comp Mix
+	piParam = new PluginParameter(controlID::fx_comp_mix, "FX Comp Mix", "%", controlVariableType::kDouble, 0.000000, 100.000000, 100.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fx_comp_mix, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- discrete control: FX Phaser
+	piParam = new PluginParameter(controlID::fx_phaser_enable, "FX Phaser", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
+	piParam->setBoundVariable(&fx_phaser_enable, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FX Phaser Mix
+	piParam = new PluginParameter(controlID::fx_phaser_mix, "FX Phaser Mix", "%", controlVariableType::kDouble, 0.000000, 100.000000, 50.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fx_phaser_mix, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- discrete control: FX Chorus
+	piParam = new PluginParameter(controlID::fx_chorus_enable, "FX Chorus", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
+	piParam->setBoundVariable(&fx_chorus_enable, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FX Chorus Mix
+	piParam = new PluginParameter(controlID::fx_chorus_mix, "FX Chorus Mix", "%", controlVariableType::kDouble, 0.000000, 100.000000, 50.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fx_chorus_mix, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- discrete control: FX Delay
+	piParam = new PluginParameter(controlID::fx_delay_enable, "FX Delay", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
+	piParam->setBoundVariable(&fx_delay_enable, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FX Delay Mix
+	piParam = new PluginParameter(controlID::fx_delay_mix, "FX Delay Mix", "%", controlVariableType::kDouble, 0.000000, 100.000000, 30.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fx_delay_mix, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- discrete control: FX Reverb
+	piParam = new PluginParameter(controlID::fx_reverb_enable, "FX Reverb", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
+	piParam->setBoundVariable(&fx_reverb_enable, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FX Reverb Mix
+	piParam = new PluginParameter(controlID::fx_reverb_mix, "FX Reverb Mix", "%", controlVariableType::kDouble, 0.000000, 100.000000, 30.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fx_reverb_mix, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- discrete control: FX Conv
+	piParam = new PluginParameter(controlID::fx_conv_enable, "FX Conv", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
+	piParam->setBoundVariable(&fx_conv_enable, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
+	// --- continuous control: FX Conv Mix
+	piParam = new PluginParameter(controlID::fx_conv_mix, "FX Conv Mix", "%", controlVariableType::kDouble, 0.000000, 100.000000, 30.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&fx_conv_mix, boundVariableType::kDouble);
+	addPluginParameter(piParam);
+
+	// --- continuous control: Parts
+	piParam = new PluginParameter(controlID::numSynthParts, "Parts", "", controlVariableType::kInt, 1.000000, 16.000000, 1.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&numSynthParts, boundVariableType::kInt);
+	addPluginParameter(piParam);
+
+	// --- continuous control: Edit Part
+	piParam = new PluginParameter(controlID::editSynthPart, "Edit Part", "", controlVariableType::kInt, 1.000000, 16.000000, 1.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&editSynthPart, boundVariableType::kInt);
+	addPluginParameter(piParam);
+
+	// --- continuous control: Voice Threads
+	piParam = new PluginParameter(controlID::voiceThreads, "Voice Threads", "", controlVariableType::kInt, 0.000000, 15.000000, 0.000000, taper::kLinearTaper);
+	piParam->setParameterSmoothing(false);
+	piParam->setSmoothingTimeMsec(100.00);
+	piParam->setBoundVariable(&voiceThreads, boundVariableType::kInt);
+	addPluginParameter(piParam);
+
+	// --- discrete control: Offline Render
+	piParam = new PluginParameter(controlID::offlineRender, "Offline Render", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
+	piParam->setBoundVariable(&offlineRender, boundVariableType::kInt);
+	piParam->setIsDiscreteSwitch(true);
+	addPluginParameter(piParam);
+
 	// --- Aux Attributes
 	AuxParameterAttribute auxAttribute;
 
@@ -918,6 +1257,261 @@ bool PluginCore::initPluginParameters()
 	auxAttribute.setUintAttribute(2147483648);
 	setParamAuxAttribute(controlID::unisonDetune_cents, auxAttribute);
 
+	// --- controlID::osc1_type
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(805306368);
+	setParamAuxAttribute(controlID::osc1_type, auxAttribute);
+
+	// --- controlID::osc1_morph
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::osc1_morph, auxAttribute);
+
+	// --- controlID::osc2_type
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(805306368);
+	setParamAuxAttribute(controlID::osc2_type, auxAttribute);
+
+	// --- controlID::osc2_morph
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::osc2_morph, auxAttribute);
+
+	// --- controlID::osc3_type
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(805306368);
+	setParamAuxAttribute(controlID::osc3_type, auxAttribute);
+
+	// --- controlID::osc3_morph
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::osc3_morph, auxAttribute);
+
+	// --- controlID::osc4_type
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(805306368);
+	setParamAuxAttribute(controlID::osc4_type, auxAttribute);
+
+	// --- controlID::osc4_morph
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::osc4_morph, auxAttribute);
+
+	// --- controlID::unisonVoices
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::unisonVoices, auxAttribute);
+
+	// --- controlID::enablePolyUnison
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(1073741824);
+	setParamAuxAttribute(controlID::enablePolyUnison, auxAttribute);
+
+	// --- controlID::fm1to1
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fm1to1, auxAttribute);
+
+	// --- controlID::fm1to2
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fm1to2, auxAttribute);
+
+	// --- controlID::fm1to3
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fm1to3, auxAttribute);
+
+	// --- controlID::fm1to4
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fm1to4, auxAttribute);
+
+	// --- controlID::fm2to1
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fm2to1, auxAttribute);
+
+	// --- controlID::fm2to2
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fm2to2, auxAttribute);
+
+	// --- controlID::fm2to3
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fm2to3, auxAttribute);
+
+	// --- controlID::fm2to4
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fm2to4, auxAttribute);
+
+	// --- controlID::fm3to1
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fm3to1, auxAttribute);
+
+	// --- controlID::fm3to2
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fm3to2, auxAttribute);
+
+	// --- controlID::fm3to3
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fm3to3, auxAttribute);
+
+	// --- controlID::fm3to4
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fm3to4, auxAttribute);
+
+	// --- controlID::fm4to1
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fm4to1, auxAttribute);
+
+	// --- controlID::fm4to2
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fm4to2, auxAttribute);
+
+	// --- controlID::fm4to3
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fm4to3, auxAttribute);
+
+	// --- controlID::fm4to4
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fm4to4, auxAttribute);
+
+	// --- controlID::filter1_saturation
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::filter1_saturation, auxAttribute);
+
+	// --- controlID::filter1_oversampling
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(805306368);
+	setParamAuxAttribute(controlID::filter1_oversampling, auxAttribute);
+
+	// --- controlID::noiseSeed
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::noiseSeed, auxAttribute);
+
+	// --- controlID::lfo1_global
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(1073741824);
+	setParamAuxAttribute(controlID::lfo1_global, auxAttribute);
+
+	// --- controlID::lfo2_global
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(1073741824);
+	setParamAuxAttribute(controlID::lfo2_global, auxAttribute);
+
+	// --- controlID::rotor_global
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(1073741824);
+	setParamAuxAttribute(controlID::rotor_global, auxAttribute);
+
+	// --- controlID::lfo_sineTable
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(1073741824);
+	setParamAuxAttribute(controlID::lfo_sineTable, auxAttribute);
+
+	// --- controlID::fx_eq_enable
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(1073741824);
+	setParamAuxAttribute(controlID::fx_eq_enable, auxAttribute);
+
+	// --- controlID::fx_eq_mix
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fx_eq_mix, auxAttribute);
+
+	// --- controlID::fx_comp_enable
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(1073741824);
+	setParamAuxAttribute(controlID::fx_comp_enable, auxAttribute);
+
+	// --- controlID::fx_comp_mix
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fx_comp_mix, auxAttribute);
+
+	// --- controlID::fx_phaser_enable
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(1073741824);
+	setParamAuxAttribute(controlID::fx_phaser_enable, auxAttribute);
+
+	// --- controlID::fx_phaser_mix
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fx_phaser_mix, auxAttribute);
+
+	// --- controlID::fx_chorus_enable
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(1073741824);
+	setParamAuxAttribute(controlID::fx_chorus_enable, auxAttribute);
+
+	// --- controlID::fx_chorus_mix
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fx_chorus_mix, auxAttribute);
+
+	// --- controlID::fx_delay_enable
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(1073741824);
+	setParamAuxAttribute(controlID::fx_delay_enable, auxAttribute);
+
+	// --- controlID::fx_delay_mix
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fx_delay_mix, auxAttribute);
+
+	// --- controlID::fx_reverb_enable
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(1073741824);
+	setParamAuxAttribute(controlID::fx_reverb_enable, auxAttribute);
+
+	// --- controlID::fx_reverb_mix
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fx_reverb_mix, auxAttribute);
+
+	// --- controlID::fx_conv_enable
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(1073741824);
+	setParamAuxAttribute(controlID::fx_conv_enable, auxAttribute);
+
+	// --- controlID::fx_conv_mix
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::fx_conv_mix, auxAttribute);
+
+	// --- controlID::numSynthParts
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::numSynthParts, auxAttribute);
+
+	// --- controlID::editSynthPart
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::editSynthPart, auxAttribute);
+
+	// --- controlID::voiceThreads
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(2147483648);
+	setParamAuxAttribute(controlID::voiceThreads, auxAttribute);
+
+	// --- controlID::offlineRender
+	auxAttribute.reset(auxGUIIdentifier::guiControlData);
+	auxAttribute.setUintAttribute(1073741824);
+	setParamAuxAttribute(controlID::offlineRender, auxAttribute);
+
 
 	// **--0xEDA5--**
    
@@ -951,7 +1545,21 @@ bool PluginCore::reset(ResetInfo& resetInfo)
 
     // --- other reset inits
 
+	// --- the part count, voice threads and offline switch start or stop threads, so they only
+	//     change here; like the seed below they are read from the parameters as they are now, the
+	//     bound variables are only synced at the next buffer
+	//
+	//     Offline, the convolution tail is computed on the audio thread so it is never late
+	synthEngine.enableMasterFXConvolutionWorker(getPIParamValueInt(controlID::offlineRender) != 1);
+	setNumSynthParts((uint32_t)getPIParamValueInt(controlID::numSynthParts));
+	setNumVoiceWorkers((uint32_t)getPIParamValueInt(controlID::voiceThreads));
+
+	// --- the seed is applied here, so take the parameter as it is now
+	SynthEngineParameters engineParams = synthEngine.getParameters();
+	engineParams.noiseSeed = (uint64_t)getPIParamValueInt(controlID::noiseSeed);
+	synthEngine.setParameters(engineParams);
 	synthEngine.reset(resetInfo.sampleRate);
+	multiTimbralEngine.reset(resetInfo.sampleRate);
 
     return PluginBase::reset(resetInfo);
 }
@@ -965,10 +1573,72 @@ Operation:
 bool PluginCore::initialize(PluginInfo& pluginInfo)
 {
 	// --- add one-time init stuff here
+	// --- the single engine loads the wavesamples the parts share
+	synthEngine.initialize(pluginInfo);
+	multiTimbralEngine.initialize(pluginInfo);
+
+	// --- master FX convolution IR: <DLL folder>/impulse.wav, if there is one
+	std::string impulsePath = pluginInfo.pathToDLL;
+#if defined _WINDOWS || defined _WINDLL
+	impulsePath += "\\impulse.wav";
+#else
+	impulsePath += "/impulse.wav";
+#endif
+	synthEngine.loadMasterFXImpulseResponse(impulsePath.c_str());
 
 	return true;
 }
 
+/**
+\brief switch between the single engine and multi-part mode; call with the audio stopped
+
+Operation:
+- creates the parts (they share the single engine's wavesamples)
+- sizes the worker pool: the audio thread renders one part, the workers the rest, up to the
+  number of cores
+
+\param numParts number of parts; 0 or 1 goes back to the single engine
+*/
+void PluginCore::setNumSynthParts(uint32_t numParts)
+{
+	if (numParts <= 1)
+	{
+		multiTimbralEngine.setNumWorkers(0);
+		multiTimbralEngine.setNumParts(0, synthEngine.getWaveSampleData());
+		return;
+	}
+
+	multiTimbralEngine.setNumParts(numParts, synthEngine.getWaveSampleData());
+
+	uint32_t numWorkers = multiTimbralEngine.getNumParts() - 1;
+	uint32_t numCores = std::thread::hardware_concurrency();
+	if (numCores > 1 && numWorkers > numCores - 1)
+		numWorkers = numCores - 1;
+	multiTimbralEngine.setNumWorkers(numWorkers);
+
+	// --- the GUI settings go to the edit part at the next buffer
+	editPartDirty = true;
+}
+
+/**
+\brief split the single engine's voices across worker threads, rendering a block at a time; call with
+the audio stopped
+
+Operation:
+- the audio thread renders a share of the voices too, so the workers are capped at one less than
+  the number of cores; they are pinned to their own cores
+
+\param numWorkers number of worker threads; 0 renders every voice on the audio thread (per frame in frame mode)
+*/
+void PluginCore::setNumVoiceWorkers(uint32_t numWorkers)
+{
+	uint32_t numCores = std::thread::hardware_concurrency();
+	if (numCores > 1 && numWorkers > numCores - 1)
+		numWorkers = numCores - 1;
+
+	synthEngine.setNumVoiceWorkers(numWorkers);
+}
+
 /**
 \brief do anything needed prior to arrival of audio buffers
 
@@ -992,6 +1662,10 @@ bool PluginCore::preProcessAudioBuffers(ProcessBufferInfo& processInfo)
 	// we only update parameters ONCE per buffer
 	updateParameters();
 
+	// --- Synth Plugin --- remove for FX plugins
+	if (getPluginType() == kSynthPlugin)
+		beginSynthBuffer(processInfo);
+
     return true;
 }
 
@@ -999,6 +1673,14 @@ void PluginCore::updateParameters()
 {
 	SynthEngineParameters engineParams = synthEngine.getParameters();
 
+	// --- latest joystick position, if it moved
+	VectorJoystickData vectorJoystickData;
+	bool vectorJoystickMoved = false;
+	while (vectorJoystickQueue.try_dequeue(vectorJoystickData))
+		vectorJoystickMoved = true;
+	if (vectorJoystickMoved)
+		engineParams.voiceParameters->vectorJSData = vectorJoystickData;
+
 	// --- collect GUI control update values
 	engineParams.masterPitchBendSensCoarse = (unsigned int)masterPitchBend; // --- this is pitch bend max range in semitones
 	engineParams.masterPitchBendSensFine = (unsigned int)(100.0*(masterPitchBend - engineParams.masterPitchBendSensCoarse)); // this is pitch bend max range in semitones
@@ -1010,16 +1692,33 @@ void PluginCore::updateParameters()
 	// --- Mode
 	engineParams.mode = convertIntToEnum(synthMode,SynthMode);
 	engineParams.masterUnisonDetune_Cents = unisonDetune_cents;
+	engineParams.masterUnisonVoices = (uint32_t)unisonVoices;
+	engineParams.enablePolyUnison = (enablePolyUnison == 1);
+
+	// --- Noise Seed: the voices are re-seeded on reset
+	engineParams.noiseSeed = (uint64_t)noiseSeed;
 
 	// --- Master Volume
 	engineParams.masterVolume_dB = masterVolume_dB;
 
+	// --- Master FX: on/off and wet/dry per effect (masterFXType order); the chain order and the
+	//     effects' own settings are left as they are
+	const int fxEnable[kNumMasterFX] = { fx_eq_enable, fx_comp_enable, fx_phaser_enable, fx_chorus_enable, fx_delay_enable, fx_reverb_enable, fx_conv_enable };
+	const double fxMix[kNumMasterFX] = { fx_eq_mix, fx_comp_mix, fx_phaser_mix, fx_chorus_mix, fx_delay_mix, fx_reverb_mix, fx_conv_mix };
+	for (uint32_t i = 0; i < kNumMasterFX; i++)
+	{
+		engineParams.masterFXParameters.enableFX[i] = (fxEnable[i] == 1);
+		engineParams.masterFXParameters.fxMix[i] = fxMix[i] / 100.0;
+	}
+
 	// --- LFO 1 Parameters
 	engineParams.voiceParameters->lfo1Parameters->frequency_Hz = lfo1Frequency_Hz;
 	engineParams.voiceParameters->lfo1Parameters->waveform = convertIntToEnum(lfo1Waveform, LFOWaveform);
 	engineParams.voiceParameters->lfo1Parameters->mode = convertIntToEnum(lfo1Mode, LFOMode);
 	engineParams.voiceParameters->lfo1Parameters->delay_mSec = lfo1DelayTime_mSec;
 	engineParams.voiceParameters->lfo1Parameters->rampTime_mSec = lfo1RampTime_mSec;
+	engineParams.voiceParameters->lfo1Parameters->globalLFO = (lfo1_global == 1);
+	engineParams.voiceParameters->lfo1Parameters->useSineTable = (lfo_sineTable == 1);
 
 	// --- LFO 2 Parameters
 	engineParams.voiceParameters->lfo2Parameters->frequency_Hz = lfo2Frequency_Hz;
@@ -1028,27 +1727,46 @@ void PluginCore::updateParameters()
 	engineParams.voiceParameters->lfo2Parameters->outputAmplitude = lfo2Amp / 100.0;
 	engineParams.voiceParameters->lfo2Parameters->shape = lfo2_shape;
 	engineParams.voiceParameters->lfo2Parameters->shapey = lfo2_shapeY;
+	engineParams.voiceParameters->lfo2Parameters->globalLFO = (lfo2_global == 1);
+	engineParams.voiceParameters->lfo2Parameters->useSineTable = (lfo_sineTable == 1);
 
 	// --- wavetable oscillator parameters
 	engineParams.voiceParameters->osc1Parameters->oscillatorBankIndex = osc1_BankIndex;
 	engineParams.voiceParameters->osc1Parameters->oscillatorWaveformIndex = osc1_waveForm;
 	engineParams.voiceParameters->osc1Parameters->pitchMode = lfo1_pitchMode;
 	engineParams.voiceParameters->osc1Parameters->detuneCents = osc1_detune;
+	engineParams.voiceParameters->osc1Parameters->oscType = convertIntToEnum(osc1_type, SynthOscType);
+	engineParams.voiceParameters->osc1Parameters->morphModulation = osc1_morph;
 
 	engineParams.voiceParameters->osc2Parameters->oscillatorBankIndex = osc2_BankIndex;
 	engineParams.voiceParameters->osc2Parameters->oscillatorWaveformIndex = osc2_waveForm;
 	engineParams.voiceParameters->osc2Parameters->pitchMode = lfo1_pitchMode;
 	engineParams.voiceParameters->osc2Parameters->detuneCents = osc2_detune;
+	engineParams.voiceParameters->osc2Parameters->oscType = convertIntToEnum(osc2_type, SynthOscType);
+	engineParams.voiceParameters->osc2Parameters->morphModulation = osc2_morph;
 
 	engineParams.voiceParameters->osc3Parameters->oscillatorBankIndex = osc3_BankIndex;
 	engineParams.voiceParameters->osc3Parameters->oscillatorWaveformIndex = osc3_waveForm;
 	engineParams.voiceParameters->osc3Parameters->pitchMode = lfo1_pitchMode;
 	engineParams.voiceParameters->osc3Parameters->detuneCents = osc3_detune;
+	engineParams.voiceParameters->osc3Parameters->oscType = convertIntToEnum(osc3_type, SynthOscType);
+	engineParams.voiceParameters->osc3Parameters->morphModulation = osc3_morph;
 
 	engineParams.voiceParameters->osc4Parameters->oscillatorBankIndex = osc4_BankIndex;
 	engineParams.voiceParameters->osc4Parameters->oscillatorWaveformIndex = osc4_waveForm;
 	engineParams.voiceParameters->osc4Parameters->pitchMode = lfo1_pitchMode;
 	engineParams.voiceParameters->osc4Parameters->detuneCents = osc4_detune;
+	engineParams.voiceParameters->osc4Parameters->oscType = convertIntToEnum(osc4_type, SynthOscType);
+	engineParams.voiceParameters->osc4Parameters->morphModulation = osc4_morph;
+
+	// --- FM matrix: [modulator][carrier], the diagonal is feedback
+	const double fmMatrix[kNumVoiceOscillators][kNumVoiceOscillators] = {
+		{ fm1to1, fm1to2, fm1to3, fm1to4 },
+		{ fm2to1, fm2to2, fm2to3, fm2to4 },
+		{ fm3to1, fm3to2, fm3to3, fm3to4 },
+		{ fm4to1, fm4to2, fm4to3, fm4to4 },
+	};
+	memcpy(engineParams.voiceParameters->oscPhaseModMatrix, fmMatrix, sizeof(fmMatrix));
 
 	// --- Rotor Parameters
 	engineParams.voiceParameters->rotorParameters->mode = rotorMode;
@@ -1056,6 +1774,7 @@ void PluginCore::updateParameters()
 	engineParams.voiceParameters->rotorParameters->freq = rotorFreq;
 	engineParams.voiceParameters->rotorParameters->lfo1Parameters->frequency_Hz = rotorFreq;
 	engineParams.voiceParameters->rotorParameters->lfo2Parameters->frequency_Hz = rotorFreq;
+	engineParams.voiceParameters->rotorParameters->globalRotor = (rotor_global == 1);
 
 	// --- Amp EG Parameters
 	engineParams.voiceParameters->ampEGParameters->delayTime_mSec = eg1DelayTime_mSec;
@@ -1079,6 +1798,10 @@ void PluginCore::updateParameters()
 	engineParams.voiceParameters->moogFilterParameters->enableKeyTrack = (filter1_enableKeyTrack == 1);
 	engineParams.voiceParameters->moogFilterParameters->keyTrackRatio = filter1_keyTrackRatio;
 
+	// --- drive after the filter; the filter section runs at 1x, 2x or 4x
+	engineParams.voiceParameters->filterSaturation = filter1_saturation;
+	engineParams.voiceParameters->oversamplingRatio = 1u << filter1_oversampling;
+
 	// --- setting MM source intensities
 	engineParams.setMM_SourceMasterIntensity(kEG1_Normal, eg1_sourceInt);
 	engineParams.setMM_SourceMasterIntensity(kEG2_Normal, eg2_sourceInt);
@@ -1103,6 +1826,16 @@ void PluginCore::updateParameters()
 	engineParams.setMM_ChannelEnable(kLFO2_Normal, kFilter1_fc, (r4c3 == 1));
 	engineParams.setMM_ChannelEnable(kLFO2_Normal, kShapeX, (r4c4 == 1));
 
+	// --- the X column also scans morphing oscillators (no effect on normal wavetables)
+	for (uint32_t morphDest = kOsc1_Morph; morphDest <= kOsc4_Morph; morphDest++)
+	{
+		engineParams.setMM_ChannelEnable(kEG1_Normal, morphDest, (r1c4 == 1));
+		engineParams.setMM_ChannelEnable(kEG2_Normal, morphDest, (r2c4 == 1));
+		engineParams.setMM_ChannelEnable(kLFO1_Normal, morphDest, (r3c4 == 1));
+		engineParams.setMM_ChannelEnable(kLFO2_Normal, morphDest, (r4c4 == 1));
+		engineParams.setMM_DestMasterIntensity(morphDest, lfo1_X_destInt);
+	}
+
 	// --- setting MM destination intensities
 	engineParams.setMM_DestMasterIntensity(kOsc1_fo, osc1_fo_destInt);
 	engineParams.setMM_DestMasterIntensity(kOsc2_fo, osc2_fo_destInt);
@@ -1113,6 +1846,158 @@ void PluginCore::updateParameters()
    //                  via the setParameters( ) of each  synthEngine.setParameters(engineParams); 
 
 	synthEngine.setParameters(engineParams);
+
+	// --- multi-part: a GUI change (or preset) lands on the part being edited only; it goes to
+	//     the part we are leaving before a new edit part is loaded into the GUI
+	if (isMultiPartMode() && editPartDirty)
+		multiTimbralEngine.setPartParameters(editPart, engineParams);
+	editPartDirty = false;
+
+	if (editSynthPart >= 1 && (uint32_t)editSynthPart - 1 != editPart)
+	{
+		setEditPart((uint32_t)editSynthPart - 1);
+		if (isMultiPartMode())
+			loadEditPartParameters();
+	}
+}
+
+/**
+\brief the inverse of updateParameters( ) for the multi-part edit part: writes the part's settings
+into the plugin parameters so that the bound variables pick them up at the next buffer, and flags
+the GUI for a refresh. Audio thread.
+*/
+void PluginCore::loadEditPartParameters()
+{
+	SynthEngineParameters partParams = multiTimbralEngine.getPartParameters(editPart);
+	std::shared_ptr<SynthVoiceParameters> voiceParams = partParams.voiceParameters;
+
+	// --- the half cent keeps the coarse/fine split in updateParameters( ) exact
+	auto coarseFine = [](int coarse, int fine) {
+		double value = coarse + fine / 100.0;
+		return value + (value < 0.0 ? -0.005 : 0.005); };
+
+	setPIParamValue(controlID::masterPitchBend, coarseFine(partParams.masterPitchBendSensCoarse, partParams.masterPitchBendSensFine));
+	setPIParamValue(controlID::masterTune, coarseFine(partParams.masterTuningCoarse, partParams.masterTuningFine));
+
+	// --- Mode
+	setPIParamValue(controlID::synthMode, (double)partParams.mode);
+	setPIParamValue(controlID::unisonDetune_cents, partParams.masterUnisonDetune_Cents);
+	setPIParamValue(controlID::unisonVoices, partParams.masterUnisonVoices);
+	setPIParamValue(controlID::enablePolyUnison, partParams.enablePolyUnison ? 1.0 : 0.0);
+	setPIParamValue(controlID::noiseSeed, (double)partParams.noiseSeed);
+	setPIParamValue(controlID::masterVolume_dB, partParams.masterVolume_dB);
+
+	// --- Master FX
+	const controlID fxEnable[kNumMasterFX] = { controlID::fx_eq_enable, controlID::fx_comp_enable, controlID::fx_phaser_enable, controlID::fx_chorus_enable, controlID::fx_delay_enable, controlID::fx_reverb_enable, controlID::fx_conv_enable };
+	const controlID fxMix[kNumMasterFX] = { controlID::fx_eq_mix, controlID::fx_comp_mix, controlID::fx_phaser_mix, controlID::fx_chorus_mix, controlID::fx_delay_mix, controlID::fx_reverb_mix, controlID::fx_conv_mix };
+	for (uint32_t i = 0; i < kNumMasterFX; i++)
+	{
+		setPIParamValue(fxEnable[i], partParams.masterFXParameters.enableFX[i] ? 1.0 : 0.0);
+		setPIParamValue(fxMix[i], partParams.masterFXParameters.fxMix[i] * 100.0);
+	}
+
+	// --- LFO 1 Parameters
+	setPIParamValue(controlID::lfo1Frequency_Hz, voiceParams->lfo1Parameters->frequency_Hz);
+	setPIParamValue(controlID::lfo1Waveform, (double)voiceParams->lfo1Parameters->waveform);
+	setPIParamValue(controlID::lfo1Mode, (double)voiceParams->lfo1Parameters->mode);
+	setPIParamValue(controlID::lfo1DelayTime_mSec, voiceParams->lfo1Parameters->delay_mSec);
+	setPIParamValue(controlID::lfo1RampTime_mSec, voiceParams->lfo1Parameters->rampTime_mSec);
+	setPIParamValue(controlID::lfo1_global, voiceParams->lfo1Parameters->globalLFO ? 1.0 : 0.0);
+	setPIParamValue(controlID::lfo_sineTable, voiceParams->lfo1Parameters->useSineTable ? 1.0 : 0.0);
+
+	// --- LFO 2 Parameters
+	setPIParamValue(controlID::lfo2Frequency_Hz, voiceParams->lfo2Parameters->frequency_Hz);
+	setPIParamValue(controlID::lfo2Waveform, (double)voiceParams->lfo2Parameters->waveform);
+	setPIParamValue(controlID::lfo2Mode, (double)voiceParams->lfo2Parameters->mode);
+	setPIParamValue(controlID::lfo2Amp, voiceParams->lfo2Parameters->outputAmplitude * 100.0);
+	setPIParamValue(controlID::lfo2_shape, voiceParams->lfo2Parameters->shape);
+	setPIParamValue(controlID::lfo2_shapeY, voiceParams->lfo2Parameters->shapey);
+	setPIParamValue(controlID::lfo2_global, voiceParams->lfo2Parameters->globalLFO ? 1.0 : 0.0);
+
+	// --- wavetable oscillator parameters; the pitch mode is shared
+	std::shared_ptr<SynthOscParameters> oscParams[kNumVoiceOscillators] = { voiceParams->osc1Parameters, voiceParams->osc2Parameters, voiceParams->osc3Parameters, voiceParams->osc4Parameters };
+	const controlID oscControls[kNumVoiceOscillators][5] = {
+		{ controlID::osc1_BankIndex, controlID::osc1_waveForm, controlID::osc1_detune, controlID::osc1_type, controlID::osc1_morph },
+		{ controlID::osc2_BankIndex, controlID::osc2_waveForm, controlID::osc2_detune, controlID::osc2_type, controlID::osc2_morph },
+		{ controlID::osc3_BankIndex, controlID::osc3_waveForm, controlID::osc3_detune, controlID::osc3_type, controlID::osc3_morph },
+		{ controlID::osc4_BankIndex, controlID::osc4_waveForm, controlID::osc4_detune, controlID::osc4_type, controlID::osc4_morph },
+	};
+	for (uint32_t i = 0; i < kNumVoiceOscillators; i++)
+	{
+		setPIParamValue(oscControls[i][0], oscParams[i]->oscillatorBankIndex);
+		setPIParamValue(oscControls[i][1], oscParams[i]->oscillatorWaveformIndex);
+		setPIParamValue(oscControls[i][2], oscParams[i]->detuneCents);
+		setPIParamValue(oscControls[i][3], (double)oscParams[i]->oscType);
+		setPIParamValue(oscControls[i][4], oscParams[i]->morphModulation);
+	}
+	setPIParamValue(controlID::lfo1_pitchMode, voiceParams->osc1Parameters->pitchMode);
+
+	// --- FM matrix: [modulator][carrier]
+	for (uint32_t modulator = 0; modulator < kNumVoiceOscillators; modulator++)
+	{
+		for (uint32_t carrier = 0; carrier < kNumVoiceOscillators; carrier++)
+			setPIParamValue(controlID::fm1to1 + kNumVoiceOscillators * modulator + carrier, voiceParams->oscPhaseModMatrix[modulator][carrier]);
+	}
+
+	// --- Rotor Parameters
+	setPIParamValue(controlID::rotorMode, voiceParams->rotorParameters->mode);
+	setPIParamValue(controlID::rotorShape, voiceParams->rotorParameters->shape);
+	setPIParamValue(controlID::rotorFreq, voiceParams->rotorParameters->freq);
+	setPIParamValue(controlID::rotor_global, voiceParams->rotorParameters->globalRotor ? 1.0 : 0.0);
+
+	// --- Amp EG Parameters
+	setPIParamValue(controlID::eg1DelayTime_mSec, voiceParams->ampEGParameters->delayTime_mSec);
+	setPIParamValue(controlID::eg1AttackTime_mSec, voiceParams->ampEGParameters->attackTime_mSec);
+	setPIParamValue(controlID::eg1HoldTime_mSec, voiceParams->ampEGParameters->holdTime_mSec);
+	setPIParamValue(controlID::eg1DecayTime_mSec, voiceParams->ampEGParameters->decayTime_mSec);
+	setPIParamValue(controlID::eg1SustainLevel, voiceParams->ampEGParameters->sustainLevel);
+	setPIParamValue(controlID::eg1ReleaseTime_mSec, voiceParams->ampEGParameters->releaseTime_mSec);
+	setPIParamValue(controlID::eg1Mode, (double)voiceParams->ampEGParameters->egContourType);
+	setPIParamValue(controlID::eg1_attackFromZero, voiceParams->ampEGParameters->resetToZero ? 1.0 : 0.0);
+
+	// --- EG2 Parameters
+	setPIParamValue(controlID::eg2AttackTime_mSec, voiceParams->EG2Parameters->attackTime_mSec);
+	setPIParamValue(controlID::eg2DecayTime_mSec, voiceParams->EG2Parameters->decayTime_mSec);
+	setPIParamValue(controlID::eg2SustainLevel, voiceParams->EG2Parameters->sustainLevel);
+	setPIParamValue(controlID::eg2ReleaseTime_mSec, voiceParams->EG2Parameters->releaseTime_mSec);
+
+	// --- Filter Parameters
+	setPIParamValue(controlID::filter1_fc, voiceParams->moogFilterParameters->fc);
+	setPIParamValue(controlID::filter1_q, voiceParams->moogFilterParameters->Q);
+	setPIParamValue(controlID::filter1_enableKeyTrack, voiceParams->moogFilterParameters->enableKeyTrack ? 1.0 : 0.0);
+	setPIParamValue(controlID::filter1_keyTrackRatio, voiceParams->moogFilterParameters->keyTrackRatio);
+	setPIParamValue(controlID::filter1_saturation, voiceParams->filterSaturation);
+	setPIParamValue(controlID::filter1_oversampling, voiceParams->oversamplingRatio >= 4 ? 2.0 : (voiceParams->oversamplingRatio >= 2 ? 1.0 : 0.0));
+
+	// --- MM source intensities
+	setPIParamValue(controlID::eg1_sourceInt, partParams.modSourceData->at(kEG1_Normal).masterIntensity);
+	setPIParamValue(controlID::eg2_sourceInt, partParams.modSourceData->at(kEG2_Normal).masterIntensity);
+	setPIParamValue(controlID::lfo1_sourceInt, partParams.modSourceData->at(kLFO1_Normal).masterIntensity);
+	setPIParamValue(controlID::lfo2_sourceInt, partParams.modSourceData->at(kLFO2_Normal).masterIntensity);
+
+	// --- MM switches: rows are the sources, columns the destinations
+	const uint32_t mmSources[4] = { kEG1_Normal, kEG2_Normal, kLFO1_Normal, kLFO2_Normal };
+	const uint32_t mmDestinations[4] = { kOsc1_fo, kOsc2_fo, kFilter1_fc, kShapeX };
+	const controlID mmSwitches[4][4] = {
+		{ controlID::r1c1, controlID::r1c2, controlID::r1c3, controlID::r1c4 },
+		{ controlID::r2c1, controlID::r2c2, controlID::r2c3, controlID::r2c4 },
+		{ controlID::r3c1, controlID::r3c2, controlID::r3c3, controlID::r3c4 },
+		{ controlID::r4c1, controlID::r4c2, controlID::r4c3, controlID::r4c4 },
+	};
+	for (uint32_t row = 0; row < 4; row++)
+	{
+		for (uint32_t column = 0; column < 4; column++)
+			setPIParamValue(mmSwitches[row][column], partParams.modDestinationData->at(mmDestinations[column]).channelEnable[mmSources[row]] ? 1.0 : 0.0);
+	}
+
+	// --- MM destination intensities
+	setPIParamValue(controlID::osc1_fo_destInt, partParams.modDestinationData->at(kOsc1_fo).masterIntensity);
+	setPIParamValue(controlID::osc2_fo_destInt, partParams.modDestinationData->at(kOsc2_fo).masterIntensity);
+	setPIParamValue(controlID::filt1_fo_destInt, partParams.modDestinationData->at(kFilter1_fc).masterIntensity);
+	setPIParamValue(controlID::lfo1_X_destInt, partParams.modDestinationData->at(kShapeX).masterIntensity);
+
+	// --- refreshed from the GUI thread
+	editPartGUIUpdate = true;
 }
 
 /**
@@ -1130,8 +2015,15 @@ Operation:
 bool PluginCore::processAudioFrame(ProcessFrameInfo& processFrameInfo)
 {
     // --- fire any MIDI events for this sample interval
-    processFrameInfo.midiEventQueue->fireMidiEvents(processFrameInfo.currentFrame);
-	if (eg1_retrigger) processMIDIEvent(lastEvent);
+    fireFrameMidiEvents(processFrameInfo.midiEventQueue, processFrameInfo.currentFrame);
+	if (eg1_retrigger && !isMultiPartMode())
+	{
+		// --- block mode: queued at this frame like the frame's own events
+		if (isBlockRenderMode())
+			synthEngine.queueMIDIEvent(lastEvent, processFrameInfo.currentFrame);
+		else
+			processMIDIEvent(lastEvent);
+	}
 
 	// --- do per-frame updates; VST automation and parameter smoothing
 	doSampleAccurateParameterUpdates();
@@ -1144,6 +2036,15 @@ bool PluginCore::processAudioFrame(ProcessFrameInfo& processFrameInfo)
 	// --- Synth Plugin --- remove for FX plugins
 	if (getPluginType() == kSynthPlugin)
 	{
+		// --- multi-part and block mode render the whole buffer in renderSynthBuffer( )
+		if (isMultiPartMode() || isBlockRenderMode())
+		{
+			processFrameInfo.audioOutputFrame[0] = 0.f;
+			if (processFrameInfo.channelIOConfig.outputChannelFormat == kCFStereo)
+				processFrameInfo.audioOutputFrame[1] = 0.f;
+			return true;
+		}
+
 		// --- do the synth render  
 		const SynthRenderData render = synthEngine.renderAudioOutput(); 
 
@@ -1193,10 +2094,93 @@ bool PluginCore::processAudioFrame(ProcessFrameInfo& processFrameInfo)
 }
 
 
+/**
+\brief buffer-processing method, used instead of processAudioFrame( ) when pluginDescriptor.processFrames is false
+
+Operation:
+- fires the buffer's MIDI events; the engines queue them at their frames (with EG1 retrigger the last
+  event is queued again at every frame, as processAudioFrame( ) does)
+- does the per-frame parameter smoothing and VST3 sample accurate updates for the buffer
+- renders the synth straight into the output buffers; channels past stereo and the aux outputs are silent,
+  as they are with frames
+
+\param processInfo structure of information about *buffer* processing
+
+\return true if operation succeeds, false otherwise
+*/
+bool PluginCore::processAudioBlock(ProcessBufferInfo& processInfo)
+{
+	if (eg1_retrigger && isBlockRenderMode())
+	{
+		for (uint32_t frame = 0; frame < processInfo.numFramesToProcess; frame++)
+		{
+			fireFrameMidiEvents(processInfo.midiEventQueue, frame);
+			synthEngine.queueMIDIEvent(lastEvent, frame);
+		}
+	}
+	else
+		fireBufferMidiEvents(processInfo);
+	doBufferParameterUpdates(processInfo.numFramesToProcess);
+
+	// --- Synth Plugin --- remove for FX plugins
+	if (getPluginType() == kSynthPlugin)
+	{
+		renderSynthBuffer(processInfo);
+
+		for (uint32_t i = 2; i < processInfo.numAudioOutChannels; i++)
+			memset(processInfo.outputs[i], 0, processInfo.numFramesToProcess * sizeof(float));
+		for (uint32_t i = 0; i < processInfo.numAuxAudioOutChannels; i++)
+			memset(processInfo.auxOutputs[i], 0, processInfo.numFramesToProcess * sizeof(float));
+
+		return true; /// processed
+	}
+
+	return false; /// NOT processed
+}
+
+/**
+\brief open the output buffer for block rendering before the buffer's MIDI events arrive, so an
+engine whose event queue fills can render up to the event instead of dropping it
+
+\param processInfo structure of information about *buffer* processing
+*/
+void PluginCore::beginSynthBuffer(ProcessBufferInfo& processInfo)
+{
+	float* left = nullptr;
+	float* right = nullptr;
+	if (processInfo.outputs && processInfo.numAudioOutChannels > 0)
+	{
+		left = processInfo.outputs[0];
+		right = processInfo.numAudioOutChannels > 1 ? processInfo.outputs[1] : nullptr;
+	}
+
+	if (isMultiPartMode())
+		multiTimbralEngine.beginAudioBlock(left, right, processInfo.numFramesToProcess);
+	else if (isBlockRenderMode())
+		synthEngine.beginAudioBlock(left, right, processInfo.numFramesToProcess);
+}
+
+/**
+\brief render the synth over the rest of the buffer: the parts in multi-part mode, else the single
+engine in block mode; either way from the MIDI events queued for the buffer
+
+\param processInfo structure of information about *buffer* processing
+*/
+void PluginCore::renderSynthBuffer(ProcessBufferInfo& processInfo)
+{
+	// --- the output buffer was opened in beginSynthBuffer( )
+	if (isMultiPartMode())
+		multiTimbralEngine.renderAudioBlock();
+	else if (isBlockRenderMode())
+		synthEngine.renderAudioBlock();
+}
+
 /**
 \brief do anything needed prior to arrival of audio buffers
 
 Operation:
+- frame mode: multi-part and block mode render the buffer here, after the frames
+- runs the synth engine's master FX chain over the rendered buffer
 - updateOutBoundVariables sends metering data to the GUI meters
 
 \param processInfo structure of information about *buffer* processing
@@ -1205,6 +2189,17 @@ Operation:
 */
 bool PluginCore::postProcessAudioBuffers(ProcessBufferInfo& processInfo)
 {
+	// --- Synth Plugin: post-voice FX work on the whole summed buffer
+	if (getPluginType() == kSynthPlugin)
+	{
+		if (pluginDescriptor.processFrames)
+			renderSynthBuffer(processInfo);
+
+		// --- the parts run their own master FX
+		if (!isMultiPartMode())
+			synthEngine.processMasterFX(processInfo.outputs, processInfo.numAudioOutChannels, processInfo.numFramesToProcess);
+	}
+
 	// --- update outbound variables; currently this is meter data only, but could be extended
 	//     in the future
 	updateOutBoundVariables();
@@ -1275,6 +2270,15 @@ bool PluginCore::updatePluginParameterNormalized(int32_t controlID, double norma
 */
 bool PluginCore::postUpdatePluginParameter(int32_t controlID, double controlValue, ParameterUpdateInfo& paramInfo)
 {
+	// --- multi-part: part settings go to the edit part at the next updateParameters( ); the
+	//     part count, the edit part itself, the voice threads and the offline switch are not
+	//     part settings
+	if (controlID != ::controlID::numSynthParts &&
+		controlID != ::controlID::editSynthPart &&
+		controlID != ::controlID::voiceThreads &&
+		controlID != ::controlID::offlineRender)
+		editPartDirty = true;
+
     // --- now do any post update cooking; be careful with VST Sample Accurate automation
     //     If enabled, then make sure the cooking functions are short and efficient otherwise disable it
     //     for the Parameter involved
@@ -1360,6 +2364,22 @@ bool PluginCore::processMessage(MessageInfo& messageInfo)
 	// --- update view; this will only be called if the GUI is actually open
 	case PLUGINGUI_TIMERPING:
 	{
+		// --- a new edit part was loaded into the parameters; show it
+		if (editPartGUIUpdate.exchange(false) && pluginHostConnector)
+		{
+			HostMessageInfo hostMessageInfo;
+			hostMessageInfo.hostMessage = sendGUIUpdate;
+
+			for (uint32_t i = 0; i < numPluginParameters; i++)
+			{
+				GUIParameter guiParameter;
+				guiParameter.controlID = pluginParameterArray[i]->getControlID();
+				guiParameter.actualValue = pluginParameterArray[i]->getControlValue();
+				hostMessageInfo.guiUpdateData.guiParameters.push_back(guiParameter);
+			}
+
+			pluginHostConnector->sendHostMessage(hostMessageInfo);
+		}
 		return false;
 	}
 
@@ -1440,6 +2460,21 @@ NOTES:
 */
 bool PluginCore::processMIDIEvent(midiEvent& event)
 {
+	// --- multi-part: queued for the channel's part, rendered with the whole buffer
+	if (isMultiPartMode())
+	{
+		multiTimbralEngine.processMIDIEvent(event, getMidiEventFrame());
+		return true;
+	}
+
+	// --- block mode: queued, rendered with the whole buffer
+	if (isBlockRenderMode())
+	{
+		synthEngine.queueMIDIEvent(event, getMidiEventFrame());
+		lastEvent = event;
+		return true;
+	}
+
 	synthEngine.processMIDIEvent(event);
 	lastEvent = event;
 	return true;
@@ -1458,10 +2493,9 @@ NOTES:
 */
 bool PluginCore::setVectorJoystickParameters(const VectorJoystickData& vectorJoysickData)
 {
-	// asynchronous
-	SynthEngineParameters engineParams = synthEngine.getParameters();
-	engineParams.voiceParameters->vectorJSData = vectorJoysickData;
-	synthEngine.setParameters(engineParams);
+	// asynchronous: this is the GUI thread, so the engine (and its master FX objects) is only
+	//               touched from updateParameters( ) on the audio thread
+	vectorJoystickQueue.enqueue(vectorJoysickData);
 	return true;
 }
 
@@ -1559,6 +2593,57 @@ bool PluginCore::initPluginPresets()
 	setPresetParameter(preset->presetParameters, controlID::osc4_detune, 0.000000);
 	setPresetParameter(preset->presetParameters, controlID::synthMode, -0.000000);
 	setPresetParameter(preset->presetParameters, controlID::unisonDetune_cents, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::osc1_type, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::osc1_morph, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::osc2_type, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::osc2_morph, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::osc3_type, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::osc3_morph, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::osc4_type, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::osc4_morph, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::unisonVoices, 4.000000);
+	setPresetParameter(preset->presetParameters, controlID::enablePolyUnison, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fm1to1, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fm1to2, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fm1to3, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fm1to4, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fm2to1, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fm2to2, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fm2to3, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fm2to4, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fm3to1, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fm3to2, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fm3to3, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fm3to4, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fm4to1, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fm4to2, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fm4to3, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fm4to4, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::filter1_saturation, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::filter1_oversampling, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::noiseSeed, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::lfo1_global, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::lfo2_global, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::rotor_global, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::lfo_sineTable, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fx_eq_enable, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fx_eq_mix, 100.000000);
+	setPresetParameter(preset->presetParameters, controlID::fx_comp_enable, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fx_comp_mix, 100.000000);
+	setPresetParameter(preset->presetParameters, controlID::fx_phaser_enable, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fx_phaser_mix, 50.000000);
+	setPresetParameter(preset->presetParameters, controlID::fx_chorus_enable, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fx_chorus_mix, 50.000000);
+	setPresetParameter(preset->presetParameters, controlID::fx_delay_enable, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fx_delay_mix, 30.000000);
+	setPresetParameter(preset->presetParameters, controlID::fx_reverb_enable, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fx_reverb_mix, 30.000000);
+	setPresetParameter(preset->presetParameters, controlID::fx_conv_enable, -0.000000);
+	setPresetParameter(preset->presetParameters, controlID::fx_conv_mix, 30.000000);
+	setPresetParameter(preset->presetParameters, controlID::numSynthParts, 1.000000);
+	setPresetParameter(preset->presetParameters, controlID::editSynthPart, 1.000000);
+	setPresetParameter(preset->presetParameters, controlID::voiceThreads, 0.000000);
+	setPresetParameter(preset->presetParameters, controlID::offlineRender, -0.000000);
 	addPreset(preset);
 
 
@@ -1581,6 +2666,7 @@ bool PluginCore::initPluginDescriptors()
 
 	// --- describe the plugin attributes; set according to your needs
 	pluginDescriptor.hasSidechain = kWantSidechain;
+	pluginDescriptor.processFrames = kProcessFrames;
 	pluginDescriptor.latencyInSamples = kLatencyInSamples;
 	pluginDescriptor.tailTimeInMSec = kTailTimeMsec;
 	pluginDescriptor.infiniteTailVST3 = kVSTInfiniteTail;
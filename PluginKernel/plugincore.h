@@ -37,6 +37,7 @@ Korg Wavesequencing:
 
 #include "pluginbase.h"
 #include "synthcore.h"
+#include "multitimbral.h"
 
 // **--0x7F1F--**
 
@@ -115,7 +116,58 @@ enum controlID {
 	osc3_detune = 26,
 	osc4_detune = 36,
 	synthMode = 0,
-	unisonDetune_cents = 1
+	unisonDetune_cents = 1,
+	osc1_type = 5,
+	osc1_morph = 4,
+	osc2_type = 15,
+	osc2_morph = 14,
+	osc3_type = 25,
+	osc3_morph = 24,
+	osc4_type = 35,
+	osc4_morph = 34,
+	unisonVoices = 2,
+	enablePolyUnison = 3,
+	fm1to1 = 140,
+	fm1to2 = 141,
+	fm1to3 = 142,
+	fm1to4 = 143,
+	fm2to1 = 144,
+	fm2to2 = 145,
+	fm2to3 = 146,
+	fm2to4 = 147,
+	fm3to1 = 148,
+	fm3to2 = 149,
+	fm3to3 = 150,
+	fm3to4 = 151,
+	fm4to1 = 152,
+	fm4to2 = 153,
+	fm4to3 = 154,
+	fm4to4 = 155,
+	filter1_saturation = 12,
+	filter1_oversampling = 13,
+	noiseSeed = 130,
+	lfo1_global = 46,
+	lfo2_global = 56,
+	rotor_global = 131,
+	lfo_sineTable = 47,
+	fx_eq_enable = 160,
+	fx_eq_mix = 161,
+	fx_comp_enable = 162,
+	fx_comp_mix = 163,
+	fx_phaser_enable = 164,
+	fx_phaser_mix = 165,
+	fx_chorus_enable = 166,
+	fx_chorus_mix = 167,
+	fx_delay_enable = 168,
+	fx_delay_mix = 169,
+	fx_reverb_enable = 170,
+	fx_reverb_mix = 171,
+	fx_conv_enable = 172,
+	fx_conv_mix = 173,
+	numSynthParts = 132,
+	editSynthPart = 133,
+	voiceThreads = 134,
+	offlineRender = 135
 };
 
 	// **--0x0F1F--**
@@ -169,6 +221,9 @@ public:
 	//     help on breaking up buffers and getting info from processBufferInfo
 	//virtual bool processAudioBuffers(ProcessBufferInfo& processBufferInfo);
 
+	/** process whole buffers of data (pluginDescriptor.processFrames = false) */
+	virtual bool processAudioBlock(ProcessBufferInfo& processInfo);
+
 	/** preProcess: do any post-buffer processing required; default operation is to send metering data to GUI  */
 	virtual bool postProcessAudioBuffers(ProcessBufferInfo& processInfo);
 
@@ -202,11 +257,39 @@ public:
 
 	void updateParameters();
 
+	// --- multi-part mode: MIDI channel N plays part N, rendered in parallel; the GUI edits
+	//     editPart. Non-realtime, with the audio stopped; 0 or 1 parts is the single engine
+	MultiTimbralEngine multiTimbralEngine;
+	void setNumSynthParts(uint32_t numParts);
+	void setEditPart(uint32_t part) { editPart = part; }
+	void loadEditPartParameters();
+	bool isMultiPartMode() { return multiTimbralEngine.getNumParts() > 1; }
+
+	// --- single engine rendered a block at a time: always in buffer mode, and in frame mode when
+	//     its voices are rendered on worker threads (non-realtime, with the audio stopped; 0 renders
+	//     per frame)
+	void setNumVoiceWorkers(uint32_t numWorkers);
+	bool isBlockRenderMode() { return !isMultiPartMode() && (!pluginDescriptor.processFrames || synthEngine.getNumVoiceWorkers() > 0); }
+
+	// --- multi-part and block mode: the buffer is opened before its MIDI events arrive (a full
+	//     event queue renders part of it early) and rendered here, from the queued MIDI events
+	void beginSynthBuffer(ProcessBufferInfo& processInfo);
+	void renderSynthBuffer(ProcessBufferInfo& processInfo);
+
 	midiEvent lastEvent;
 	
 	// --- for custom GUI
 	ICustomView* bankAndWaveGroup_0 = nullptr;
 
+	// --- GUI changes go to this part; switching parts loads the new part's settings into the
+	//     plugin parameters, and the GUI is refreshed from them on its next timer ping
+	uint32_t editPart = 0;
+	bool editPartDirty = false;
+	std::atomic<bool> editPartGUIUpdate{ false };
+
+	// --- joystick moves from the GUI thread; applied with the other parameters once per buffer
+	moodycamel::ReaderWriterQueue<VectorJoystickData> vectorJoystickQueue;
+
 	// --- END USER VARIABLES AND FUNCTIONS -------------------------------------- //
 
 private:
@@ -251,6 +334,39 @@ private:
 	double osc3_detune = 0.0;
 	double osc4_detune = 0.0;
 	double unisonDetune_cents = 0.0;
+	double osc1_morph = 0.0;
+	double osc2_morph = 0.0;
+	double osc3_morph = 0.0;
+	double osc4_morph = 0.0;
+	int unisonVoices = 0;
+	double fm1to1 = 0.0;
+	double fm1to2 = 0.0;
+	double fm1to3 = 0.0;
+	double fm1to4 = 0.0;
+	double fm2to1 = 0.0;
+	double fm2to2 = 0.0;
+	double fm2to3 = 0.0;
+	double fm2to4 = 0.0;
+	double fm3to1 = 0.0;
+	double fm3to2 = 0.0;
+	double fm3to3 = 0.0;
+	double fm3to4 = 0.0;
+	double fm4to1 = 0.0;
+	double fm4to2 = 0.0;
+	double fm4to3 = 0.0;
+	double fm4to4 = 0.0;
+	double filter1_saturation = 0.0;
+	int noiseSeed = 0;
+	double fx_eq_mix = 0.0;
+	double fx_comp_mix = 0.0;
+	double fx_phaser_mix = 0.0;
+	double fx_chorus_mix = 0.0;
+	double fx_delay_mix = 0.0;
+	double fx_reverb_mix = 0.0;
+	double fx_conv_mix = 0.0;
+	int numSynthParts = 0;
+	int editSynthPart = 0;
+	int voiceThreads = 0;
 
 	// --- Discrete Plugin Variables 
 	int lfo1Waveform = 0;
@@ -358,6 +474,60 @@ private:
 	int synthMode = 0;
 	enum class synthModeEnum { Poly,Mono,Unison };	// to compare: if(compareEnumToInt(synthModeEnum::Poly, synthMode)) etc... 
 
+	int osc1_type = 0;
+	enum class osc1_typeEnum { Wavetable,Morphing,Sample };	// to compare: if(compareEnumToInt(osc1_typeEnum::Wavetable, osc1_type)) etc... 
+
+	int osc2_type = 0;
+	enum class osc2_typeEnum { Wavetable,Morphing,Sample };	// to compare: if(compareEnumToInt(osc2_typeEnum::Wavetable, osc2_type)) etc... 
+
+	int osc3_type = 0;
+	enum class osc3_typeEnum { Wavetable,Morphing,Sample };	// to compare: if(compareEnumToInt(osc3_typeEnum::Wavetable, osc3_type)) etc... 
+
+	int osc4_type = 0;
+	enum class osc4_typeEnum { Wavetable,Morphing,Sample };	// to compare: if(compareEnumToInt(osc4_typeEnum::Wavetable, osc4_type)) etc... 
+
+	int enablePolyUnison = 0;
+	enum class enablePolyUnisonEnum { SWITCH_OFF,SWITCH_ON };	// to compare: if(compareEnumToInt(enablePolyUnisonEnum::SWITCH_OFF, enablePolyUnison)) etc... 
+
+	int filter1_oversampling = 0;
+	enum class filter1_oversamplingEnum { x1,x2,x4 };	// to compare: if(compareEnumToInt(filter1_oversamplingEnum::x1, filter1_oversampling)) etc... 
+
+	int lfo1_global = 0;
+	enum class lfo1_globalEnum { SWITCH_OFF,SWITCH_ON };	// to compare: if(compareEnumToInt(lfo1_globalEnum::SWITCH_OFF, lfo1_global)) etc... 
+
+	int lfo2_global = 0;
+	enum class lfo2_globalEnum { SWITCH_OFF,SWITCH_ON };	// to compare: if(compareEnumToInt(lfo2_globalEnum::SWITCH_OFF, lfo2_global)) etc... 
+
+	int rotor_global = 0;
+	enum class rotor_globalEnum { SWITCH_OFF,SWITCH_ON };	// to compare: if(compareEnumToInt(rotor_globalEnum::SWITCH_OFF, rotor_global)) etc... 
+
+	int lfo_sineTable = 0;
+	enum class lfo_sineTableEnum { SWITCH_OFF,SWITCH_ON };	// to compare: if(compareEnumToInt(lfo_sineTableEnum::SWITCH_OFF, lfo_sineTable)) etc... 
+
+	int fx_eq_enable = 0;
+	enum class fx_eq_enableEnum { SWITCH_OFF,SWITCH_ON };	// to compare: if(compareEnumToInt(fx_eq_enableEnum::SWITCH_OFF, fx_eq_enable)) etc... 
+
+	int fx_comp_enable = 0;
+	enum class fx_comp_enableEnum { SWITCH_OFF,SWITCH_ON };	// to compare: if(compareEnumToInt(fx_comp_enableEnum::SWITCH_OFF, fx_comp_enable)) etc... 
+
+	int fx_phaser_enable = 0;
+	enum class fx_phaser_enableEnum { SWITCH_OFF,SWITCH_ON };	// to compare: if(compareEnumToInt(fx_phaser_enableEnum::SWITCH_OFF, fx_phaser_enable)) etc... 
+
+	int fx_chorus_enable = 0;
+	enum class fx_chorus_enableEnum { SWITCH_OFF,SWITCH_ON };	// to compare: if(compareEnumToInt(fx_chorus_enableEnum::SWITCH_OFF, fx_chorus_enable)) etc... 
+
+	int fx_delay_enable = 0;
+	enum class fx_delay_enableEnum { SWITCH_OFF,SWITCH_ON };	// to compare: if(compareEnumToInt(fx_delay_enableEnum::SWITCH_OFF, fx_delay_enable)) etc... 
+
+	int fx_reverb_enable = 0;
+	enum class fx_reverb_enableEnum { SWITCH_OFF,SWITCH_ON };	// to compare: if(compareEnumToInt(fx_reverb_enableEnum::SWITCH_OFF, fx_reverb_enable)) etc... 
+
+	int fx_conv_enable = 0;
+	enum class fx_conv_enableEnum { SWITCH_OFF,SWITCH_ON };	// to compare: if(compareEnumToInt(fx_conv_enableEnum::SWITCH_OFF, fx_conv_enable)) etc... 
+
+	int offlineRender = 0;
+	enum class offlineRenderEnum { SWITCH_OFF,SWITCH_ON };	// to compare: if(compareEnumToInt(offlineRenderEnum::SWITCH_OFF, offlineRender)) etc... 
+
 	// **--0x1A7F--**
     // --- end member variables
 
@@ -62,6 +62,7 @@ const int32_t kAAXProductID = 'abcd';
 
 // --- Plugin Options
 const bool kWantSidechain = false;
+const bool kProcessFrames = false;	// --- false: PluginCore::processAudioBlock( ) gets whole buffers
 const uint32_t kLatencyInSamples = 0;
 const double kTailTimeMsec = 0.000;
 const bool kVSTInfiniteTail = false;
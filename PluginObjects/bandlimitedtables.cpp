@@ -0,0 +1,419 @@
+// --- Synth Core v1.0
+//
+#include "bandlimitedtables.h"
+#include "sharedtablestore.h"
+#include "synthworkerpool.h"
+#include "radix2fft.h"
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <cstdio>
+#include <algorithm>
+
+#if defined _WINDOWS || defined _WINDLL
+#include <windows.h>
+const std::string kBLTablePathSeparator = "\\";
+#else
+const std::string kBLTablePathSeparator = "/";
+#endif
+
+// --- cache file header
+const char kBLTableCacheMagic[4] = { 'B', 'L', 'T', '1' };
+
+std::vector<BandLimitedTableGenerator::TableSeed> BandLimitedTableGenerator::calculateTableSeeds(uint32_t tableInterval)
+{
+	std::vector<TableSeed> seeds;
+	TableSeed seed;
+	uint32_t intervalSemitones = 1;
+
+	if (tableInterval == wtTableInterval::highRes)
+	{
+		seed.frequency = pow(2.0, (-69.0 / 12.0)) * 440.0; // MIDI note 0 = 8.175.....
+		seed.midiNote = 0;
+		intervalSemitones = 1;
+	}
+	else if (tableInterval == wtTableInterval::octave)
+	{
+		seed.frequency = 27.5; // --- Note A0, bottom of piano = 27.5Hz
+		seed.midiNote = 21;
+		intervalSemitones = 12;
+	}
+	else if (tableInterval == wtTableInterval::min3rd)
+	{
+		seed.frequency = 27.5; // --- Note A0, bottom of piano = 27.5Hz
+		seed.midiNote = 21;
+		intervalSemitones = 3;
+	}
+	else
+		return seeds;
+
+	while (seed.midiNote < MAX_WAVE_TABLES)
+	{
+		seeds.push_back(seed);
+		seed.frequency *= pow(2.0, (intervalSemitones / 12.0));
+		seed.midiNote += intervalSemitones;
+	}
+
+	return seeds;
+}
+
+void BandLimitedTableGenerator::fillSpectrum(const BandLimitedTableSpec& spec, double seedFrequency, std::vector<double>& real, std::vector<double>& imag)
+{
+	uint32_t tableLength = spec.tableLength;
+	real.assign(tableLength, 0.0);
+	imag.assign(tableLength, 0.0);
+
+	// --- same harmonic limits as the additive version; harmonics above the table's own
+	//     Nyquist fold back exactly as they do when summed sample by sample
+	int numHarmonics = (int)((spec.sampleRate / 2.0 / seedFrequency) - 1.0);
+	int halfNumHarmonics = (int)((double)numHarmonics / 2.0);
+
+	if (spec.waveform == wtWaveFormIndex::PARABOLIC_WAVE)
+	{
+		// --- cosine series: 1/g^2; no DC component
+		for (int g = 1; g <= numHarmonics; g++)
+			real[g % tableLength] += 1.0 / ((double)g*(double)g);
+	}
+	else if (spec.waveform == wtWaveFormIndex::TRIANGLE_WAVE)
+	{
+		// --- sine series on odd harmonics: (-1)^g / (2g + 1)^2; sine = -j in the bin
+		for (int g = 0; g <= halfNumHarmonics; g++)
+		{
+			double harmonic = 2.0 * g + 1.0;
+			double amplitude = (g % 2 == 0 ? 1.0 : -1.0) / (harmonic*harmonic);
+			imag[(uint64_t)harmonic % tableLength] -= amplitude;
+		}
+	}
+	else // --- SINE_WAVE
+	{
+		imag[1 % tableLength] -= 1.0;
+	}
+}
+
+void BandLimitedTableGenerator::synthesizeTable(const BandLimitedTableSpec& spec, double seedFrequency, double* table, void* fft)
+{
+	uint32_t tableLength = spec.tableLength;
+	std::vector<double> real;
+	std::vector<double> imag;
+	fillSpectrum(spec, seedFrequency, real, imag);
+
+#ifdef HAVE_FFTW
+	fftw_complex* result = ((FastFFT*)fft)->doInverseFFT(&real[0], &imag[0]);
+	for (uint32_t n = 0; n < tableLength; n++)
+		table[n] = result[n][0];
+#else
+	if (fft)
+	{
+		((Radix2FFT*)fft)->inverseFFT(&real[0], &imag[0]);
+		for (uint32_t n = 0; n < tableLength; n++)
+			table[n] = real[n];
+	}
+	else
+	{
+		// --- no FFT for this length; sum the (few) non-zero bins directly
+		memset(table, 0, tableLength * sizeof(double));
+		for (uint32_t k = 0; k < tableLength; k++)
+		{
+			if (real[k] == 0.0 && imag[k] == 0.0)
+				continue;
+
+			for (uint32_t n = 0; n < tableLength; n++)
+			{
+				double phase = 2.0 * kPi * (double)k * (double)n / (double)tableLength;
+				table[n] += real[k] * cos(phase) - imag[k] * sin(phase);
+			}
+		}
+	}
+#endif
+
+	// --- normalize
+	double maxTableValue = table[0];
+	for (uint32_t n = 1; n < tableLength; n++)
+	{
+		if (table[n] > maxTableValue)
+			maxTableValue = table[n];
+	}
+
+	if (maxTableValue > 0.0)
+	{
+		for (uint32_t n = 0; n < tableLength; n++)
+			table[n] /= maxTableValue;
+	}
+}
+
+bool BandLimitedTableGenerator::replicateTablePointers(double* multiTable128[MAX_WAVE_TABLES])
+{
+	int nLastIndex = -1;
+	double* pLastTable = nullptr;
+	for (uint32_t i = 0; i < MAX_WAVE_TABLES; i++)
+	{
+		if (multiTable128[i])
+		{
+			nLastIndex = i;
+			pLastTable = multiTable128[i];
+		}
+	}
+
+	if (!pLastTable)
+		return false; // no tables : (
+
+	// --- upper part first
+	for (int i = MAX_WAVE_TABLES - 1; i >= nLastIndex; i--)
+		multiTable128[i] = pLastTable;
+
+	// --- then fill each gap below a table with that table
+	for (int i = nLastIndex - 1; i >= 0; i--)
+	{
+		if (!multiTable128[i])
+			multiTable128[i] = pLastTable;
+		else
+			pLastTable = multiTable128[i];
+	}
+
+	return true;
+}
+
+// --- the state shared by the jobs of one createTables( ) call
+struct BandLimitedTableGenerator::GenerateContext
+{
+	GenerateContext(const BandLimitedTableSpec& _spec, const std::vector<TableSeed>& _seeds, double** _multiTable128)
+		: spec(_spec)
+		, seeds(_seeds)
+		, multiTable128(_multiTable128)
+		, nextSeed(0) { }
+
+	const BandLimitedTableSpec& spec;
+	const std::vector<TableSeed>& seeds;
+	double** multiTable128;
+	std::atomic<uint32_t> nextSeed;
+};
+
+// --- runJobs( ) is for one caller at a time
+static std::mutex& getWorkerPoolMutex()
+{
+	static std::mutex workerPoolMutex;
+	return workerPoolMutex;
+}
+
+std::shared_ptr<SynthWorkerPool> BandLimitedTableGenerator::acquireWorkerPool()
+{
+	// --- held only weakly here, so the threads are joined by the last holder and never
+	//     during static destruction
+	static std::mutex acquireMutex;
+	static std::weak_ptr<SynthWorkerPool> sharedPool;
+
+	std::lock_guard<std::mutex> lock(acquireMutex);
+	std::shared_ptr<SynthWorkerPool> workerPool = sharedPool.lock();
+	if (!workerPool)
+	{
+		uint32_t numCores = std::thread::hardware_concurrency();
+		workerPool = std::make_shared<SynthWorkerPool>();
+		workerPool->setNumWorkers(numCores > 1 ? numCores - 1 : 0);
+		sharedPool = workerPool;
+	}
+
+	return workerPool;
+}
+
+void BandLimitedTableGenerator::generateTablesJob(void* context, uint32_t job)
+{
+	GenerateContext* generate = (GenerateContext*)context;
+
+	void* fft = nullptr;
+#ifdef HAVE_FFTW
+	// --- the FFTW planner is not thread safe; execution is
+	static std::mutex planMutex;
+	FastFFT fastFFT;
+	{
+		std::lock_guard<std::mutex> lock(planMutex);
+		fastFFT.initialize(generate->spec.tableLength, windowType::kNoWindow);
+	}
+	fft = &fastFFT;
+#else
+	// --- one set of twiddles per job; other lengths fall back to the additive sum
+	Radix2FFT radix2FFT;
+	if (Radix2FFT::isPowerOfTwo(generate->spec.tableLength))
+	{
+		radix2FFT.initialize(generate->spec.tableLength);
+		fft = &radix2FFT;
+	}
+#endif
+	uint32_t seedIndex;
+	while ((seedIndex = generate->nextSeed.fetch_add(1)) < generate->seeds.size())
+		synthesizeTable(generate->spec, generate->seeds[seedIndex].frequency, generate->multiTable128[generate->seeds[seedIndex].midiNote], fft);
+}
+
+bool BandLimitedTableGenerator::createTables(const BandLimitedTableSpec& spec, double* multiTable128[MAX_WAVE_TABLES], const std::string& cacheDirectory)
+{
+	if (spec.tableLength < 2 || spec.sampleRate <= 0.0)
+		return false;
+
+	std::vector<TableSeed> seeds = calculateTableSeeds(spec.tableInterval);
+	if (seeds.size() == 0)
+		return false;
+
+	for (uint32_t i = 0; i < MAX_WAVE_TABLES; i++)
+		multiTable128[i] = nullptr;
+
+	// --- try the cache
+	std::string cacheFilePath;
+	if (cacheDirectory.size() > 0)
+	{
+		cacheFilePath = getCacheFilePath(spec, cacheDirectory);
+		if (readCacheFile(spec, seeds, cacheFilePath, multiTable128))
+			return replicateTablePointers(multiTable128);
+	}
+
+	// --- allocate here so workers only write
+	for (uint32_t i = 0; i < seeds.size(); i++)
+		multiTable128[seeds[i].midiNote] = new double[spec.tableLength];
+
+	// --- one job per thread; each pulls tables until the seeds run out
+	GenerateContext context(spec, seeds, multiTable128);
+	{
+		std::shared_ptr<SynthWorkerPool> workerPool = acquireWorkerPool();
+		std::lock_guard<std::mutex> lock(getWorkerPoolMutex());
+		uint32_t numJobs = std::min(workerPool->getNumWorkers() + 1, (uint32_t)seeds.size());
+		workerPool->runJobs(&BandLimitedTableGenerator::generateTablesJob, &context, numJobs);
+	}
+
+	if (cacheFilePath.size() > 0)
+		writeCacheFile(spec, seeds, cacheFilePath, multiTable128);
+
+	return replicateTablePointers(multiTable128);
+}
+
+BandLimitedTableSet::~BandLimitedTableSet()
+{
+	// --- pointers repeat across slots; delete each table once
+	std::vector<double*> distinctTables(tables);
+	std::sort(distinctTables.begin(), distinctTables.end());
+	distinctTables.erase(std::unique(distinctTables.begin(), distinctTables.end()), distinctTables.end());
+	for (uint32_t i = 0; i < distinctTables.size(); i++)
+		delete[] distinctTables[i];
+}
+
+std::shared_ptr<const BandLimitedTableSet> BandLimitedTableGenerator::acquireTables(const BandLimitedTableSpec& spec, const std::string& cacheDirectory)
+{
+	std::stringstream key;
+	key << "bltable:" << spec.waveform << ":" << spec.tableInterval << ":" << spec.tableLength << ":" << (uint64_t)(spec.sampleRate * 100.0 + 0.5);
+
+	return SharedTableStore::getInstance().acquire<BandLimitedTableSet>(key.str(), [&]()
+	{
+		std::shared_ptr<BandLimitedTableSet> tableSet = std::make_shared<BandLimitedTableSet>();
+		if (!createTables(spec, tableSet->tables.data(), cacheDirectory))
+			return std::shared_ptr<BandLimitedTableSet>();
+
+		return tableSet;
+	});
+}
+
+std::string BandLimitedTableGenerator::getDefaultCacheDirectory()
+{
+#if defined _WINDOWS || defined _WINDLL
+	char tempPath[MAX_PATH + 1] = { 0 };
+	DWORD length = GetTempPathA(MAX_PATH + 1, tempPath);
+	if (length == 0 || length > MAX_PATH)
+		return "";
+
+	std::string directory(tempPath, length);
+	if (directory.size() > 0 && directory.back() == '\\')
+		directory.pop_back();
+	return directory;
+#else
+	const char* tempPath = getenv("TMPDIR");
+	return tempPath && *tempPath ? std::string(tempPath) : std::string("/tmp");
+#endif
+}
+
+std::string BandLimitedTableGenerator::getCacheFilePath(const BandLimitedTableSpec& spec, const std::string& cacheDirectory)
+{
+	// --- sample rate to 1/100 Hz
+	std::stringstream name;
+	name << "bltable_w" << spec.waveform << "_i" << spec.tableInterval << "_n" << spec.tableLength
+		 << "_r" << (uint64_t)(spec.sampleRate * 100.0 + 0.5) << ".blt";
+
+	return cacheDirectory + kBLTablePathSeparator + name.str();
+}
+
+bool BandLimitedTableGenerator::readCacheFile(const BandLimitedTableSpec& spec, const std::vector<TableSeed>& seeds, const std::string& filePath, double* multiTable128[MAX_WAVE_TABLES])
+{
+	std::ifstream inFile(filePath.c_str(), std::ifstream::binary);
+	if (!inFile.is_open())
+		return false;
+
+	char magic[4] = { 0 };
+	uint32_t header[4] = { 0 };
+	double sampleRate = 0.0;
+	inFile.read(magic, sizeof(magic));
+	inFile.read((char*)header, sizeof(header));
+	inFile.read((char*)&sampleRate, sizeof(double));
+
+	if (!inFile || memcmp(magic, kBLTableCacheMagic, sizeof(magic)) != 0 ||
+		header[0] != spec.waveform || header[1] != spec.tableInterval || header[2] != spec.tableLength ||
+		header[3] != seeds.size() || sampleRate != spec.sampleRate)
+		return false;
+
+	std::vector<double*> tables;
+	for (uint32_t i = 0; i < seeds.size(); i++)
+	{
+		uint32_t midiNote = 0;
+		inFile.read((char*)&midiNote, sizeof(uint32_t));
+		double* table = new double[spec.tableLength];
+		inFile.read((char*)table, spec.tableLength * sizeof(double));
+		tables.push_back(table);
+
+		if (!inFile || midiNote != seeds[i].midiNote)
+		{
+			for (uint32_t j = 0; j < tables.size(); j++)
+				delete[] tables[j];
+			return false;
+		}
+	}
+
+	for (uint32_t i = 0; i < seeds.size(); i++)
+		multiTable128[seeds[i].midiNote] = tables[i];
+
+	return true;
+}
+
+bool BandLimitedTableGenerator::writeCacheFile(const BandLimitedTableSpec& spec, const std::vector<TableSeed>& seeds, const std::string& filePath, double* multiTable128[MAX_WAVE_TABLES])
+{
+	// --- write aside and rename so a reader never sees a partial file
+	std::stringstream tempPath;
+	tempPath << filePath << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << ".tmp";
+
+	{
+		std::ofstream outFile(tempPath.str().c_str(), std::ofstream::binary | std::ofstream::trunc);
+		if (!outFile.is_open())
+			return false;
+
+		uint32_t header[4] = { spec.waveform, spec.tableInterval, spec.tableLength, (uint32_t)seeds.size() };
+		outFile.write(kBLTableCacheMagic, sizeof(kBLTableCacheMagic));
+		outFile.write((const char*)header, sizeof(header));
+		outFile.write((const char*)&spec.sampleRate, sizeof(double));
+
+		for (uint32_t i = 0; i < seeds.size(); i++)
+		{
+			outFile.write((const char*)&seeds[i].midiNote, sizeof(uint32_t));
+			outFile.write((const char*)multiTable128[seeds[i].midiNote], spec.tableLength * sizeof(double));
+		}
+
+		if (!outFile.good())
+		{
+			outFile.close();
+			std::remove(tempPath.str().c_str());
+			return false;
+		}
+	}
+
+	std::remove(filePath.c_str());
+	if (std::rename(tempPath.str().c_str(), filePath.c_str()) != 0)
+	{
+		std::remove(tempPath.str().c_str());
+		return false;
+	}
+
+	return true;
+}
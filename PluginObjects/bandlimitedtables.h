@@ -0,0 +1,103 @@
+#ifndef __bandLimitedTables_h__
+#define __bandLimitedTables_h__
+
+// --- includes
+#include "synthdefs.h"
+#include "wavetable.h"
+
+#include <memory>
+
+class SynthWorkerPool;
+
+/**
+\struct BandLimitedTableSpec
+\ingroup SynthStructures
+\brief Everything that determines the contents of a set of band-limited tables; also the
+disk cache key.
+*/
+struct BandLimitedTableSpec
+{
+	uint32_t waveform = 0;			///< wtWaveFormIndex
+	uint32_t tableInterval = 0;		///< wtTableInterval
+	uint32_t tableLength = 1024;	///< samples per table
+	double sampleRate = 44100.0;	///< harmonics are limited to this rate's Nyquist
+};
+
+/**
+\struct BandLimitedTableSet
+\ingroup SynthStructures
+\brief A generated multi-table shared through the SharedTableStore; owns its tables.
+*/
+struct BandLimitedTableSet
+{
+	BandLimitedTableSet() : tables(MAX_WAVE_TABLES, nullptr) { }
+	~BandLimitedTableSet();
+
+	std::vector<double*> tables; ///< one pointer per MIDI note, repeated for neighbors
+};
+
+/**
+\class BandLimitedTableGenerator
+\ingroup SynthClasses
+\brief Creates multi-tables (one pointer per MIDI note) of band-limited waveforms.
+
+Each table is built as a spectrum and converted with one inverse FFT (FastFFT when HAVE_FFTW is
+defined, otherwise the shared Radix2FFT; non power-of-2 lengths use the additive sum).
+Tables are spread across one process-wide pool of worker threads and the finished set is cached
+on disk keyed by the BandLimitedTableSpec, so a second request for the same set (e.g. returning
+to a sample rate) is a file read. The pool lives while anyone holds acquireWorkerPool( ); without
+a holder each createTables( ) call starts and joins its own. Calls from different threads take
+turns on the pool.
+
+Tables are allocated with new[]; the same pointer repeats in neighboring slots for octave and
+min 3rd intervals.
+*/
+class BandLimitedTableGenerator
+{
+public:
+	BandLimitedTableGenerator() { }
+	~BandLimitedTableGenerator() { }
+
+	// --- fill multiTable128; cacheDirectory = "" disables the disk cache
+	static bool createTables(const BandLimitedTableSpec& spec, double* multiTable128[MAX_WAVE_TABLES], const std::string& cacheDirectory);
+
+	// --- the same set, shared process-wide (see SharedTableStore); nullptr on failure
+	static std::shared_ptr<const BandLimitedTableSet> acquireTables(const BandLimitedTableSpec& spec, const std::string& cacheDirectory);
+
+	// --- the platform temp folder
+	static std::string getDefaultCacheDirectory();
+
+	// --- the shared generator threads; hold the pointer to keep them between createTables( ) calls
+	static std::shared_ptr<SynthWorkerPool> acquireWorkerPool();
+
+private:
+	// --- one table: the MIDI note slot it starts at and its fundamental
+	struct TableSeed
+	{
+		uint32_t midiNote = 0;
+		double frequency = 0.0;
+	};
+
+	static std::vector<TableSeed> calculateTableSeeds(uint32_t tableInterval);
+
+	// --- pool job: synthesize tables until the seeds run out
+	struct GenerateContext;
+	static void generateTablesJob(void* context, uint32_t job);
+
+	// --- harmonic amplitudes as complex bins (sum of Re{X[k] e^(j2pikn/N)})
+	static void fillSpectrum(const BandLimitedTableSpec& spec, double seedFrequency, std::vector<double>& real, std::vector<double>& imag);
+
+	// --- spectrum -> normalized table; fft is a FastFFT with HAVE_FFTW, else a Radix2FFT or
+	//     nullptr for the additive sum
+	static void synthesizeTable(const BandLimitedTableSpec& spec, double seedFrequency, double* table, void* fft);
+
+	// --- repeat table pointers into the empty slots
+	static bool replicateTablePointers(double* multiTable128[MAX_WAVE_TABLES]);
+
+	// --- disk cache
+	static std::string getCacheFilePath(const BandLimitedTableSpec& spec, const std::string& cacheDirectory);
+	static bool readCacheFile(const BandLimitedTableSpec& spec, const std::vector<TableSeed>& seeds, const std::string& filePath, double* multiTable128[MAX_WAVE_TABLES]);
+	static bool writeCacheFile(const BandLimitedTableSpec& spec, const std::vector<TableSeed>& seeds, const std::string& filePath, double* multiTable128[MAX_WAVE_TABLES]);
+};
+
+#endif /* defined(__bandLimitedTables_h__) */
@@ -0,0 +1,437 @@
+// --- Synth Core v1.0
+//
+#include "brickfile.h"
+#include "sharedtablestore.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined _WINDOWS || defined _WINDLL
+#include <windows.h>
+const std::string kPathSeparator = "\\";
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#include <dirent.h>
+const std::string kPathSeparator = "/";
+#endif
+
+// --- brick files --------------------------------------------------------------------------
+static bool brickError(std::string* errorString, const std::string& message)
+{
+	if (errorString)
+		*errorString = message;
+	return false;
+}
+
+bool readBrickFileInfo(MappedFile& file, BrickFileInfo& info, std::string* errorString)
+{
+	const uint8_t* data = file.getData();
+	uint64_t size = file.getSize();
+
+	// --- header
+	if (!data || size < sizeof(BrickFileDescriptor))
+		return brickError(errorString, "file is too short for a brick header");
+
+	BrickFileDescriptor bfd;
+	memcpy(&bfd, data, sizeof(BrickFileDescriptor));
+
+	if (bfd.numStoredTables == 0 || bfd.numStoredTables > MAX_HIRES_TABLE_SET)
+		return brickError(errorString, "bad stored table count");
+
+	if (!std::isfinite(bfd.outputComp) || !std::isfinite(bfd.fs) || bfd.fs <= 0.0)
+		return brickError(errorString, "bad output comp or sample rate");
+
+	// --- note map: in range, never decreasing (tables are stored in note order)
+	for (uint32_t n = 0; n < MAX_HIRES_TABLE_SET; n++)
+	{
+		if (bfd.tableIndexArray[n] >= bfd.numStoredTables)
+			return brickError(errorString, "table index out of range");
+		if (n > 0 && bfd.tableIndexArray[n] < bfd.tableIndexArray[n - 1])
+			return brickError(errorString, "table indexes are not in note order");
+		if (bfd.lenArray[n] == 0 || bfd.lenArray[n] > kMaxBrickTableLength)
+			return brickError(errorString, "bad table length");
+	}
+
+	// --- walk the stored tables; every one must fit in the file
+	info.tableOffsets.clear();
+	uint64_t offset = sizeof(BrickFileDescriptor);
+	for (uint32_t i = 0; i < bfd.numStoredTables; i++)
+	{
+		if (offset + sizeof(uint32_t) > size)
+			return brickError(errorString, "file is truncated");
+
+		uint32_t tableLen = 0;
+		memcpy(&tableLen, data + offset, sizeof(uint32_t));
+		if (tableLen == 0 || tableLen > kMaxBrickTableLength)
+			return brickError(errorString, "bad stored table length");
+
+		if (offset + sizeof(uint32_t) + (uint64_t)tableLen * sizeof(uint64_t) > size)
+			return brickError(errorString, "file is truncated");
+
+		info.tableOffsets.push_back(offset);
+		offset += sizeof(uint32_t) + (uint64_t)tableLen * sizeof(uint64_t);
+	}
+
+	// --- the note map lengths must agree with the stored lengths
+	for (uint32_t n = 0; n < MAX_HIRES_TABLE_SET; n++)
+	{
+		uint32_t tableLen = 0;
+		memcpy(&tableLen, data + info.tableOffsets[bfd.tableIndexArray[n]], sizeof(uint32_t));
+		if (tableLen != bfd.lenArray[n])
+			return brickError(errorString, "table length does not match note map");
+	}
+
+	// --- name is not guaranteed to be terminated
+	uint32_t nameLen = 0;
+	while (nameLen < sizeof(bfd.waveName) && bfd.waveName[nameLen] != 0)
+		nameLen++;
+	info.waveName.assign(bfd.waveName, nameLen);
+	info.fileSize = size;
+
+	return true;
+}
+
+void decodeBrickTable(const uint8_t* src, double* dest, uint32_t length, uint64_t key)
+{
+	// --- straight-line XOR + bitcast; memcpy keeps it legal for unaligned sources and
+	//     the loop vectorizes
+	uint64_t* destBits = (uint64_t*)dest;
+	for (uint32_t i = 0; i < length; i++)
+	{
+		uint64_t bits;
+		memcpy(&bits, src + i * sizeof(uint64_t), sizeof(uint64_t));
+		destBits[i] = bits ^ key;
+	}
+}
+
+HiResWTSet* loadBrickFile(const std::string& filePath, std::string* errorString)
+{
+	MappedFile file;
+	if (!file.open(filePath))
+	{
+		brickError(errorString, "cannot open file");
+		return nullptr;
+	}
+
+	BrickFileInfo info;
+	if (!readBrickFileInfo(file, info, errorString))
+		return nullptr;
+
+	BrickFileDescriptor bfd;
+	memcpy(&bfd, file.getData(), sizeof(BrickFileDescriptor));
+
+	HiResWTSet* pHRWTS = new HiResWTSet;
+	pHRWTS->waveformNameForGUI = info.waveName;
+	pHRWTS->tableLengths = new uint32_t[MAX_HIRES_TABLE_SET];
+	memcpy(&pHRWTS->tableLengths[0], &bfd.lenArray[0], sizeof(uint32_t)*MAX_HIRES_TABLE_SET);
+	pHRWTS->pp_dDecimalTableSet = new double*[MAX_HIRES_TABLE_SET];
+
+	// --- a stored table the note map skips would have no owner once loaded, since the set
+	//     is freed by walking the note map; so only referenced tables are decoded
+	std::vector<bool> tableReferenced(bfd.numStoredTables, false);
+	for (uint32_t n = 0; n < MAX_HIRES_TABLE_SET; n++)
+		tableReferenced[bfd.tableIndexArray[n]] = true;
+
+	// --- decode each stored table once, straight from the file into its final buffer
+	uint64_t key = bfd.isEncrypted ? bfd.encryptionKey : 0;
+	std::vector<double*> storedTables(bfd.numStoredTables, nullptr);
+	for (uint32_t i = 0; i < bfd.numStoredTables; i++)
+	{
+		if (!tableReferenced[i])
+			continue;
+
+		const uint8_t* tableData = file.getData() + info.tableOffsets[i];
+		uint32_t tableLen = 0;
+		memcpy(&tableLen, tableData, sizeof(uint32_t));
+
+		storedTables[i] = new double[tableLen];
+		decodeBrickTable(tableData + sizeof(uint32_t), storedTables[i], tableLen, key);
+	}
+
+	for (uint32_t n = 0; n < MAX_HIRES_TABLE_SET; n++)
+		pHRWTS->pp_dDecimalTableSet[n] = storedTables[bfd.tableIndexArray[n]];
+
+	// --- massage the structure to reflect the import
+	pHRWTS->tableDataType = wtDataType::decimal; // we converted to decimal here
+	pHRWTS->isHexTable = false;
+	pHRWTS->isEncrypted = false;
+	pHRWTS->outputComp = bfd.outputComp;
+	pHRWTS->tableFs = bfd.fs;
+	pHRWTS->isDynamicTable = true; // we are dynamic and need deleting
+
+	return pHRWTS;
+}
+
+// --- size and modified time, without opening the file
+static bool getFileStamp(const std::string& filePath, uint64_t& fileSize, uint64_t& modifiedTime)
+{
+#if defined _WINDOWS || defined _WINDLL
+	WIN32_FILE_ATTRIBUTE_DATA fileData;
+	if (!GetFileAttributesExA(filePath.c_str(), GetFileExInfoStandard, &fileData))
+		return false;
+
+	fileSize = ((uint64_t)fileData.nFileSizeHigh << 32) | fileData.nFileSizeLow;
+	modifiedTime = ((uint64_t)fileData.ftLastWriteTime.dwHighDateTime << 32) | fileData.ftLastWriteTime.dwLowDateTime;
+#else
+	struct stat fileStat;
+	if (stat(filePath.c_str(), &fileStat) != 0)
+		return false;
+
+	fileSize = (uint64_t)fileStat.st_size;
+	modifiedTime = (uint64_t)fileStat.st_mtime;
+#endif
+	return true;
+}
+
+SharedHiResWTSet::~SharedHiResWTSet()
+{
+	if (!hiResWTSet)
+		return;
+
+	// --- tables are stored in note order, so repeats are neighbors
+	double* pDeletedTable = nullptr;
+	for (uint32_t i = 0; i < MAX_HIRES_TABLE_SET; i++)
+	{
+		double* pTable = hiResWTSet->pp_dDecimalTableSet[i];
+		if (pTable != pDeletedTable)
+		{
+			pDeletedTable = pTable;
+			delete[] pTable;
+		}
+	}
+	delete[] hiResWTSet->pp_dDecimalTableSet;
+	delete[] hiResWTSet->tableLengths;
+	delete hiResWTSet;
+}
+
+std::shared_ptr<const SharedHiResWTSet> acquireBrickFile(const std::string& filePath, std::string* errorString)
+{
+	uint64_t fileSize = 0;
+	uint64_t modifiedTime = 0;
+	if (!getFileStamp(filePath, fileSize, modifiedTime))
+	{
+		brickError(errorString, "cannot open file");
+		return nullptr;
+	}
+
+	// --- an edited file gets a new key; instances still using the old one keep it
+	std::stringstream key;
+	key << "brick:" << filePath << ":" << fileSize << ":" << modifiedTime;
+
+	return SharedTableStore::getInstance().acquire<SharedHiResWTSet>(key.str(), [&]()
+	{
+		HiResWTSet* pHRWTS = loadBrickFile(filePath, errorString);
+		if (!pHRWTS)
+			return std::shared_ptr<SharedHiResWTSet>();
+
+		// --- owned by the shared holder now
+		pHRWTS->isDynamicTable = false;
+
+		std::shared_ptr<SharedHiResWTSet> sharedSet = std::make_shared<SharedHiResWTSet>();
+		sharedSet->hiResWTSet = pHRWTS;
+		return sharedSet;
+	});
+}
+
+// --- Wavetable: declared in wavetable.h
+bool Wavetable::initWithBrickFile(std::string filePath)
+{
+	std::shared_ptr<const SharedHiResWTSet> sharedSet = acquireBrickFile(filePath);
+	if (!sharedSet)
+		return false;
+
+	HiResWTSet* pHRWTS = sharedSet->hiResWTSet;
+	sharedTableData = sharedSet;
+	pHiResWTSet = pHRWTS;
+	waveformName.assign(pHRWTS->waveformNameForGUI);
+	tableType = wtTableType::kHiResWTSet;
+	outputComp = pHRWTS->outputComp;
+	return true;
+}
+
+// --- BrickFileIndex -----------------------------------------------------------------------
+bool BrickFileIndex::listBrickFiles(const std::string& directoryPath, std::vector<BrickFileInfo>& fileList)
+{
+#if defined _WINDOWS || defined _WINDLL
+	WIN32_FIND_DATAA findData;
+	HANDLE hFind = FindFirstFileA((directoryPath + kPathSeparator + "*" + kBrickFileExtension).c_str(), &findData);
+	if (hFind == INVALID_HANDLE_VALUE)
+		return GetLastError() == ERROR_FILE_NOT_FOUND;
+
+	do
+	{
+		if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+			continue;
+
+		BrickFileInfo info;
+		info.fileName = findData.cFileName;
+		info.filePath = directoryPath + kPathSeparator + info.fileName;
+		info.fileSize = ((uint64_t)findData.nFileSizeHigh << 32) | findData.nFileSizeLow;
+		info.modifiedTime = ((uint64_t)findData.ftLastWriteTime.dwHighDateTime << 32) | findData.ftLastWriteTime.dwLowDateTime;
+		fileList.push_back(info);
+	} while (FindNextFileA(hFind, &findData));
+
+	FindClose(hFind);
+#else
+	DIR* dir = opendir(directoryPath.c_str());
+	if (!dir)
+		return false;
+
+	while (struct dirent* entry = readdir(dir))
+	{
+		std::string fileName = entry->d_name;
+		if (fileName.size() <= kBrickFileExtension.size() ||
+			fileName.compare(fileName.size() - kBrickFileExtension.size(), kBrickFileExtension.size(), kBrickFileExtension) != 0)
+			continue;
+
+		BrickFileInfo info;
+		info.fileName = fileName;
+		info.filePath = directoryPath + kPathSeparator + fileName;
+
+		struct stat fileStat;
+		if (stat(info.filePath.c_str(), &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+			continue;
+
+		info.fileSize = (uint64_t)fileStat.st_size;
+		info.modifiedTime = (uint64_t)fileStat.st_mtime;
+		fileList.push_back(info);
+	}
+
+	closedir(dir);
+#endif
+
+	return true;
+}
+
+// --- index file: one header line, then one line per brick file:
+//     fileName <tab> fileSize <tab> modifiedTime <tab> waveName <tab> offset offset ...
+bool BrickFileIndex::readIndexFile(const std::string& indexPath, std::map<std::string, BrickFileInfo>& cache)
+{
+	std::ifstream inFile(indexPath.c_str());
+	if (!inFile.is_open())
+		return false;
+
+	std::string line;
+	if (!std::getline(inFile, line) || line != "brickindex 1")
+		return false;
+
+	while (std::getline(inFile, line))
+	{
+		std::stringstream lineStream(line);
+		std::string fileName, fileSize, modifiedTime, waveName, offsets;
+		if (!std::getline(lineStream, fileName, '\t') ||
+			!std::getline(lineStream, fileSize, '\t') ||
+			!std::getline(lineStream, modifiedTime, '\t') ||
+			!std::getline(lineStream, waveName, '\t') ||
+			!std::getline(lineStream, offsets))
+			return false;
+
+		BrickFileInfo info;
+		info.fileName = fileName;
+		info.waveName = waveName;
+		info.fileSize = strtoull(fileSize.c_str(), nullptr, 10);
+		info.modifiedTime = strtoull(modifiedTime.c_str(), nullptr, 10);
+
+		std::stringstream offsetStream(offsets);
+		uint64_t offset = 0;
+		while (offsetStream >> offset)
+			info.tableOffsets.push_back(offset);
+
+		if (info.tableOffsets.size() == 0 || info.tableOffsets.size() > MAX_HIRES_TABLE_SET)
+			return false;
+
+		cache[fileName] = info;
+	}
+
+	return true;
+}
+
+bool BrickFileIndex::writeIndexFile(const std::string& indexPath)
+{
+	std::ofstream outFile(indexPath.c_str(), std::ofstream::trunc);
+	if (!outFile.is_open())
+		return false;
+
+	outFile << "brickindex 1\n";
+	for (uint32_t i = 0; i < entries.size(); i++)
+	{
+		const BrickFileInfo& info = entries[i];
+
+		// --- tabs and newlines would break the line format; those files are just rescanned
+		if (info.fileName.find_first_of("\t\r\n") != std::string::npos ||
+			info.waveName.find_first_of("\t\r\n") != std::string::npos)
+			continue;
+
+		outFile << info.fileName << '\t' << info.fileSize << '\t' << info.modifiedTime << '\t' << info.waveName << '\t';
+		for (uint32_t j = 0; j < info.tableOffsets.size(); j++)
+			outFile << (j > 0 ? " " : "") << info.tableOffsets[j];
+		outFile << '\n';
+	}
+
+	return outFile.good();
+}
+
+uint32_t BrickFileIndex::scanDirectory(const std::string& directoryPath, bool useCachedIndex)
+{
+	directory = directoryPath;
+	entries.clear();
+	rejectedFiles.clear();
+
+	std::vector<BrickFileInfo> fileList;
+	if (!listBrickFiles(directoryPath, fileList))
+		return 0;
+
+	std::string indexPath = directoryPath + kPathSeparator + kBrickIndexFileName;
+	std::map<std::string, BrickFileInfo> cache;
+	bool indexChanged = !(useCachedIndex && readIndexFile(indexPath, cache));
+
+	for (uint32_t i = 0; i < fileList.size(); i++)
+	{
+		BrickFileInfo& info = fileList[i];
+
+		// --- unchanged since the index was written: no need to open it
+		auto it = cache.find(info.fileName);
+		if (it != cache.end() && it->second.fileSize == info.fileSize && it->second.modifiedTime == info.modifiedTime)
+		{
+			info.waveName = it->second.waveName;
+			info.tableOffsets = it->second.tableOffsets;
+			entries.push_back(info);
+			cache.erase(it);
+			continue;
+		}
+
+		indexChanged = true;
+
+		MappedFile file;
+		uint64_t modifiedTime = info.modifiedTime;
+		if (file.open(info.filePath) && readBrickFileInfo(file, info))
+		{
+			info.modifiedTime = modifiedTime;
+			entries.push_back(info);
+		}
+		else
+			rejectedFiles.push_back(info.fileName);
+	}
+
+	// --- files removed since the index was written
+	if (cache.size() > 0)
+		indexChanged = true;
+
+	std::sort(entries.begin(), entries.end(),
+		[](const BrickFileInfo& a, const BrickFileInfo& b) { return a.fileName < b.fileName; });
+
+	if (indexChanged)
+		writeIndexFile(indexPath);
+
+	return entries.size();
+}
+
+std::vector<std::string> BrickFileIndex::getWaveNames()
+{
+	std::vector<std::string> stringList;
+	for (uint32_t i = 0; i < entries.size(); i++)
+		stringList.push_back(entries[i].waveName);
+
+	return stringList;
+}
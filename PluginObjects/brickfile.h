@@ -0,0 +1,100 @@
+#ifndef __brickFile_h__
+#define __brickFile_h__
+
+// --- includes
+#include "synthdefs.h"
+#include "wavetable.h"
+#include "mappedfile.h"
+
+#include <map>
+
+// --- brick (.tbl) file layout:
+//     [BrickFileDescriptor][uint32_t tableLen_0][uint64_t hex_0[tableLen_0]][uint32_t tableLen_1]...
+//     tableIndexArray[n] selects the stored table for MIDI note n and must not decrease with n
+const uint32_t kMaxBrickTableLength = 65536;
+const std::string kBrickFileExtension = ".tbl";
+const std::string kBrickIndexFileName = "brickindex.txt";
+
+/**
+\struct BrickFileInfo
+\ingroup SynthStructures
+\brief What the GUI and the loader need to know about one brick file without decoding it.
+*/
+struct BrickFileInfo
+{
+	std::string fileName;			///< name only, no directory
+	std::string filePath;			///< full path
+	std::string waveName;			///< from the descriptor
+	uint64_t fileSize = 0;			///< for cache validation
+	uint64_t modifiedTime = 0;		///< for cache validation
+	std::vector<uint64_t> tableOffsets; ///< byte offset of each stored table's length field
+};
+
+// --- validate a mapped brick file and fill in its info; returns false with a reason on any error
+bool readBrickFileInfo(MappedFile& file, BrickFileInfo& info, std::string* errorString = nullptr);
+
+// --- load and decode a brick file into a dynamic HiResWTSet (isDynamicTable = true; the
+//     Wavetable that owns it deletes it); returns nullptr on any error
+HiResWTSet* loadBrickFile(const std::string& filePath, std::string* errorString = nullptr);
+
+/**
+\struct SharedHiResWTSet
+\ingroup SynthStructures
+\brief A decoded brick file shared through the SharedTableStore; owns the set (whose
+isDynamicTable flag is false so Wavetables never delete it).
+*/
+struct SharedHiResWTSet
+{
+	SharedHiResWTSet() { }
+	~SharedHiResWTSet();
+
+	HiResWTSet* hiResWTSet = nullptr;
+};
+
+// --- the decoded file, shared process-wide and keyed by path, size and modified time;
+//     nullptr on any error
+std::shared_ptr<const SharedHiResWTSet> acquireBrickFile(const std::string& filePath, std::string* errorString = nullptr);
+
+// --- bulk decode: XOR with the key and bitcast to double; src may be unaligned
+void decodeBrickTable(const uint8_t* src, double* dest, uint32_t length, uint64_t key);
+
+/**
+\class BrickFileIndex
+\ingroup SynthClasses
+\brief Directory of brick files with a cached on-disk index (kBrickIndexFileName) of names and
+table offsets. A file is only opened when it is new or its size/modified time has changed, so
+large user directories list quickly.
+*/
+class BrickFileIndex
+{
+public:
+	BrickFileIndex() { }
+	~BrickFileIndex() { }
+
+	// --- scan a directory (not recursive); returns the number of valid brick files
+	uint32_t scanDirectory(const std::string& directoryPath, bool useCachedIndex = true);
+
+	// --- sorted by file name
+	const std::vector<BrickFileInfo>& getEntries() { return entries; }
+	uint32_t getNumEntries() { return entries.size(); }
+
+	// --- wave names for the GUI, no files opened
+	std::vector<std::string> getWaveNames();
+
+	// --- files that failed validation during the last scan
+	const std::vector<std::string>& getRejectedFiles() { return rejectedFiles; }
+
+private:
+	std::string directory;
+	std::vector<BrickFileInfo> entries;
+	std::vector<std::string> rejectedFiles;
+
+	// --- directory listing with size and time
+	bool listBrickFiles(const std::string& directoryPath, std::vector<BrickFileInfo>& fileList);
+
+	// --- index file I/O
+	bool readIndexFile(const std::string& indexPath, std::map<std::string, BrickFileInfo>& cache);
+	bool writeIndexFile(const std::string& indexPath);
+};
+
+#endif /* defined(__brickFile_h__) */
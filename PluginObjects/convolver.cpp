@@ -0,0 +1,438 @@
+// --- Synth Core v1.0
+//
+#include "convolver.h"
+
+#include <algorithm>
+
+// --- ConvolverStage -----------------------------------------------------------------------
+void ConvolverStage::initialize(uint32_t _partitionSize, const double* ir, uint32_t irLength)
+{
+	partitionSize = _partitionSize;
+	numBins = partitionSize + 1;
+	numPartitions = (irLength + partitionSize - 1) / partitionSize;
+
+	uint32_t fftLength = 2 * partitionSize;
+	fft.initialize(fftLength);
+
+	fftReal.assign(fftLength, 0.0);
+	fftImag.assign(fftLength, 0.0);
+	inputWindow.assign(fftLength, 0.0);
+	accumReal.assign(numBins, 0.0);
+	accumImag.assign(numBins, 0.0);
+
+	// --- each partition zero-padded to the FFT length; the unscaled inverse FFT's 1/N is folded
+	//     into the stored spectra
+	double scale = 1.0 / fftLength;
+	irReal.assign(numPartitions * numBins, 0.0);
+	irImag.assign(numPartitions * numBins, 0.0);
+	for (uint32_t k = 0; k < numPartitions; k++)
+	{
+		std::fill(fftReal.begin(), fftReal.end(), 0.0);
+		std::fill(fftImag.begin(), fftImag.end(), 0.0);
+
+		uint32_t start = k * partitionSize;
+		uint32_t count = std::min(partitionSize, irLength - start);
+		std::copy(ir + start, ir + start + count, fftReal.begin());
+
+		fft.forwardFFT(&fftReal[0], &fftImag[0]);
+
+		for (uint32_t bin = 0; bin < numBins; bin++)
+		{
+			irReal[k * numBins + bin] = fftReal[bin] * scale;
+			irImag[k * numBins + bin] = fftImag[bin] * scale;
+		}
+	}
+
+	fdlReal.assign(numPartitions * numBins, 0.0);
+	fdlImag.assign(numPartitions * numBins, 0.0);
+	fdlIndex = 0;
+}
+
+void ConvolverStage::clear()
+{
+	std::fill(fdlReal.begin(), fdlReal.end(), 0.0);
+	std::fill(fdlImag.begin(), fdlImag.end(), 0.0);
+	std::fill(inputWindow.begin(), inputWindow.end(), 0.0);
+	fdlIndex = 0;
+}
+
+void ConvolverStage::processPartition(const double* input, double* output)
+{
+	uint32_t fftLength = 2 * partitionSize;
+
+	// --- slide the window and transform
+	std::copy(inputWindow.begin() + partitionSize, inputWindow.end(), inputWindow.begin());
+	std::copy(input, input + partitionSize, inputWindow.begin() + partitionSize);
+
+	std::copy(inputWindow.begin(), inputWindow.end(), fftReal.begin());
+	std::fill(fftImag.begin(), fftImag.end(), 0.0);
+	fft.forwardFFT(&fftReal[0], &fftImag[0]);
+
+	// --- newest spectrum into the delay line
+	fdlIndex = fdlIndex == 0 ? numPartitions - 1 : fdlIndex - 1;
+	std::copy(fftReal.begin(), fftReal.begin() + numBins, fdlReal.begin() + fdlIndex * numBins);
+	std::copy(fftImag.begin(), fftImag.begin() + numBins, fdlImag.begin() + fdlIndex * numBins);
+
+	// --- partition k meets the input from k blocks ago
+	std::fill(accumReal.begin(), accumReal.end(), 0.0);
+	std::fill(accumImag.begin(), accumImag.end(), 0.0);
+
+	uint32_t fdlSlot = fdlIndex;
+	for (uint32_t k = 0; k < numPartitions; k++)
+	{
+		const double* xReal = &fdlReal[fdlSlot * numBins];
+		const double* xImag = &fdlImag[fdlSlot * numBins];
+		const double* hReal = &irReal[k * numBins];
+		const double* hImag = &irImag[k * numBins];
+
+		for (uint32_t bin = 0; bin < numBins; bin++)
+		{
+			accumReal[bin] += xReal[bin] * hReal[bin] - xImag[bin] * hImag[bin];
+			accumImag[bin] += xReal[bin] * hImag[bin] + xImag[bin] * hReal[bin];
+		}
+
+		if (++fdlSlot == numPartitions)
+			fdlSlot = 0;
+	}
+
+	// --- rebuild the full (conjugate symmetric) spectrum and go back
+	for (uint32_t bin = 0; bin < numBins; bin++)
+	{
+		fftReal[bin] = accumReal[bin];
+		fftImag[bin] = accumImag[bin];
+	}
+	for (uint32_t bin = 1; bin < partitionSize; bin++)
+	{
+		fftReal[fftLength - bin] = accumReal[bin];
+		fftImag[fftLength - bin] = -accumImag[bin];
+	}
+	fft.inverseFFT(&fftReal[0], &fftImag[0]);
+
+	// --- overlap-save: the second half is the linear convolution
+	std::copy(fftReal.begin() + partitionSize, fftReal.end(), output);
+}
+
+// --- PartitionedConvolver -----------------------------------------------------------------
+// --- no block has this number
+const uint64_t kNoConvolverBlock = ~(uint64_t)0;
+
+PartitionedConvolver::PartitionedConvolver(moodycamel::spsc_sema::LightweightSemaphore* _workerWakeup)
+	: workerWakeup(_workerWakeup)
+{
+	clearWorkerBlocks();
+}
+
+void PartitionedConvolver::clearWorkerBlocks()
+{
+	for (uint32_t s = 0; s < kNumConvolverStages - 1; s++)
+	{
+		WorkerStage& workerStage = workerStages[s];
+		workerStage.submittedBlocks.store(0);
+		workerStage.completedBlocks.store(0);
+		workerStage.readBlock = nullptr;
+		for (uint32_t slot = 0; slot < kConvolverWorkerSlots; slot++)
+			workerStage.inputSlotBlocks[slot].store(kNoConvolverBlock);
+	}
+}
+
+bool PartitionedConvolver::setImpulseResponse(const double* ir, uint32_t irLength)
+{
+	std::lock_guard<std::mutex> lock(serviceMutex);
+
+	impulseLength = ir ? irLength : 0;
+
+	// --- direct FIR head
+	for (uint32_t i = 0; i < kConvolverHeadLength; i++)
+		headIR[i] = i < impulseLength ? ir[i] : 0.0;
+
+	// --- first FFT stage, on the audio thread
+	uint32_t start = kConvolverStageStart[0];
+	uint32_t end = std::min(kConvolverStageStart[1], impulseLength);
+	audioStageActive = impulseLength > start;
+	if (audioStageActive)
+	{
+		audioStage.initialize(kConvolverPartitionSize[0], ir + start, end - start);
+		audioStageInput.assign(kConvolverPartitionSize[0], 0.0);
+		audioStageOutput.assign(kConvolverPartitionSize[0], 0.0);
+	}
+
+	// --- the rest, on the worker
+	for (uint32_t s = 1; s < kNumConvolverStages; s++)
+	{
+		WorkerStage& workerStage = workerStages[s - 1];
+
+		start = kConvolverStageStart[s];
+		end = s + 1 < kNumConvolverStages ? std::min(kConvolverStageStart[s + 1], impulseLength) : impulseLength;
+
+		workerStage.active = impulseLength > start;
+		if (!workerStage.active)
+			continue;
+
+		workerStage.partitionSize = kConvolverPartitionSize[s];
+		workerStage.delayBlocks = start / workerStage.partitionSize;
+		workerStage.stage.initialize(workerStage.partitionSize, ir + start, end - start);
+
+		workerStage.inputRing.assign(kConvolverWorkerSlots * workerStage.partitionSize, 0.0);
+		workerStage.outputRing.assign(kConvolverWorkerSlots * workerStage.partitionSize, 0.0);
+		workerStage.inputBlock.assign(workerStage.partitionSize, 0.0);
+		workerStage.silentBlock.assign(workerStage.partitionSize, 0.0);
+	}
+
+	samplePosition = 0;
+	lateBlocks = 0;
+	memset(headHistory, 0, sizeof(headHistory));
+	historyIndex = 0;
+	clearWorkerBlocks();
+
+	return true;
+}
+
+void PartitionedConvolver::reset()
+{
+	std::lock_guard<std::mutex> lock(serviceMutex);
+
+	samplePosition = 0;
+	lateBlocks = 0;
+	memset(headHistory, 0, sizeof(headHistory));
+	historyIndex = 0;
+
+	if (audioStageActive)
+	{
+		audioStage.clear();
+		std::fill(audioStageInput.begin(), audioStageInput.end(), 0.0);
+		std::fill(audioStageOutput.begin(), audioStageOutput.end(), 0.0);
+	}
+
+	clearWorkerBlocks();
+	for (uint32_t s = 0; s < kNumConvolverStages - 1; s++)
+	{
+		WorkerStage& workerStage = workerStages[s];
+		if (!workerStage.active)
+			continue;
+
+		workerStage.stage.clear();
+		std::fill(workerStage.inputBlock.begin(), workerStage.inputBlock.end(), 0.0);
+	}
+}
+
+void PartitionedConvolver::enableWorkerThread(bool enable)
+{
+	std::lock_guard<std::mutex> lock(serviceMutex);
+
+	// --- the calling thread takes over in step: finish what the worker was given first
+	if (!enable)
+		processSubmittedBlocks();
+
+	useWorkerThread = enable;
+}
+
+void PartitionedConvolver::processAudioBlock(const double* input, double* output, uint32_t blockSize)
+{
+	if (impulseLength == 0)
+	{
+		memset(output, 0, blockSize * sizeof(double));
+		return;
+	}
+
+	uint32_t i = 0;
+	while (i < blockSize)
+	{
+		// --- run up to the next audio partition boundary
+		uint32_t position = (uint32_t)(samplePosition & (kConvolverHeadLength - 1));
+		uint32_t count = std::min(blockSize - i, kConvolverHeadLength - position);
+
+		for (uint32_t j = 0; j < count; j++)
+		{
+			double xn = input[i + j];
+
+			// --- direct FIR head
+			historyIndex = historyIndex == 0 ? kConvolverHeadLength - 1 : historyIndex - 1;
+			headHistory[historyIndex] = xn;
+			headHistory[historyIndex + kConvolverHeadLength] = xn;
+
+			const double* window = &headHistory[historyIndex];
+			double yn = 0.0;
+			for (uint32_t k = 0; k < kConvolverHeadLength; k++)
+				yn += headIR[k] * window[k];
+
+			// --- stage outputs were computed at the last boundary
+			if (audioStageActive)
+			{
+				audioStageInput[position + j] = xn;
+				yn += audioStageOutput[position + j];
+			}
+
+			for (uint32_t s = 0; s < kNumConvolverStages - 1; s++)
+			{
+				WorkerStage& workerStage = workerStages[s];
+				if (!workerStage.active)
+					continue;
+
+				uint32_t stagePosition = (uint32_t)((samplePosition + j) & (workerStage.partitionSize - 1));
+				workerStage.inputBlock[stagePosition] = xn;
+				if (workerStage.readBlock)
+					yn += workerStage.readBlock[stagePosition];
+			}
+
+			output[i + j] = yn;
+		}
+
+		i += count;
+		samplePosition += count;
+
+		if ((samplePosition & (kConvolverHeadLength - 1)) == 0)
+			startPartitions();
+	}
+}
+
+void PartitionedConvolver::startPartitions()
+{
+	// --- stage 0 starts one partition in: this block's output is due now
+	if (audioStageActive)
+		audioStage.processPartition(&audioStageInput[0], &audioStageOutput[0]);
+
+	for (uint32_t s = 0; s < kNumConvolverStages - 1; s++)
+	{
+		WorkerStage& workerStage = workerStages[s];
+		if (!workerStage.active || (samplePosition & (workerStage.partitionSize - 1)) != 0)
+			continue;
+
+		// --- hand off the block that just filled, unless the worker has yet to finish the block
+		//     a whole ring back that is still in its slot; then this one is dropped
+		uint64_t block = samplePosition / workerStage.partitionSize - 1;
+		uint32_t slot = (uint32_t)(block % kConvolverWorkerSlots);
+		if (block < kConvolverWorkerSlots || workerStage.completedBlocks.load(std::memory_order_acquire) > block - kConvolverWorkerSlots)
+		{
+			std::copy(workerStage.inputBlock.begin(), workerStage.inputBlock.end(), workerStage.inputRing.begin() + slot * workerStage.partitionSize);
+			workerStage.inputSlotBlocks[slot].store(block, std::memory_order_release);
+		}
+		else
+			lateBlocks++;
+
+		if (useWorkerThread)
+		{
+			workerStage.submittedBlocks.store(block + 1, std::memory_order_release);
+			if (workerWakeup)
+				workerWakeup->signal();
+		}
+		else
+		{
+			processWorkerBlock(workerStage, block);
+			workerStage.submittedBlocks.store(block + 1, std::memory_order_relaxed);
+			workerStage.completedBlocks.store(block + 1, std::memory_order_relaxed);
+		}
+
+		// --- the block starting now plays stage output from delayBlocks blocks ago
+		workerStage.readBlock = nullptr;
+		uint64_t nextBlock = block + 1;
+		if (nextBlock < workerStage.delayBlocks)
+			continue;
+
+		uint64_t stageBlock = nextBlock - workerStage.delayBlocks;
+		if (workerStage.completedBlocks.load(std::memory_order_acquire) > stageBlock)
+			workerStage.readBlock = &workerStage.outputRing[(stageBlock % kConvolverWorkerSlots) * workerStage.partitionSize];
+		else
+			lateBlocks++;
+	}
+}
+
+void PartitionedConvolver::processWorkerBlock(WorkerStage& workerStage, uint64_t block)
+{
+	// --- a dropped block goes through as silence so the delay line stays in step
+	uint32_t slot = (uint32_t)(block % kConvolverWorkerSlots);
+	uint32_t offset = slot * workerStage.partitionSize;
+	const double* input = &workerStage.inputRing[offset];
+	if (workerStage.inputSlotBlocks[slot].load(std::memory_order_acquire) != block)
+		input = &workerStage.silentBlock[0];
+
+	workerStage.stage.processPartition(input, &workerStage.outputRing[offset]);
+}
+
+bool PartitionedConvolver::service()
+{
+	std::lock_guard<std::mutex> lock(serviceMutex);
+	if (!useWorkerThread)
+		return false;
+
+	return processSubmittedBlocks();
+}
+
+bool PartitionedConvolver::processSubmittedBlocks()
+{
+	bool didWork = false;
+	for (uint32_t s = 0; s < kNumConvolverStages - 1; s++)
+	{
+		WorkerStage& workerStage = workerStages[s];
+		if (!workerStage.active)
+			continue;
+
+		// --- every block is computed, even one whose output is already past due, so the
+		//     stage's delay line holds the right input for the blocks after it
+		uint64_t completed = workerStage.completedBlocks.load(std::memory_order_relaxed);
+		uint64_t submitted = workerStage.submittedBlocks.load(std::memory_order_acquire);
+		while (completed < submitted)
+		{
+			processWorkerBlock(workerStage, completed);
+
+			completed++;
+			workerStage.completedBlocks.store(completed, std::memory_order_release);
+			didWork = true;
+
+			submitted = workerStage.submittedBlocks.load(std::memory_order_acquire);
+		}
+	}
+
+	return didWork;
+}
+
+// --- ConvolutionWorker --------------------------------------------------------------------
+ConvolutionWorker::ConvolutionWorker()
+	: stopWorker(false)
+{
+}
+
+ConvolutionWorker::~ConvolutionWorker()
+{
+	stopWorker.store(true);
+	workerWakeup.signal();
+
+	if (workerThread.joinable())
+		workerThread.join();
+}
+
+std::shared_ptr<PartitionedConvolver> ConvolutionWorker::createConvolver()
+{
+	std::shared_ptr<PartitionedConvolver> convolver = std::make_shared<PartitionedConvolver>(&workerWakeup);
+
+	// --- the thread starts with the first convolver, so unused workers cost nothing
+	if (!workerThread.joinable())
+		workerThread = std::thread(&ConvolutionWorker::convolveTails, this);
+
+	std::lock_guard<std::mutex> lock(convolversMutex);
+	convolvers.push_back(convolver);
+
+	return convolver;
+}
+
+void ConvolutionWorker::removeConvolver(const std::shared_ptr<PartitionedConvolver>& convolver)
+{
+	std::lock_guard<std::mutex> lock(convolversMutex);
+	convolvers.erase(std::remove(convolvers.begin(), convolvers.end(), convolver), convolvers.end());
+}
+
+void ConvolutionWorker::convolveTails()
+{
+	while (!stopWorker.load())
+	{
+		// --- woken at every tail partition boundary; the timeout is only a safety net
+		workerWakeup.wait(20000);
+
+		std::lock_guard<std::mutex> lock(convolversMutex);
+		for (auto& convolver : convolvers)
+		{
+			if (stopWorker.load())
+				break;
+			convolver->service();
+		}
+	}
+}
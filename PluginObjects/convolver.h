@@ -0,0 +1,198 @@
+#ifndef __convolver_h__
+#define __convolver_h__
+
+// --- includes
+#include "synthdefs.h"
+#include "readerwriterqueue.h"
+#include "radix2fft.h"
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+
+// --- partition layout: the first kConvolverHeadLength taps are a direct FIR, then each stage
+//     covers [kConvolverStageStart[s], kConvolverStageStart[s + 1]) of the IR with FFT blocks of
+//     kConvolverPartitionSize[s]; the last stage runs to the end of the IR
+//
+//     stage 0 starts one partition in, so it is computed on the audio thread right when its
+//     output is due; the later stages start two partitions in, which gives the worker thread one
+//     whole partition of time for each block
+const uint32_t kConvolverHeadLength = 64;
+const uint32_t kNumConvolverStages = 3;
+const uint32_t kConvolverPartitionSize[kNumConvolverStages] = { 64, 1024, 8192 };
+const uint32_t kConvolverStageStart[kNumConvolverStages] = { 64, 2048, 16384 };
+
+// --- output blocks in flight per worker stage
+const uint32_t kConvolverWorkerSlots = 4;
+
+/**
+\class ConvolverStage
+\ingroup SynthClasses
+\brief One uniformly partitioned section of the impulse response, done with overlap-save: each
+input block is transformed once into a frequency-domain delay line and multiplied against every
+partition's spectrum. Only the non-negative bins are stored and multiplied.
+*/
+class ConvolverStage
+{
+public:
+	ConvolverStage() {}
+	~ConvolverStage() {}
+
+	// --- allocates; ir points at the first tap of this section
+	void initialize(uint32_t _partitionSize, const double* ir, uint32_t irLength);
+	void clear();
+
+	// --- one partitionSize block in, the matching partitionSize block of output
+	void processPartition(const double* input, double* output);
+
+	uint32_t getPartitionSize() { return partitionSize; }
+	uint32_t getNumPartitions() { return numPartitions; }
+
+protected:
+	uint32_t partitionSize = 0;
+	uint32_t numBins = 0;			///< partitionSize + 1
+	uint32_t numPartitions = 0;
+	Radix2FFT fft;
+
+	// --- IR spectra, numPartitions x numBins
+	std::vector<double> irReal;
+	std::vector<double> irImag;
+
+	// --- frequency-domain delay line, newest at fdlIndex
+	std::vector<double> fdlReal;
+	std::vector<double> fdlImag;
+	uint32_t fdlIndex = 0;
+
+	// --- scratch
+	std::vector<double> inputWindow;	///< previous block followed by the current block
+	std::vector<double> fftReal;
+	std::vector<double> fftImag;
+	std::vector<double> accumReal;
+	std::vector<double> accumImag;
+};
+
+/**
+\class PartitionedConvolver
+\ingroup SynthClasses
+\brief Zero-latency mono convolver for long impulse responses with non-uniform partitions.
+
+The head of the IR is a direct FIR and the first FFT stage runs on the audio thread at
+partition boundaries; the longer stages are handed to a ConvolutionWorker. Input blocks go
+out and output blocks come back through fixed rings guarded by two atomic block counters, so
+the audio thread never waits, locks or allocates. A tail block that is not ready when its
+output is due is skipped (silent) and counted in getLateBlocks( ). If the worker falls a whole
+ring behind, the audio thread drops the new input block rather than overwrite one the worker has
+yet to read; the worker convolves silence in its place, which keeps the later blocks in step.
+
+With the worker disabled (e.g. offline rendering, which runs faster than real time) the tail
+stages are computed on the calling thread instead; the output is the same either way.
+
+setImpulseResponse( ) and reset( ) allocate and must not be called while the audio thread
+is processing.
+*/
+class PartitionedConvolver
+{
+public:
+	PartitionedConvolver(moodycamel::spsc_sema::LightweightSemaphore* _workerWakeup);
+	~PartitionedConvolver() {}
+
+	// --- non-realtime
+	bool setImpulseResponse(const double* ir, uint32_t irLength);
+	void reset();
+	void enableWorkerThread(bool enable);
+
+	// --- audio thread; input and output may be the same buffer
+	void processAudioBlock(const double* input, double* output, uint32_t blockSize);
+
+	// --- worker thread: compute any submitted tail blocks; returns true if it did work
+	bool service();
+
+	bool hasImpulseResponse() { return impulseLength > 0; }
+	uint64_t getLateBlocks() { return lateBlocks; }
+
+protected:
+	uint32_t impulseLength = 0;
+	bool useWorkerThread = true;
+
+	// --- audio thread: samples since reset, all partition boundaries are multiples of this
+	uint64_t samplePosition = 0;
+	uint64_t lateBlocks = 0;
+
+	// --- direct FIR head; mirrored history, newest first at history[historyIndex]
+	double headIR[kConvolverHeadLength] = { 0.0 };
+	double headHistory[2 * kConvolverHeadLength] = { 0.0 };
+	uint32_t historyIndex = 0;
+
+	// --- stage 0 on the audio thread
+	ConvolverStage audioStage;
+	bool audioStageActive = false;
+	std::vector<double> audioStageInput;
+	std::vector<double> audioStageOutput;
+
+	// --- later stages, normally on the worker thread
+	struct WorkerStage
+	{
+		ConvolverStage stage;
+		bool active = false;
+		uint32_t partitionSize = 0;
+		uint32_t delayBlocks = 0;			///< stage start / partitionSize
+
+		// --- rings, kConvolverWorkerSlots x partitionSize; each input slot is tagged with the
+		//     block written into it
+		std::vector<double> inputRing;
+		std::vector<double> outputRing;
+		std::atomic<uint64_t> inputSlotBlocks[kConvolverWorkerSlots];
+		std::vector<double> silentBlock;
+
+		// --- block counters: submitted by the audio thread, completed by the worker
+		std::atomic<uint64_t> submittedBlocks;
+		std::atomic<uint64_t> completedBlocks;
+
+		// --- audio thread only
+		std::vector<double> inputBlock;
+		const double* readBlock = nullptr;	///< output block being played, or nullptr
+	};
+	WorkerStage workerStages[kNumConvolverStages - 1];
+
+	// --- serializes service( ) against setImpulseResponse( ) and reset( ); never taken by the audio thread
+	std::mutex serviceMutex;
+	moodycamel::spsc_sema::LightweightSemaphore* workerWakeup = nullptr;
+
+	void processWorkerBlock(WorkerStage& workerStage, uint64_t block);
+	void startPartitions();
+
+	// --- compute every submitted tail block; serviceMutex must be held
+	bool processSubmittedBlocks();
+	void clearWorkerBlocks();
+};
+
+/**
+\class ConvolutionWorker
+\ingroup SynthClasses
+\brief Owns the background thread that computes the long partitions of its convolvers.
+Convolvers are created and removed on non-realtime threads; the thread is started by the
+first createConvolver( ).
+*/
+class ConvolutionWorker
+{
+public:
+	ConvolutionWorker();
+	~ConvolutionWorker();
+
+	// --- register a new convolver with the worker thread
+	std::shared_ptr<PartitionedConvolver> createConvolver();
+	void removeConvolver(const std::shared_ptr<PartitionedConvolver>& convolver);
+
+private:
+	std::thread workerThread;
+	std::atomic<bool> stopWorker;
+	moodycamel::spsc_sema::LightweightSemaphore workerWakeup;
+
+	// --- the audio thread never takes this
+	std::mutex convolversMutex;
+	std::vector<std::shared_ptr<PartitionedConvolver>> convolvers;
+
+	void convolveTails();
+};
+
+#endif /* defined(__convolver_h__) */
@@ -63,7 +63,7 @@ bool DCA::update(bool updateAllModRoutings)
 	if (parameters->mute) gainRaw = 0.0;
 
 	// --- now process pan modifiers
-	double panTotal = panValue +modulators->modulationInputs[kBipolarMod];
+	double panTotal = parameters->panValue + panValue + modulators->modulationInputs[kBipolarMod];
 
 	// --- limit in case pan control is biased
 	boundValue(panTotal, -1.0, 1.0);
@@ -136,6 +136,7 @@ bool EnvelopeGenerator::restart()
 	holdTimer.resetTimer();
 	offTimer.resetTimer();
 	delayTimer.resetTimer();
+	segmentDirty = true;
 
 	return true;
 }
@@ -163,6 +164,8 @@ bool EnvelopeGenerator::doNoteOff(double midiPitch, uint32_t midiNoteNumber, uin
 			state = egState::kRelease;
 		else // sustain was already at zero
 			state = egState::kOff;
+
+		segmentDirty = true;
 	}
 	return true; // handled
 }
@@ -213,6 +216,9 @@ bool EnvelopeGenerator::update(bool updateAllModRoutings)
 	// --- update MIDI stuff
 	setSustainOverride(midiInputData->ccMIDIData[SUSTAIN_PEDAL] > 63);
 
+	// --- timer targets may have moved
+	segmentDirty = true;
+
 	return true;
 }
 
@@ -231,6 +237,7 @@ bool EnvelopeGenerator::shutdown()
 
 	// --- set state and reset counter
 	state = egState::kShutdown;
+	segmentDirty = true;
 
 	// --- for sustain pedal
 	sustainOverride = false;
@@ -256,6 +263,9 @@ void EnvelopeGenerator::calculateAttackTime(double attackTime, double attackTime
 	// --- coeff and base for iterative exponential calculation
 	attackCoeff = exp(-log((1.0 + attackTCO) / attackTCO) / samples);
 	attackOffset = (1.0 + attackTCO)*(1.0 - attackCoeff);
+
+	// --- the current segment may have changed length
+	segmentDirty = true;
 }
 
 /**
@@ -275,6 +285,9 @@ void EnvelopeGenerator::calculateDecayTime(double decayTime, double decayTimeSca
 	// --- coeff and base for iterative exponential calculation
 	decayCoeff = exp(-log((1.0 + decayTCO) / decayTCO) / samples);
 	decayOffset = (sustainLevel - decayTCO)*(1.0 - decayCoeff);
+
+	// --- the current segment may have changed length
+	segmentDirty = true;
 }
 
 /**
@@ -294,16 +307,17 @@ void EnvelopeGenerator::calculateReleaseTime(double releaseTime, double releaseT
 	// --- coeff and base for iterative exponential calculation
 	releaseCoeff = exp(-log((1.0 + releaseTCO) / releaseTCO) / samples);
 	releaseOffset = -releaseTCO*(1.0 - releaseCoeff);
+
+	// --- the current segment may have changed length
+	segmentDirty = true;
 }
 
 /**
 \brief Run the EG through one cycle of the finite state machine.
-\return true if handled, false if not handled
+\return the new envelope output
 */
-const ModOutputData EnvelopeGenerator::renderModulatorOutput()
+double EnvelopeGenerator::renderStateMachine()
 {
-	ModOutputData egOutput;
-
 	// --- decode the state
 	switch (state)
 	{
@@ -464,10 +478,216 @@ const ModOutputData EnvelopeGenerator::renderModulatorOutput()
 		}
 	}
 
+	return envelopeOutput;
+}
+
+// --- samples an exponential segment y(n) = offset + y(n-1)*coeff can run before crossing
+//     boundary, approaching from the side of y0; two samples short so rounding in the log
+//     can never carry the recursion past the boundary without the state machine seeing it
+static uint32_t samplesToBoundary(double y0, double offset, double coeff, double boundary)
+{
+	if (coeff <= 0.0 || coeff >= 1.0)
+		return 0;
+
+	// --- y(n) = target + (y0 - target)*coeff^n
+	double target = offset / (1.0 - coeff);
+	double ratio = (boundary - target) / (y0 - target);
+	if (ratio <= 0.0 || ratio >= 1.0)
+		return 0;
+
+	double samples = log(ratio) / log(coeff) - 2.0;
+	if (samples <= 0.0)
+		return 0;
+
+	return samples >= (double)kMaxEGSegmentSamples ? kMaxEGSegmentSamples : (uint32_t)samples;
+}
+
+/**
+\brief Find how many samples the current state can render before any transition check could fire
+\return the number of samples; 0 means the next sample must go through the state machine
+*/
+uint32_t EnvelopeGenerator::calculateSegmentLength()
+{
+	switch (state)
+	{
+		case egState::kOff:
+			return offTime_mSec != 0.0 ? 0 : kMaxEGSegmentSamples;
+
+		case egState::kDelay:
+			return delayTime_mSec == 0.0 ? 0 : delayTimer.getSamplesRemaining();
+
+		case egState::kAttack:
+			if (attackTime_mSec <= 0.0 || envelopeOutput >= 1.0)
+				return 0;
+			return samplesToBoundary(envelopeOutput, attackOffset, attackCoeff, 1.0);
+
+		case egState::kDecay:
+			if (decayTime_mSec <= 0.0 || envelopeOutput <= sustainLevel)
+				return 0;
+			return samplesToBoundary(envelopeOutput, decayOffset, decayCoeff, sustainLevel);
+
+		case egState::kHoldOn:
+			return holdTime_mSec == 0.0 ? 0 : holdTimer.getSamplesRemaining();
+
+		case egState::kSustain:
+			return kMaxEGSegmentSamples;
+
+		case egState::kRelease:
+			if (sustainOverride)
+				return kMaxEGSegmentSamples;
+			if (releaseTime_mSec <= 0.0 || envelopeOutput <= 0.0)
+				return 0;
+			return samplesToBoundary(envelopeOutput, releaseOffset, releaseCoeff, 0.0);
+
+		case egState::kShutdown:
+		{
+			if (incShutdown >= 0.0 || envelopeOutput <= 0.0)
+				return 0;
+
+			double samples = envelopeOutput / -incShutdown - 2.0;
+			if (samples <= 0.0)
+				return 0;
+			return samples >= (double)kMaxEGSegmentSamples ? kMaxEGSegmentSamples : (uint32_t)samples;
+		}
+
+		case egState::kHoldOff:
+			return offTime_mSec == 0.0 ? 0 : offTimer.getSamplesRemaining();
+	}
+
+	return 0;
+}
+
+/**
+\brief Render count samples of the current state; calculateSegmentLength() guarantees that
+none of them would have caused a transition, so this is the same arithmetic as the state machine
+without the checks
+*/
+void EnvelopeGenerator::renderSegment(double* buffer, uint32_t count)
+{
+	double output = envelopeOutput;
+
+	switch (state)
+	{
+		case egState::kAttack:
+		{
+			const double offset = attackOffset;
+			const double coeff = attackCoeff;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				output = offset + output*coeff;
+				buffer[i] = output;
+			}
+			envelopeOutput = output;
+			return;
+		}
+		case egState::kDecay:
+		{
+			const double offset = decayOffset;
+			const double coeff = decayCoeff;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				output = offset + output*coeff;
+				buffer[i] = output;
+			}
+			envelopeOutput = output;
+			return;
+		}
+		case egState::kRelease:
+		{
+			// --- held by the sustain pedal
+			if (sustainOverride)
+				break;
+
+			const double offset = releaseOffset;
+			const double coeff = releaseCoeff;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				output = offset + output*coeff;
+				buffer[i] = output;
+			}
+			envelopeOutput = output;
+			return;
+		}
+		case egState::kShutdown:
+		{
+			const double inc = incShutdown;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				output += inc;
+				buffer[i] = output;
+			}
+			envelopeOutput = output;
+			return;
+		}
+
+		// --- the rest hold their output
+		case egState::kOff:
+		{
+			if (!outputEG || parameters->resetToZero)
+				envelopeOutput = 0.0;
+			break;
+		}
+		case egState::kDelay:
+			delayTimer.advanceTimer(count);
+			break;
+		case egState::kHoldOn:
+			holdTimer.advanceTimer(count);
+			break;
+		case egState::kHoldOff:
+			offTimer.advanceTimer(count);
+			break;
+		case egState::kSustain:
+			envelopeOutput = sustainLevel;
+			break;
+	}
+
+	for (uint32_t i = 0; i < count; i++)
+		buffer[i] = envelopeOutput;
+}
+
+void EnvelopeGenerator::renderEnvelopeBlock(double* buffer, uint32_t blockSize)
+{
+	uint32_t i = 0;
+	while (i < blockSize)
+	{
+		if (segmentDirty)
+		{
+			segmentSamplesLeft = calculateSegmentLength();
+			segmentDirty = false;
+		}
+
+		// --- at a boundary: one checked sample, then find the next run
+		if (segmentSamplesLeft == 0)
+		{
+			buffer[i++] = renderStateMachine();
+			segmentDirty = true;
+			continue;
+		}
+
+		uint32_t count = blockSize - i < segmentSamplesLeft ? blockSize - i : segmentSamplesLeft;
+		renderSegment(&buffer[i], count);
+
+		segmentSamplesLeft -= count;
+		i += count;
+	}
+}
+
+/**
+\brief Render one sample; goes through renderEnvelopeBlock() so the per-sample path also skips
+the state machine inside a segment
+\return the EG outputs
+*/
+const ModOutputData EnvelopeGenerator::renderModulatorOutput()
+{
+	ModOutputData egOutput;
+
+	double output = 0.0;
+	renderEnvelopeBlock(&output, 1);
+
 	// --- load up the output struct
 	egOutput.modOutputCount = 2;
-	egOutput.modulationOutputs[kEGNormalOutput] = envelopeOutput;
-	egOutput.modulationOutputs[kEGBiasedOutput] = envelopeOutput - sustainLevel;
+	egOutput.modulationOutputs[kEGNormalOutput] = output;
+	egOutput.modulationOutputs[kEGBiasedOutput] = output - sustainLevel;
 
 	return egOutput;
 }
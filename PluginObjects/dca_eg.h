@@ -141,6 +141,10 @@ enum class egTCMode { kAnalog, kDigital };
 enum class egState { kOff, kDelay, kAttack, kDecay, kSustain, kRelease, kShutdown, kHoldOn, kHoldOff };
 enum class egType { kADSR, kAHDSR, kAHR, kAHR_RT };
 
+// --- longest run EnvelopeGenerator renders without looking at the state machine; sustain and
+//     other open-ended states are re-checked this often
+const uint32_t kMaxEGSegmentSamples = 65536;
+
 /**
 \struct EGParameters
 \ingroup SynthStructures
@@ -240,6 +244,7 @@ public:
 		state = egState::kOff;
 		holdTimer.resetTimer();
 		offTimer.resetTimer();
+		segmentDirty = true;
 
 		return true;
 	}
@@ -252,6 +257,10 @@ public:
 
 	virtual const ModOutputData renderModulatorOutput();
 
+	// --- renders blockSize samples of the normal output; the state machine only runs at
+	//     segment boundaries, the samples in between are a tight recursion loop
+	void renderEnvelopeBlock(double* buffer, uint32_t blockSize);
+
 	// --- accessors - allow owner to get our state
 	egState getState() { return state; }			///< returns current state of the EG finite state machine
 
@@ -304,9 +313,19 @@ protected:
 	void calculateDecayTime(double decayTime, double decayTimeScalar = 1.0);
 	void calculateReleaseTime(double releaseTime, double releaseTimeScalar = 1.0);
 
+	// --- one sample through the finite state machine, with all transition checks
+	double renderStateMachine();
+
+	// --- samples the current segment can render with no transition check
+	uint32_t calculateSegmentLength();
+	void renderSegment(double* buffer, uint32_t count);
+
 	/// set the sustain pedal override to keep the EG stuck in the sustain state until the pedal is released
 	void setSustainOverride(bool b)
 	{
+		if (b != sustainOverride)
+			segmentDirty = true;
+
 		sustainOverride = b;
 
 		if (releasePending && !sustainOverride)
@@ -355,6 +374,10 @@ protected:
 	// --- stage variable
 	egState state = egState::kOff;		///< EG state variable
 
+	// --- segment rendering; segmentDirty forces a new length after any state or coefficient change
+	uint32_t segmentSamplesLeft = 0;	///< samples left before the state machine must run again
+	bool segmentDirty = true;
+
 	// --- analog/digital mode
 	egTCMode egMode = egTCMode::kAnalog; ///< analog or digital (linear in dB)
 
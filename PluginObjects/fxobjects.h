@@ -3791,6 +3791,23 @@ public:
 		return yn;
 	}
 
+	/** process a block of samples; input and output may be the same buffer */
+	/**
+	\param input input samples
+	\param output output samples
+	\param blockSize number of samples
+	*/
+	void processAudioBlock(const double* input, double* output, uint32_t blockSize)
+	{
+		double g = simpleLPFParameters.g;
+		double oneMinusG = 1.0 - g;
+		for (uint32_t i = 0; i < blockSize; i++)
+		{
+			state = oneMinusG*input[i] + g*state;
+			output[i] = state;
+		}
+	}
+
 	/** return false: this object only processes samples */
 	virtual bool canProcessAudioFrame() { return false; }
 
@@ -3914,6 +3931,40 @@ public:
 		return yn;
 	}
 
+	/** process a block of samples; input and output may be the same buffer */
+	/**
+	\param input input samples
+	\param output output samples
+	\param blockSize number of samples
+	*/
+	void processAudioBlock(const double* input, double* output, uint32_t blockSize)
+	{
+		// --- zero delay is a pass-through, as in processAudioSample( )
+		if (simpleDelayParameters.delay_Samples == 0)
+		{
+			if (output != input)
+				memcpy(output, input, blockSize * sizeof(double));
+			return;
+		}
+
+		// --- fractional reads go through the interpolating path
+		if (simpleDelayParameters.interpolate)
+		{
+			for (uint32_t i = 0; i < blockSize; i++)
+				output[i] = SimpleDelay::processAudioSample(input[i]);
+			return;
+		}
+
+		// --- integer delay, resolved once for the block
+		int delayInSamples = (int)simpleDelayParameters.delay_Samples;
+		for (uint32_t i = 0; i < blockSize; i++)
+		{
+			double yn = delayBuffer.readBuffer(delayInSamples);
+			delayBuffer.writeBuffer(input[i]);
+			output[i] = yn;
+		}
+	}
+
 	/** reset members to initialized state */
 	virtual bool canProcessAudioFrame() { return false; }
 
@@ -3956,6 +4007,13 @@ public:
 		return delayBuffer.readBuffer((delayPercent / 100.0)*simpleDelayParameters.delay_Samples);
 	}
 
+	/** read delay at an integer number of samples behind the last write */
+	double readDelayAtSamples(int delayInSamples)
+	{
+		// --- simple read
+		return delayBuffer.readBuffer(delayInSamples);
+	}
+
 	/** write a new value into the delay */
 	void writeDelay(double xn)
 	{
@@ -4079,6 +4137,18 @@ public:
 		return yn;
 	}
 
+	/** process a block of samples; input and output may be the same buffer */
+	/**
+	\param input input samples
+	\param output output samples
+	\param blockSize number of samples
+	*/
+	void processAudioBlock(const double* input, double* output, uint32_t blockSize)
+	{
+		for (uint32_t i = 0; i < blockSize; i++)
+			output[i] = CombFilter::processAudioSample(input[i]);
+	}
+
 	/** return false: this object only processes samples */
 	virtual bool canProcessAudioFrame() { return false; }
 
@@ -4281,6 +4351,18 @@ public:
 		return yn;
 	}
 
+	/** process a block of samples; input and output may be the same buffer */
+	/**
+	\param input input samples
+	\param output output samples
+	\param blockSize number of samples
+	*/
+	void processAudioBlock(const double* input, double* output, uint32_t blockSize)
+	{
+		for (uint32_t i = 0; i < blockSize; i++)
+			output[i] = DelayAPF::processAudioSample(input[i]);
+	}
+
 	/** return false: this object only processes samples */
 	virtual bool canProcessAudioFrame() { return false; }
 
@@ -4469,7 +4551,7 @@ public:
 		double wn = xn + apf_g*wnD;
 
 		// --- process wn through inner APF
-		double ynInner = nestedAPF.processAudioSample(wn);
+		double ynInner = nestedAPF.DelayAPF::processAudioSample(wn);
 
 		// --- form y(n) = -gw(n) + w(n-D)
 		double yn = -apf_g*wn + wnD;
@@ -4483,6 +4565,18 @@ public:
 		return yn;
 	}
 
+	/** process a block of samples; input and output may be the same buffer */
+	/**
+	\param input input samples
+	\param output output samples
+	\param blockSize number of samples
+	*/
+	void processAudioBlock(const double* input, double* output, uint32_t blockSize)
+	{
+		for (uint32_t i = 0; i < blockSize; i++)
+			output[i] = NestedDelayAPF::processAudioSample(input[i]);
+	}
+
 	/** get parameters: note use of custom structure for passing param data */
 	/**
 	\return BiquadParameters custom data structure
@@ -4743,6 +4837,8 @@ struct ReverbTankParameters
 // --- constants for reverb tank
 const unsigned int NUM_BRANCHES = 4;
 const unsigned int NUM_CHANNELS = 2; // stereo
+const unsigned int NUM_TANK_TAPS = 4; // output taps per branch: left, right, thick-left, thick-right
+const unsigned int REVERB_BLOCK_SIZE = 64; // max samples per pass in processAudioBlock( )
 
 /**
 \class ReverbTank
@@ -4883,9 +4979,9 @@ public:
 		double tankOutL = shelvingFilters[0].processAudioSample(outL);
 		double tankOutR = shelvingFilters[1].processAudioSample(outR);
 
-		// --- sum with dry
-		double dry = pow(10.0, parameters.dryLevel_dB / 20.0);
-		double wet = pow(10.0, parameters.wetLevel_dB / 20.0);
+		// --- sum with dry; gains are converted in setParameters( )
+		double dry = dryGain;
+		double wet = wetGain;
 
 		if (outputChannels == 1)
 			outputFrame[0] = dry*xnL + wet*(0.5*tankOutL + 0.5*tankOutR);
@@ -4898,6 +4994,98 @@ public:
 		return true;
 	}
 
+	/** process stereo reverb tank over a block, in place */
+	/**
+	The tank's global feedback is read from the last branch delay, so any run of samples no longer
+	than that delay can be pushed through each branch in turn instead of one sample at a time.
+	Output is identical to calling processAudioFrame( ) per sample with stereo in and out.
+
+	\param left left channel input/output
+	\param right right channel input/output
+	\param blockSize number of samples
+	*/
+	void processAudioBlock(double* left, double* right, uint32_t blockSize)
+	{
+		double weight = 0.707;
+		uint32_t lastBranchDelay = (uint32_t)branchDelays[NUM_BRANCHES - 1].getParameters().delay_Samples;
+
+		uint32_t runLength = 0;
+		for (uint32_t offset = 0; offset < blockSize; offset += runLength)
+		{
+			runLength = blockSize - offset;
+			if (runLength > tankBlockLimit)
+				runLength = tankBlockLimit;
+
+			double* xnL = &left[offset];
+			double* xnR = &right[offset];
+
+			// --- global feedback for the whole run, already in the last branch's delay line
+			for (uint32_t i = 0; i < runLength; i++)
+				tankInput[i] = parameters.kRT*branchDelays[NUM_BRANCHES - 1].readDelayAtSamples(lastBranchDelay - i);
+
+			// --- mono-ized input through the pre delay
+			for (uint32_t i = 0; i < runLength; i++)
+				preDelayOutput[i] = 0.5*xnL[i] + 0.5*xnR[i];
+			preDelay.processAudioBlock(preDelayOutput, preDelayOutput, runLength);
+
+			// --- branches in series, each over the whole run
+			for (uint32_t i = 0; i < runLength; i++)
+				tankInput[i] = preDelayOutput[i] + tankInput[i];
+
+			for (uint32_t branch = 0; branch < NUM_BRANCHES; branch++)
+			{
+				branchNestedAPFs[branch].processAudioBlock(tankInput, tankInput, runLength);
+				branchLPFs[branch].processAudioBlock(tankInput, tankInput, runLength);
+				branchDelays[branch].processAudioBlock(tankInput, tankInput, runLength);
+
+				for (uint32_t i = 0; i < runLength; i++)
+					tankInput[i] = parameters.kRT*tankInput[i] + preDelayOutput[i];
+
+				// --- the output taps as they were after each sample was written
+				for (uint32_t tap = 0; tap < NUM_TANK_TAPS; tap++)
+				{
+					for (uint32_t i = 0; i < runLength; i++)
+						tapOutputs[branch][tap][i] = branchDelays[branch].readDelayAtSamples(tapDelays[branch][tap] + (runLength - 1 - i));
+				}
+			}
+
+			// --- gather outputs, filter and mix
+			for (uint32_t i = 0; i < runLength; i++)
+			{
+				double outL = 0.0;
+				outL += weight*tapOutputs[0][0][i];
+				outL -= weight*tapOutputs[1][0][i];
+				outL += weight*tapOutputs[2][0][i];
+				outL -= weight*tapOutputs[3][0][i];
+
+				double outR = 0.0;
+				outR -= weight*tapOutputs[0][1][i];
+				outR += weight*tapOutputs[1][1][i];
+				outR -= weight*tapOutputs[2][1][i];
+				outR += weight*tapOutputs[3][1][i];
+
+				if (parameters.density == reverbDensity::kThick)
+				{
+					outL += weight*tapOutputs[0][2][i];
+					outL -= weight*tapOutputs[1][2][i];
+					outL += weight*tapOutputs[2][2][i];
+					outL -= weight*tapOutputs[3][2][i];
+
+					outR -= weight*tapOutputs[0][3][i];
+					outR += weight*tapOutputs[1][3][i];
+					outR -= weight*tapOutputs[2][3][i];
+					outR += weight*tapOutputs[3][3][i];
+				}
+
+				double tankOutL = shelvingFilters[0].processAudioSample(outL);
+				double tankOutR = shelvingFilters[1].processAudioSample(outR);
+
+				xnL[i] = dryGain*xnL[i] + wetGain*tankOutL;
+				xnR[i] = dryGain*xnR[i] + wetGain*tankOutR;
+			}
+		}
+	}
+
 	/** get parameters: note use of custom structure for passing param data */
 	/**
 	\return ReverbTankParameters custom data structure
@@ -4974,6 +5162,28 @@ public:
 
 		// --- save our copy
 		parameters = params;
+
+		// --- output gains
+		dryGain = pow(10.0, parameters.dryLevel_dB / 20.0);
+		wetGain = pow(10.0, parameters.wetLevel_dB / 20.0);
+
+		// --- block processing: output taps in whole samples, and the longest run that keeps
+		//     the global feedback ahead of the last branch; a zero-length branch delay stops
+		//     writing its buffer, so fall back to single samples
+		tankBlockLimit = REVERB_BLOCK_SIZE;
+		for (uint32_t i = 0; i < NUM_BRANCHES; i++)
+		{
+			double branchDelay = branchDelays[i].getParameters().delay_Samples;
+			for (uint32_t tap = 0; tap < NUM_TANK_TAPS; tap++)
+				tapDelays[i][tap] = (int)((tapPercent[i][tap] / 100.0)*branchDelay);
+
+			if ((int)branchDelay < 1)
+				tankBlockLimit = 1;
+		}
+
+		uint32_t lastBranchDelay = (uint32_t)branchDelays[NUM_BRANCHES - 1].getParameters().delay_Samples;
+		if (tankBlockLimit > lastBranchDelay + 1)
+			tankBlockLimit = lastBranchDelay + 1;
 	}
 
 
@@ -4991,6 +5201,23 @@ private:
 	double apfDelayWeight[NUM_BRANCHES * 2] = { 0.317, 0.873, 0.477, 0.291, 0.993, 0.757, 0.179, 0.575 };///< weighting values to make various and low-correlated APF delay values easily
 	double fixedDelayWeight[NUM_BRANCHES] = { 1.0, 0.873, 0.707, 0.667 };	///< weighting values to make various and fixed delay values easily
 	double sampleRate = 0.0;	///< current sample rate
+
+	// --- output gains, converted from dB in setParameters( )
+	double dryGain = 0.707945784384138;		///< dry gain (default -3dB)
+	double wetGain = 0.707945784384138;		///< wet gain (default -3dB)
+
+	// --- output tap positions per branch as % of branch delay: left, right, thick-left, thick-right
+	double tapPercent[NUM_BRANCHES][NUM_TANK_TAPS] = { { 23.0, 29.0, 31.0, 37.0 },
+													   { 41.0, 43.0, 47.0, 53.0 },
+													   { 59.0, 61.0, 67.0, 71.0 },
+													   { 73.0, 79.0, 83.0, 89.0 } }; ///< output tap positions
+	int tapDelays[NUM_BRANCHES][NUM_TANK_TAPS] = { { 0 } };	///< output tap positions in samples
+
+	// --- block processing scratch
+	uint32_t tankBlockLimit = 1;								///< longest run per pass
+	double tankInput[REVERB_BLOCK_SIZE] = { 0.0 };				///< signal running through the branches
+	double preDelayOutput[REVERB_BLOCK_SIZE] = { 0.0 };		///< pre delay output, added at each branch
+	double tapOutputs[NUM_BRANCHES][NUM_TANK_TAPS][REVERB_BLOCK_SIZE] = { { { 0.0 } } };	///< output taps
 };
 
 
@@ -85,6 +85,20 @@ public:
 
 	// call this to detect; it returns the peak ms or rms value at that instant
 	inline double detect(double input)
+	{
+		double currEnvelope = detectLinear(input);
+
+		// --- setup for log( )
+		if (currEnvelope <= 0)
+			return 0;
+		
+		// --- true log, can go above 0dBFS!
+		return 20.0*log10(currEnvelope);
+	}
+
+	// --- same as detect() but returns the raw (linear) value, so callers that only compare
+	//     against a threshold never pay for the log
+	inline double detectLinear(double input)
 	{
 		switch (detectMode)
 		{
@@ -120,14 +134,9 @@ public:
 
 		// --- if RMS, do the SQRT
 		if (detectMode == ENVELOPE_DETECT_MODE_RMS)
-			currEnvelope = pow(currEnvelope, 0.5);
+			currEnvelope = sqrt(currEnvelope);
 
-		// --- setup for log( )
-		if (currEnvelope <= 0)
-			return 0;
-		
-		// --- true log, can go above 0dBFS!
-		return 20.0*log10(currEnvelope);
+		return currEnvelope;
 	}
 
 	// --- for peak-hold
@@ -194,7 +203,15 @@ public:
 
 	void setAttackTime(double attack_in_ms) { detector.setAttackTime(attack_in_ms); }
 	void setReleaseTime(double release_in_ms) { detector.setReleaseTime(release_in_ms); }
-	void setThreshold_dB(double _threshold_dB) { threshold_dB = _threshold_dB; }
+	void setThreshold_dB(double _threshold_dB) 
+	{
+		// --- called on every update; only convert when it changes
+		if (_threshold_dB == threshold_dB)
+			return;
+
+		threshold_dB = _threshold_dB;
+		threshold_Lin = pow(10.0, threshold_dB / 20.0);
+	}
 	
 	float calcLimiterGain(float fDetectorValue, float fThreshold)
 	{
@@ -212,16 +229,21 @@ public:
 		return pow(10.0, yG / 20.0);
 	}
 
-	// --- do the limiter
+	// --- do the limiter; works in the linear domain: with CS = 1 the gain 
+	//     10^((threshold_dB - detected_dB)/20) is just threshold/detected, 
+	//     and below threshold there is nothing to do at all
 	double processAudio(double input)
 	{
-		double detectedValue_dB = detector.detect(input);
-		double gain = calcLimiterGain(detectedValue_dB, threshold_dB);
-		return input*gain;
+		double detectedValue = detector.detectLinear(input);
+		if (detectedValue <= threshold_Lin)
+			return input;
+
+		return input*(threshold_Lin / detectedValue);
 	}
 
 protected:
 	TruLogDetector detector;
 	double threshold_dB = -0.5; // (dB)
+	double threshold_Lin = 0.94406087628592339; // --- 10^(-0.5/20)
 };
 
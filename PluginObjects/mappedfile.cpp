@@ -0,0 +1,129 @@
+// --- Synth Core v1.0
+//
+#include "mappedfile.h"
+
+#if defined _WINDOWS || defined _WINDLL
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+bool MappedFile::open(const std::string& filePath)
+{
+	close();
+
+#if defined _WINDOWS || defined _WINDLL
+	HANDLE hFile = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(hFile, &fileSize))
+	{
+		CloseHandle(hFile);
+		return false;
+	}
+	size = (uint64_t)fileSize.QuadPart;
+
+	// --- the view keeps the mapping alive, so both handles can go once it exists
+	HANDLE hMapping = size > 0 ? CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+	if (hMapping)
+	{
+		data = (const uint8_t*)MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+		isMapped = data != nullptr;
+		CloseHandle(hMapping);
+	}
+
+	// --- fallback: plain read
+	bool success = true;
+	if (!isMapped && size > 0)
+	{
+		fileCopy.resize(size);
+		DWORD bytesRead = 0;
+		success = ReadFile(hFile, fileCopy.data(), (DWORD)size, &bytesRead, NULL) && bytesRead == size;
+		data = fileCopy.data();
+	}
+	CloseHandle(hFile);
+#else
+	int fileDescriptor = ::open(filePath.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+		return false;
+
+	struct stat fileStat;
+	if (fstat(fileDescriptor, &fileStat) != 0)
+	{
+		::close(fileDescriptor);
+		return false;
+	}
+	size = (uint64_t)fileStat.st_size;
+
+	// --- the mapping holds its own reference to the file, so the descriptor can go
+	void* mapping = size > 0 ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0) : MAP_FAILED;
+	if (mapping != MAP_FAILED)
+	{
+		data = (const uint8_t*)mapping;
+		isMapped = true;
+	}
+
+	// --- fallback: plain read
+	bool success = true;
+	if (!isMapped && size > 0)
+	{
+		fileCopy.resize(size);
+		uint64_t bytesRead = 0;
+		while (success && bytesRead < size)
+		{
+			ssize_t result = ::read(fileDescriptor, fileCopy.data() + bytesRead, size - bytesRead);
+			if (result <= 0)
+				success = false;
+			else
+				bytesRead += result;
+		}
+		data = fileCopy.data();
+	}
+	::close(fileDescriptor);
+#endif
+
+	if (!success)
+		close();
+
+	return success;
+}
+
+void MappedFile::close()
+{
+#if defined _WINDOWS || defined _WINDLL
+	if (isMapped && data)
+		UnmapViewOfFile(data);
+#else
+	if (isMapped && data)
+		munmap((void*)data, size);
+#endif
+
+	data = nullptr;
+	size = 0;
+	isMapped = false;
+	fileCopy.clear();
+}
+
+void MappedFile::prefetch(uint64_t offset, uint64_t length) const
+{
+	if (!isMapped || offset >= size)
+		return;
+
+	if (length > size - offset)
+		length = size - offset;
+
+#if defined _WINDOWS || defined _WINDLL
+	// --- PrefetchVirtualMemory needs Windows 8; page faults do the work otherwise
+	(void)length;
+#else
+	// --- madvise wants a page-aligned start
+	const uint64_t pageSize = (uint64_t)sysconf(_SC_PAGESIZE);
+	const uint64_t alignedOffset = offset - (offset % pageSize);
+	madvise((void*)(data + alignedOffset), (size_t)(length + offset - alignedOffset), MADV_WILLNEED);
+#endif
+}
@@ -0,0 +1,44 @@
+#ifndef __mappedFile_h__
+#define __mappedFile_h__
+
+// --- includes
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+\class MappedFile
+\ingroup SynthClasses
+\brief Read-only memory mapping of a whole file; falls back to reading the file into memory
+if the mapping fails.
+
+The file itself is closed as soon as it is mapped or read (the mapping stays valid on its own),
+so an open MappedFile holds no file descriptor or handle.
+*/
+class MappedFile
+{
+public:
+	MappedFile() { }
+	~MappedFile() { close(); }
+
+	// --- map the file; returns false if it cannot be opened
+	bool open(const std::string& filePath);
+	void close();
+
+	const uint8_t* getData() const { return data; }
+	uint64_t getSize() const { return size; }
+	bool isMemoryMapped() const { return isMapped; }
+
+	// --- ask the OS to start paging in a byte range ahead of use; a hint only
+	void prefetch(uint64_t offset, uint64_t length) const;
+
+private:
+	const uint8_t* data = nullptr;
+	uint64_t size = 0;
+
+	// --- fallback copy when mapping is not possible
+	std::vector<uint8_t> fileCopy;
+	bool isMapped = false;
+};
+
+#endif /* defined(__mappedFile_h__) */
@@ -0,0 +1,287 @@
+// --- Synth Core v1.0
+//
+#include "masterfx.h"
+#include "wavedata.h"
+
+// --- half-width of the windowed-sinc kernel used to convert an IR's sample rate, in input samples
+const int32_t kIRResampleHalfWidth = 32;
+
+// --- band-limited sample rate conversion (Blackman-windowed sinc); non-realtime
+static std::vector<double> resampleImpulseResponse(const std::vector<double>& input, double inputRate, double outputRate)
+{
+	if (input.empty() || inputRate == outputRate)
+		return input;
+
+	double step = inputRate / outputRate;
+	double cutoff = fmin(1.0, outputRate / inputRate);
+	uint32_t outputLength = (uint32_t)ceil(input.size() / step);
+	std::vector<double> output(outputLength, 0.0);
+
+	for (uint32_t n = 0; n < outputLength; n++)
+	{
+		double position = n * step;
+		int32_t center = (int32_t)floor(position);
+		double sum = 0.0;
+		for (int32_t k = center - kIRResampleHalfWidth + 1; k <= center + kIRResampleHalfWidth; k++)
+		{
+			if (k < 0 || k >= (int32_t)input.size())
+				continue;
+
+			double x = position - k;
+			double sinc = x == 0.0 ? 1.0 : sin(kPi * cutoff * x) / (kPi * cutoff * x);
+			double w = 0.5 + 0.5 * x / kIRResampleHalfWidth;
+			double window = 0.42 - 0.5 * cos(2.0 * kPi * w) + 0.08 * cos(4.0 * kPi * w);
+			sum += input[k] * cutoff * sinc * window;
+		}
+		output[n] = sum;
+	}
+
+	return output;
+}
+
+MasterFXChain::MasterFXChain()
+{
+	// --- the convolvers (and the worker thread) are created with the first impulse response
+}
+
+bool MasterFXChain::reset(double _sampleRate)
+{
+	for (uint32_t i = 0; i < 2; i++)
+	{
+		shelvingEQ[i].reset(_sampleRate);
+		dynamics[i].reset(_sampleRate);
+		phaser[i].reset(_sampleRate);
+	}
+
+	modDelay.reset(_sampleRate);
+	reverb.reset(_sampleRate);
+	for (uint32_t i = 0; i < 2; i++)
+	{
+		if (convolver[i])
+			convolver[i]->reset();
+	}
+
+	// --- AudioDelay::reset( ) only clears; the buffers are sized here
+	delay.reset(_sampleRate);
+	delay.createDelayBuffers(_sampleRate, kMasterFXMaxDelay_mSec);
+
+	// --- a file IR follows the sample rate
+	sampleRate = _sampleRate;
+	applyFileImpulseResponse();
+
+	// --- push the current settings into the fresh objects
+	setParameters(parameters);
+
+	return true;
+}
+
+void MasterFXChain::setParameters(const MasterFXParameters& _parameters)
+{
+	parameters = _parameters;
+
+	chainActive = false;
+	for (uint32_t i = 0; i < kNumMasterFX; i++)
+		chainActive |= parameters.enableFX[i];
+
+	// --- nothing to forward if everything is bypassed
+	if (!chainActive)
+		return;
+
+	// --- the two dynamics processors are keyed from the same stereo detector input (see
+	//     processEffect( )), so they always apply the same gain
+	DynamicsProcessorParameters dynamicsParameters = parameters.dynamicsParameters;
+	dynamicsParameters.enableSidechain = true;
+
+	for (uint32_t i = 0; i < 2; i++)
+	{
+		shelvingEQ[i].setParameters(parameters.eqParameters);
+		dynamics[i].setParameters(dynamicsParameters);
+		phaser[i].setParameters(parameters.phaserParameters);
+	}
+
+	modDelay.setParameters(parameters.modDelayParameters);
+	delay.setParameters(parameters.delayParameters);
+	reverb.setParameters(parameters.reverbParameters);
+}
+
+bool MasterFXChain::setImpulseResponse(const double* irLeft, const double* irRight, uint32_t length)
+{
+	for (uint32_t i = 0; i < 2; i++)
+	{
+		if (!convolver[i])
+		{
+			convolver[i] = convolutionWorker.createConvolver();
+			convolver[i]->enableWorkerThread(convolutionWorkerEnabled);
+		}
+	}
+
+	convolver[0]->setImpulseResponse(irLeft, length);
+	convolver[1]->setImpulseResponse(irRight ? irRight : irLeft, length);
+
+	return convolver[0]->hasImpulseResponse();
+}
+
+bool MasterFXChain::loadImpulseResponse(const char* filePath)
+{
+	WaveData waveData(filePath);
+	if (!waveData.m_bWaveLoaded || waveData.m_uSampleRate == 0 || waveData.getFrameCount() == 0)
+		return false;
+
+	// --- channels past the first two are ignored; mono feeds both sides
+	uint32_t numChannels = waveData.m_uNumChannels;
+	uint32_t numFrames = (uint32_t)waveData.getFrameCount();
+	for (uint32_t i = 0; i < 2; i++)
+	{
+		uint32_t channel = i < numChannels ? i : 0;
+		fileIR[i].resize(numFrames);
+		for (uint32_t frame = 0; frame < numFrames; frame++)
+			fileIR[i][frame] = waveData.m_pWaveBuffer[frame * numChannels + channel];
+	}
+	fileIRSampleRate = waveData.m_uSampleRate;
+
+	// --- before the first reset the rate is unknown; reset( ) applies it
+	if (sampleRate <= 0.0)
+		return true;
+
+	return applyFileImpulseResponse();
+}
+
+bool MasterFXChain::applyFileImpulseResponse()
+{
+	if (fileIR[0].empty() || sampleRate <= 0.0)
+		return false;
+
+	std::vector<double> irLeft = resampleImpulseResponse(fileIR[0], fileIRSampleRate, sampleRate);
+	std::vector<double> irRight = resampleImpulseResponse(fileIR[1], fileIRSampleRate, sampleRate);
+
+	return setImpulseResponse(&irLeft[0], &irRight[0], (uint32_t)irLeft.size());
+}
+
+void MasterFXChain::enableConvolutionWorker(bool enable)
+{
+	convolutionWorkerEnabled = enable;
+	for (uint32_t i = 0; i < 2; i++)
+	{
+		if (convolver[i])
+			convolver[i]->enableWorkerThread(enable);
+	}
+}
+
+void MasterFXChain::processAudioBlock(double* left, double* right, uint32_t blockSize)
+{
+	if (!chainActive)
+		return;
+
+	if (blockSize > kMasterFXBlockSize)
+		blockSize = kMasterFXBlockSize;
+
+	for (uint32_t slot = 0; slot < kNumMasterFX; slot++)
+	{
+		masterFXType fx = parameters.order[slot];
+		uint32_t index = (uint32_t)fx;
+		if (index >= kNumMasterFX || !parameters.enableFX[index])
+			continue;
+
+		if (fx == masterFXType::kConvolution && (!convolver[0] || !convolver[0]->hasImpulseResponse()))
+			continue;
+
+		// --- fully wet needs no dry copy
+		double mix = fmax(0.0, fmin(1.0, parameters.fxMix[index]));
+		if (mix >= 1.0)
+		{
+			processEffect(fx, left, right, blockSize);
+			continue;
+		}
+
+		memcpy(dryLeft, left, blockSize * sizeof(double));
+		memcpy(dryRight, right, blockSize * sizeof(double));
+
+		processEffect(fx, left, right, blockSize);
+
+		for (uint32_t i = 0; i < blockSize; i++)
+		{
+			left[i] = dryLeft[i] + mix * (left[i] - dryLeft[i]);
+			right[i] = dryRight[i] + mix * (right[i] - dryRight[i]);
+		}
+	}
+}
+
+void MasterFXChain::processEffect(masterFXType fx, double* left, double* right, uint32_t blockSize)
+{
+	switch (fx)
+	{
+		case masterFXType::kShelvingEQ:
+		{
+			for (uint32_t i = 0; i < blockSize; i++)
+			{
+				left[i] = shelvingEQ[0].processAudioSample(left[i]);
+				right[i] = shelvingEQ[1].processAudioSample(right[i]);
+			}
+			break;
+		}
+		case masterFXType::kDynamics:
+		{
+			// --- linked: both sides detect the louder channel
+			for (uint32_t i = 0; i < blockSize; i++)
+			{
+				double detectorInput = fmax(fabs(left[i]), fabs(right[i]));
+				dynamics[0].processAuxInputAudioSample(detectorInput);
+				dynamics[1].processAuxInputAudioSample(detectorInput);
+
+				left[i] = dynamics[0].processAudioSample(left[i]);
+				right[i] = dynamics[1].processAudioSample(right[i]);
+			}
+			break;
+		}
+		case masterFXType::kPhaser:
+		{
+			for (uint32_t i = 0; i < blockSize; i++)
+			{
+				left[i] = phaser[0].processAudioSample(left[i]);
+				right[i] = phaser[1].processAudioSample(right[i]);
+			}
+			break;
+		}
+		case masterFXType::kModDelay:
+		{
+			processStereoFrames(modDelay, left, right, blockSize);
+			break;
+		}
+		case masterFXType::kDelay:
+		{
+			processStereoFrames(delay, left, right, blockSize);
+			break;
+		}
+		case masterFXType::kReverb:
+		{
+			reverb.processAudioBlock(left, right, blockSize);
+			break;
+		}
+		case masterFXType::kConvolution:
+		{
+			convolver[0]->processAudioBlock(left, left, blockSize);
+			convolver[1]->processAudioBlock(right, right, blockSize);
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+// --- the stereo FX objects only take interleaved float frames
+void MasterFXChain::processStereoFrames(IAudioSignalProcessor& processor, double* left, double* right, uint32_t blockSize)
+{
+	float inputFrame[2] = { 0.f };
+	float outputFrame[2] = { 0.f };
+
+	for (uint32_t i = 0; i < blockSize; i++)
+	{
+		inputFrame[0] = (float)left[i];
+		inputFrame[1] = (float)right[i];
+
+		processor.processAudioFrame(inputFrame, outputFrame, 2, 2);
+
+		left[i] = outputFrame[0];
+		right[i] = outputFrame[1];
+	}
+}
@@ -0,0 +1,186 @@
+#ifndef __masterFX_h__
+#define __masterFX_h__
+
+// --- includes
+#include "synthdefs.h"
+#include "convolver.h"
+
+// --- effects available on the master bus
+enum class masterFXType { kShelvingEQ, kDynamics, kPhaser, kModDelay, kDelay, kReverb, kConvolution };
+const uint32_t kNumMasterFX = 7;
+
+// --- the chain works on the summed output in blocks of up to this many frames
+const uint32_t kMasterFXBlockSize = 64;
+
+// --- longest AudioDelay time on the master bus
+const double kMasterFXMaxDelay_mSec = 2000.0;
+
+// --- dry level for the effects that have their own wet/dry controls
+const double kMasterFXDryOff_dB = -96.0;
+
+/**
+\struct MasterFXParameters
+\ingroup SynthStructures
+\brief Parameters for the post-voice FX chain. order[] is the processing order (one entry per
+effect); an effect runs only when enabled, and fxMix is its wet/dry blend from 0.0 (dry) to 1.0
+(the effect's own output). All effects are off by default.
+*/
+struct MasterFXParameters
+{
+	MasterFXParameters()
+	{
+		for (uint32_t i = 0; i < kNumMasterFX; i++)
+		{
+			order[i] = (masterFXType)i;
+			enableFX[i] = false;
+			fxMix[i] = 1.0;
+		}
+
+		// --- usable starting points; the FX objects default most of these to 0.0
+		eqParameters.lowShelf_fc = 150.0;
+		eqParameters.highShelf_fc = 4000.0;
+
+		dynamicsParameters.ratio = 4.0;
+		dynamicsParameters.threshold_dB = -12.0;
+		dynamicsParameters.attackTime_mSec = 5.0;
+		dynamicsParameters.releaseTime_mSec = 200.0;
+
+		phaserParameters.lfoRate_Hz = 0.5;
+		phaserParameters.lfoDepth_Pct = 50.0;
+		phaserParameters.intensity_Pct = 50.0;
+
+		modDelayParameters.algorithm = modDelaylgorithm::kChorus;
+		modDelayParameters.lfoRate_Hz = 0.5;
+		modDelayParameters.lfoDepth_Pct = 50.0;
+
+		delayParameters.leftDelay_mSec = 375.0;
+		delayParameters.rightDelay_mSec = 500.0;
+		delayParameters.updateType = delayUpdateType::kLeftPlusRatio;
+		delayParameters.delayRatio_Pct = 133.0;
+		delayParameters.feedback_Pct = 30.0;
+
+		// --- fxMix does the wet/dry blend for every effect, so these two run fully wet
+		delayParameters.wetLevel_dB = 0.0;
+		delayParameters.dryLevel_dB = kMasterFXDryOff_dB;
+
+		reverbParameters.kRT = 0.7;
+		reverbParameters.lpf_g = 0.3;
+		reverbParameters.lowShelf_fc = 150.0;
+		reverbParameters.lowShelfBoostCut_dB = -20.0;
+		reverbParameters.highShelf_fc = 4000.0;
+		reverbParameters.highShelfBoostCut_dB = -6.0;
+		reverbParameters.wetLevel_dB = 0.0;
+		reverbParameters.dryLevel_dB = kMasterFXDryOff_dB;
+	}
+
+	MasterFXParameters& operator=(const MasterFXParameters& params)
+	{
+		if (this == &params)
+			return *this;
+
+		for (uint32_t i = 0; i < kNumMasterFX; i++)
+		{
+			order[i] = params.order[i];
+			enableFX[i] = params.enableFX[i];
+			fxMix[i] = params.fxMix[i];
+		}
+
+		eqParameters = params.eqParameters;
+		dynamicsParameters = params.dynamicsParameters;
+		phaserParameters = params.phaserParameters;
+		modDelayParameters = params.modDelayParameters;
+		delayParameters = params.delayParameters;
+		reverbParameters = params.reverbParameters;
+
+		return *this;
+	}
+
+	// --- chain layout, indexed by slot (order) and by masterFXType (enable, mix)
+	masterFXType order[kNumMasterFX];
+	bool enableFX[kNumMasterFX];
+	double fxMix[kNumMasterFX];
+
+	// --- per-effect
+	TwoBandShelvingFilterParameters eqParameters;
+	DynamicsProcessorParameters dynamicsParameters;
+	PhaseShifterParameters phaserParameters;
+	ModulatedDelayParameters modDelayParameters;
+	AudioDelayParameters delayParameters;
+	ReverbTankParameters reverbParameters;
+};
+
+/**
+\class MasterFXChain
+\ingroup SynthClasses
+\brief Configurable FX chain on the summed stereo output of the synth engine, built from the
+fxobjects.h processors. Parameters arrive once per buffer through setParameters();
+processAudioBlock() runs each enabled effect over the whole block in turn. The compressor is
+stereo linked: both channels get the gain for the louder one. The convolution slot
+uses the impulse response loaded with loadImpulseResponse( ) or setImpulseResponse( ) and is
+skipped until one is loaded; a file IR is resampled to the running rate in reset( ).
+*/
+class MasterFXChain
+{
+public:
+	MasterFXChain();
+	~MasterFXChain() {}
+
+	// --- allocates the delay lines; call from reset, not the audio thread
+	bool reset(double _sampleRate);
+
+	// --- once per buffer
+	void setParameters(const MasterFXParameters& _parameters);
+
+	// --- non-realtime, with the audio stopped (like reset); irRight = nullptr uses irLeft for
+	//     both channels; the IR must be at the current sample rate
+	bool setImpulseResponse(const double* irLeft, const double* irRight, uint32_t length);
+
+	// --- non-realtime: decodes a mono or stereo .wav impulse response; it is converted to the
+	//     running sample rate now (after the first reset) and again on every reset
+	bool loadImpulseResponse(const char* filePath);
+
+	// --- compute the convolution tail on the audio thread instead of the worker; for
+	//     rendering faster than real time
+	void enableConvolutionWorker(bool enable);
+
+	// --- true if any effect is enabled
+	bool isActive() { return chainActive; }
+
+	// --- in place, blockSize <= kMasterFXBlockSize
+	void processAudioBlock(double* left, double* right, uint32_t blockSize);
+
+protected:
+	MasterFXParameters parameters;
+	bool chainActive = false;
+
+	// --- mono processors run one per channel
+	TwoBandShelvingFilter shelvingEQ[2];
+	DynamicsProcessor dynamics[2];
+	PhaseShifter phaser[2];
+
+	// --- stereo processors
+	ModulatedDelay modDelay;
+	AudioDelay delay;
+	ReverbTank reverb;
+
+	// --- convolution: one worker thread computes both channels' long partitions
+	ConvolutionWorker convolutionWorker;
+	std::shared_ptr<PartitionedConvolver> convolver[2];
+	bool convolutionWorkerEnabled = true;
+
+	// --- the file IR as decoded, kept for sample rate changes
+	std::vector<double> fileIR[2];
+	double fileIRSampleRate = 0.0;
+	double sampleRate = 0.0;
+	bool applyFileImpulseResponse();
+
+	// --- one effect over the block, in place
+	void processEffect(masterFXType fx, double* left, double* right, uint32_t blockSize);
+	void processStereoFrames(IAudioSignalProcessor& processor, double* left, double* right, uint32_t blockSize);
+
+	// --- dry copy for wet/dry
+	double dryLeft[kMasterFXBlockSize] = { 0.0 };
+	double dryRight[kMasterFXBlockSize] = { 0.0 };
+};
+
+#endif /* defined(__masterFX_h__) */
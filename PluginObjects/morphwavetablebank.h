@@ -0,0 +1,315 @@
+#ifndef __morphWavetableBank_h__
+#define __morphWavetableBank_h__
+
+// --- includes
+#include "synthdefs.h"
+
+// --- wavetable objects and structs
+#include "wavetable.h"
+#include "wavetablebank.h"
+
+#include "sharedtablestore.h"
+
+#include <map>
+#include <algorithm>
+
+/**
+\class MorphingWaveTableBank
+\ingroup SynthClasses
+\brief Bank of HiResWTSets that can be scanned (morphed) from one waveform to the next.
+
+Every adjacent pair of waveforms (0-1, 1-2, ... N-2 - N-1) is precomputed for each MIDI note slot
+as one interleaved table of { table_0[n], table_1[n] - table_0[n] } so that the oscillator reads
+both tables with a single index calculation and two multiply-adds; output compensation is baked in.
+Pairs are immutable once built and shared across all voices and all plugin instances (SharedTableStore).
+*/
+class MorphingWaveTableBank : public IMorphingWaveBank
+{
+public:
+	MorphingWaveTableBank()
+	{
+		// --- identity until a sample rate is set
+		for (uint32_t i = 0; i < MAX_HIRES_TABLE_SET; i++)
+			rateNoteMap[i] = (uint8_t)i;
+	}
+
+	// ---- have tables destroy themselves
+	virtual ~MorphingWaveTableBank()
+	{
+		for (uint32_t i = 0; i < wavetables.size(); i++)
+			delete wavetables[i];
+
+		wavetables.clear();
+	}
+
+	// --- from a .h File; tableNames can be nullptr -- if so, the name is the default table name
+	inline void initializeWithHiResWTBank(BankDescriptor bankDesc)
+	{
+		if (bankDesc.tablePtrsCount > MAX_TABLES_PER_BANK)
+			bankDesc.tablePtrsCount = MAX_TABLES_PER_BANK;
+
+		for (uint32_t i = 0; i < bankDesc.tablePtrsCount; i++)
+		{
+			Wavetable* wt = new Wavetable;
+			wt->initWithHiResWTSet(bankDesc.tablePtrs[i]);
+
+			if (bankDesc.tableNames)
+				wt->waveformName = bankDesc.tableNames[i];
+
+			wavetables.push_back(wt);
+		}
+
+		// --- build the pair tables once per process; they do not depend on sample rate
+		createMorphTablePairs(bankDesc);
+	}
+
+	// --- IMorphingWaveBank
+	//     pairs share the first set's design rate; remap slots for the running sample rate
+	virtual bool resetWaveTables(double sampleRate)
+	{
+		if (getNumMorphWaves() == 0)
+			return false;
+
+		calculateRateNoteMap(wavetables[0]->pHiResWTSet->tableFs, sampleRate, rateNoteMap);
+		return true;
+	}
+
+	// --- oscillatorWaveformIndex is the LOWER waveform of the pair; the pair returned
+	//     is read-only, oscillators copy it and keep their own read index
+	virtual MorphTablePair* selectTablePair(int oscillatorWaveformIndex, uint32_t midiNoteNumber)
+	{
+		if (morphPairs.size() == 0)
+			return nullptr;
+
+		if (oscillatorWaveformIndex < 0)
+			oscillatorWaveformIndex = 0;
+		if (oscillatorWaveformIndex > (int)morphPairs.size() - 1)
+			oscillatorWaveformIndex = morphPairs.size() - 1;
+		if (midiNoteNumber > MAX_HIRES_TABLE_SET - 1)
+			midiNoteNumber = MAX_HIRES_TABLE_SET - 1;
+
+		return &morphPairs[oscillatorWaveformIndex][rateNoteMap[midiNoteNumber]];
+	}
+
+	// --- fused two-table read: one index, one interpolation, morph applied at both points
+	inline virtual double readMorphWaveTable(MorphTablePair* selectedWTPair)
+	{
+		if (!selectedWTPair || !selectedWTPair->pairTable)
+			return 0.0;
+
+		// --- get INT and FRAC part
+		uint32_t intReadIndex = (uint32_t)selectedWTPair->readIndex_0;
+		double fractionalPart = selectedWTPair->readIndex_0 - intReadIndex;
+
+		// --- guard points mean [intReadIndex + 1] is always valid
+		const double* pairData = selectedWTPair->pairTable + 2 * intReadIndex;
+		double y0 = pairData[0] + selectedWTPair->morphFraction * pairData[1];
+		double y1 = pairData[2] + selectedWTPair->morphFraction * pairData[3];
+
+		return y0 + fractionalPart * (y1 - y0);
+	}
+
+	// --- get the number of waves for this datasource
+	virtual uint32_t getNumMorphWaves() { return wavetables.size(); }
+
+	// --- get the list of 32 strings
+	virtual std::vector<std::string> getMorphWaveNames()
+	{
+		int blankWavs = MAX_TABLES_PER_BANK - wavetables.size();
+		std::vector<std::string> stringList;
+		for (uint32_t i = 0; i < wavetables.size(); i++) {
+			stringList.push_back(wavetables[i]->waveformName);
+		}
+		for (int i = 0; i < blankWavs; i++) {
+			stringList.push_back("-- empty --");
+		}
+
+		return stringList;
+	}
+
+	// --- this is where you get the bank name, maybe for GUI
+	virtual std::string getMorphWaveBankName() { return bankName; }
+	virtual void setMorphWaveBankName(std::string _bankName) { bankName = _bankName; }
+
+private:
+	// --- name of this bank
+	std::string bankName;
+
+	// --- source waveforms (for names and table pointers)
+	std::vector<Wavetable*> wavetables;
+
+	// --- [pair index][MIDI note] -> pair; N-1 pairs for N waveforms (1 pair of itself if N = 1)
+	std::vector<std::vector<MorphTablePair>> morphPairs;
+
+	// --- immutable pair tables, shared by every instance using the same table sets
+	struct MorphPairTables
+	{
+		uint32_t numPairs = 0;
+
+		// --- [pair index * MAX_HIRES_TABLE_SET + MIDI note]
+		std::vector<const double*> pairTables;
+		std::vector<uint32_t> tableLengths;
+
+		// --- backing storage for the interleaved pair tables
+		std::vector<std::vector<double>> pairStorage;
+	};
+	std::shared_ptr<const MorphPairTables> sharedPairTables;
+
+	// --- played note -> table slot for the current sample rate
+	uint8_t rateNoteMap[MAX_HIRES_TABLE_SET];
+
+	// --- decoded copy of one note slot of one HiResWTSet, with comp applied
+	static void decodeTable(const HiResWTSet* set, uint32_t midiNoteNumber, std::vector<double>& table)
+	{
+		uint32_t len = set->tableLengths[midiNoteNumber];
+		table.resize(len);
+
+		if (set->isHexTable && set->pp_uHexTableSet && set->pp_uHexTableSet[midiNoteNumber])
+		{
+			const uint64_t* hexTable = set->pp_uHexTableSet[midiNoteNumber];
+			uint64_t key = set->isEncrypted ? set->encryptionKey : 0;
+			for (uint32_t i = 0; i < len; i++)
+				table[i] = set->outputComp * uint64ToDouble(key ^ hexTable[i]);
+		}
+		else if (set->pp_dDecimalTableSet && set->pp_dDecimalTableSet[midiNoteNumber])
+		{
+			const double* decTable = set->pp_dDecimalTableSet[midiNoteNumber];
+			for (uint32_t i = 0; i < len; i++)
+				table[i] = set->outputComp * decTable[i];
+		}
+		else
+			std::fill(table.begin(), table.end(), 0.0);
+	}
+
+	// --- source table pointer for a note slot, used to find repeated slots
+	static const void* getSourceTable(const HiResWTSet* set, uint32_t midiNoteNumber)
+	{
+		if (set->isHexTable && set->pp_uHexTableSet)
+			return set->pp_uHexTableSet[midiNoteNumber];
+		if (set->pp_dDecimalTableSet)
+			return set->pp_dDecimalTableSet[midiNoteNumber];
+		return nullptr;
+	}
+
+	// --- build the interleaved pair tables; table_1 is resampled to the length of
+	//     table_0 if they differ so the fused read always uses one index
+	static std::shared_ptr<MorphPairTables> buildMorphPairTables(const std::vector<const HiResWTSet*>& sets)
+	{
+		std::shared_ptr<MorphPairTables> pairData = std::make_shared<MorphPairTables>();
+
+		uint32_t numWaves = sets.size();
+		if (numWaves == 0)
+			return pairData;
+
+		pairData->numPairs = numWaves > 1 ? numWaves - 1 : 1;
+		pairData->pairTables.resize(pairData->numPairs * MAX_HIRES_TABLE_SET, nullptr);
+		pairData->tableLengths.resize(pairData->numPairs * MAX_HIRES_TABLE_SET, 0);
+
+		// --- pointers into pairStorage are taken after it stops growing
+		std::vector<uint32_t> storageIndex(pairData->numPairs * MAX_HIRES_TABLE_SET, 0);
+
+		std::vector<double> table_0;
+		std::vector<double> table_1;
+
+		for (uint32_t p = 0; p < pairData->numPairs; p++)
+		{
+			const HiResWTSet* set_0 = sets[p];
+			const HiResWTSet* set_1 = sets[numWaves > 1 ? p + 1 : p];
+
+			// --- note slots share tables (e.g. one per minor 3rd); build each distinct combination once
+			std::map<std::pair<const void*, const void*>, uint32_t> builtPairs;
+
+			for (uint32_t n = 0; n < MAX_HIRES_TABLE_SET; n++)
+			{
+				uint32_t slot = p * MAX_HIRES_TABLE_SET + n;
+				pairData->tableLengths[slot] = set_0->tableLengths[n];
+
+				std::pair<const void*, const void*> key(getSourceTable(set_0, n), getSourceTable(set_1, n));
+				auto it = builtPairs.find(key);
+				if (it != builtPairs.end())
+				{
+					storageIndex[slot] = it->second;
+					continue;
+				}
+
+				decodeTable(set_0, n, table_0);
+				decodeTable(set_1, n, table_1);
+
+				uint32_t len = table_0.size();
+				std::vector<double> interleaved(2 * (len + 2), 0.0);
+				for (uint32_t i = 0; i < len; i++)
+				{
+					double t1 = 0.0;
+					if (table_1.size() == len)
+						t1 = table_1[i];
+					else if (table_1.size() > 0)
+					{
+						double position = (double)i * table_1.size() / (double)len;
+						uint32_t index = (uint32_t)position;
+						uint32_t nextIndex = index + 1 >= table_1.size() ? 0 : index + 1;
+						t1 = doLinearInterpolation(0.0, 1.0, table_1[index], table_1[nextIndex], position - index);
+					}
+					interleaved[2 * i] = table_0[i];
+					interleaved[2 * i + 1] = t1 - table_0[i];
+				}
+
+				// --- guard points = first points; the index wrap allows readIndex == len
+				for (uint32_t i = 0; i < 4; i++)
+					interleaved[2 * len + i] = len > 0 ? interleaved[i % (2 * len)] : 0.0;
+
+				builtPairs[key] = pairData->pairStorage.size();
+				storageIndex[slot] = pairData->pairStorage.size();
+				pairData->pairStorage.push_back(std::move(interleaved));
+			}
+		}
+
+		for (uint32_t slot = 0; slot < pairData->pairTables.size(); slot++)
+			pairData->pairTables[slot] = pairData->pairStorage[storageIndex[slot]].data();
+
+		return pairData;
+	}
+
+	// --- get the shared pair tables (building them if this is the first instance) and
+	//     point this bank's pairs at them
+	void createMorphTablePairs(const BankDescriptor& bankDesc)
+	{
+		morphPairs.clear();
+		sharedPairTables = nullptr;
+
+		std::vector<const HiResWTSet*> sets;
+		for (uint32_t i = 0; i < wavetables.size(); i++)
+			sets.push_back(wavetables[i]->pHiResWTSet);
+
+		if (sets.size() == 0)
+			return;
+
+		// --- factory table sets are static, so their addresses identify them
+		std::stringstream key;
+		key << "morph:" << (const void*)bankDesc.tablePtrs << ":" << sets.size();
+
+		sharedPairTables = SharedTableStore::getInstance().acquire<MorphPairTables>(key.str(), [&]()
+		{
+			return buildMorphPairTables(sets);
+		});
+
+		if (!sharedPairTables)
+			return;
+
+		uint32_t numWaves = wavetables.size();
+		morphPairs.resize(sharedPairTables->numPairs, std::vector<MorphTablePair>(MAX_HIRES_TABLE_SET));
+		for (uint32_t p = 0; p < sharedPairTables->numPairs; p++)
+		{
+			for (uint32_t n = 0; n < MAX_HIRES_TABLE_SET; n++)
+			{
+				MorphTablePair& pair = morphPairs[p][n];
+				pair.table_0 = wavetables[p];
+				pair.table_1 = wavetables[numWaves > 1 ? p + 1 : p];
+				pair.table_0_Length = sharedPairTables->tableLengths[p * MAX_HIRES_TABLE_SET + n];
+				pair.table_1_Length = pair.table_0_Length;
+				pair.pairTable = sharedPairTables->pairTables[p * MAX_HIRES_TABLE_SET + n];
+			}
+		}
+	}
+};
+
+#endif /* defined(__morphWavetableBank_h__) */
@@ -0,0 +1,187 @@
+// --- Synth Core v1.0
+//
+#include "morphwavetableoscillator.h"
+
+// --- oscillator
+MorphWaveTableOsc::MorphWaveTableOsc(const std::shared_ptr<MidiInputData> _midiInputData,
+									 std::shared_ptr<SynthOscParameters> _parameters,
+									 std::shared_ptr<WaveTableData> _waveTableData)
+	: WaveTableOsc(_midiInputData, _parameters, _waveTableData)
+{
+	selectedMorphBank = waveTableData->getMorphInterface(getBankIndex(bankSet, parameters->oscillatorBankIndex));
+}
+
+MorphWaveTableOsc::~MorphWaveTableOsc()
+{
+}
+
+// --- ISynthOscillator
+bool MorphWaveTableOsc::reset(double _sampleRate)
+{
+	WaveTableOsc::reset(_sampleRate);
+
+	morphTablePair.readIndex_0 = 0.0;
+	morphTablePair.readIndex_1 = 0.0;
+
+	return true;
+}
+
+std::vector<std::string> MorphWaveTableOsc::getWaveformNames(uint32_t bankIndex)
+{
+	std::vector<std::string> emptyVector;
+
+	// --- decode bank index
+	IMorphingWaveBank* bank = waveTableData->getMorphInterface(getBankIndex(bankSet, bankIndex));
+	if (bank)
+		return bank->getMorphWaveNames();
+
+	emptyVector.clear();
+	return emptyVector;
+}
+
+bool MorphWaveTableOsc::doNoteOn(double midiPitch, uint32_t _midiNoteNumber, uint32_t midiNoteVelocity)
+{
+	WaveTableOsc::doNoteOn(midiPitch, _midiNoteNumber, midiNoteVelocity);
+
+	if (!parameters->enableFreeRunMode)
+	{
+		morphTablePair.readIndex_0 = 0.0;
+		morphTablePair.readIndex_1 = 0.0;
+	}
+
+	return true;
+}
+
+bool MorphWaveTableOsc::update(bool updateAllModRoutings)
+{
+	// --- Run priority modulators 
+	// --- note that this is a dummy call, just to keep the glide modulator synced
+	glideModulator.getNextGlideModSemitones();
+
+	// --- End Priority modulators
+	if (!updateAllModRoutings)
+		return true;
+
+	// --- same pitch calculation and unison lanes as the normal wavetable oscillator
+	calculateOscillatorFrequency();
+	setUnisonLanes();
+
+	// --- BANK is set here
+	selectedMorphBank = waveTableData->getMorphInterface(getBankIndex(bankSet, parameters->oscillatorBankIndex));
+	if (!selectedMorphBank || selectedMorphBank->getNumMorphWaves() == 0)
+		return true;
+
+	// --- morph location: unipolar control + bipolar modulation
+	double morph = parameters->morphModulation + modulators->modulationInputs[kWaveMorphMod];
+	boundValue(morph, 0.0, 1.0);
+
+	uint32_t numWaves = selectedMorphBank->getNumMorphWaves();
+	morphLocation = morph * (numWaves - 1);
+
+	// --- lower table of the pair and fraction; the top wave is the end of the last pair
+	int pairIndex = (int)morphLocation;
+	double morphFraction = morphLocation - pairIndex;
+	if (numWaves < 2)
+	{
+		pairIndex = 0;
+		morphFraction = 0.0;
+	}
+	else if (pairIndex > (int)numWaves - 2)
+	{
+		pairIndex = numWaves - 2;
+		morphFraction = 1.0;
+	}
+
+	// --- with unison, the highest lane picks the band limit
+	uint32_t tableMidiNoteNumber = renderMidiNoteNumber;
+	if (unisonLaneCount > 1)
+		tableMidiNoteNumber = midiNoteNumberFromOscFrequency(oscillatorFrequency * unisonDetuneRatio[unisonLaneCount - 1]);
+
+	MorphTablePair* tablePair = selectedMorphBank->selectTablePair(pairIndex, tableMidiNoteNumber);
+	if (!tablePair)
+		return true;
+
+	// --- keep our read location; the bank's pair is shared
+	double readIndex = morphTablePair.readIndex_0;
+	uint32_t lastTableLength = morphTablePair.table_0_Length;
+
+	morphTablePair = *tablePair;
+	morphTablePair.morphFraction = morphFraction;
+	morphTablePair.readIndex_0 = readIndex;
+
+	// --- if table size changed, keep the same relative location
+	if (lastTableLength != 0 && lastTableLength != morphTablePair.table_0_Length)
+		morphTablePair.readIndex_0 = (readIndex / (double)lastTableLength) * morphTablePair.table_0_Length;
+
+	if (morphTablePair.table_0_Length != currentTableLength)
+		setUnisonTableLength(morphTablePair.table_0_Length);
+
+	currentTableLength = morphTablePair.table_0_Length;
+	phaseInc = calculateWaveTablePhaseInc(oscillatorFrequency, sampleRate, currentTableLength);
+
+	// --- detuneCents is not used here, so all lanes share the one pitch
+	setUnisonPhaseInc(phaseInc, phaseInc);
+
+	return true;
+}
+
+const OscillatorOutputData MorphWaveTableOsc::renderAudioOutput()
+{
+	// --- prep output buffer
+	oscillatorAudioData.outputs[0] = 0.0;
+	oscillatorAudioData.outputs[1] = 0.0;
+
+	if (!selectedMorphBank || currentTableLength == 0)
+		return oscillatorAudioData;
+
+	// --- unison renders both channels
+	if (unisonLaneCount > 1)
+	{
+		renderUnison(oscillatorAudioData.outputs[0], oscillatorAudioData.outputs[1]);
+
+		double amplitude = parameters->outputAmplitude * modulators->modulationInputs[kAmpMod];
+		oscillatorAudioData.outputs[0] *= amplitude;
+		oscillatorAudioData.outputs[1] *= amplitude;
+
+		return oscillatorAudioData;
+	}
+
+	// --- apply phase modulation, if any
+	double readIndex = morphTablePair.readIndex_0;
+	if (modulators->modulationInputs[kPhaseMod] != 0.0)
+	{
+		morphTablePair.readIndex_0 += modulators->modulationInputs[kPhaseMod] * currentTableLength;
+		checkAndWrapWaveTableIndex(morphTablePair.readIndex_0, currentTableLength);
+	}
+
+	// --- one fused read of both tables
+	oscillatorAudioData.outputs[0] = selectedMorphBank->readMorphWaveTable(&morphTablePair);
+
+	// --- increment index
+	morphTablePair.readIndex_0 = readIndex + phaseInc;
+	checkAndWrapWaveTableIndex(morphTablePair.readIndex_0, currentTableLength);
+
+	// --- scale by output amplitude
+	oscillatorAudioData.outputs[0] *= (parameters->outputAmplitude * modulators->modulationInputs[kAmpMod]);
+
+	// --- copy to right channel
+	oscillatorAudioData.outputs[1] = oscillatorAudioData.outputs[0];
+
+	return oscillatorAudioData;
+}
+
+// --- one fused read of the pair per lane; the pair's own read index is put back afterwards
+void MorphWaveTableOsc::readUnisonLanes(const double* laneReadIndex, double* laneOutput)
+{
+	const double tableLength = (double)currentTableLength;
+	double readIndex = morphTablePair.readIndex_0;
+
+	for (uint32_t i = 0; i < unisonLaneCount; i++)
+	{
+		// --- the guard point covers [index + 1] only inside the table
+		morphTablePair.readIndex_0 = laneReadIndex[i] < tableLength ? laneReadIndex[i] : 0.0;
+		laneOutput[i] = selectedMorphBank->readMorphWaveTable(&morphTablePair);
+	}
+
+	morphTablePair.readIndex_0 = readIndex;
+}
@@ -0,0 +1,55 @@
+#ifndef __morphWavetableOscillator_h__
+#define __morphWavetableOscillator_h__
+
+// --- includes
+#include "synthdefs.h"
+#include "wavetableoscillator.h"
+
+/**
+\class MorphWaveTableOsc
+\ingroup SynthClasses
+\brief Wavetable oscillator that scans across the waveforms of a MorphingWaveTableBank
+
+Morph location = SynthOscParameters::morphModulation + modulationInputs[kWaveMorphMod], bound to [0, 1]
+and spread across all waveforms in the bank; the location picks a precomputed adjacent pair and
+the crossfade fraction within it so that each sample is one fused two-table read.
+
+Unison uses the WaveTableOsc lanes; each lane is one fused read of the same pair.
+*/
+class MorphWaveTableOsc : public WaveTableOsc
+{
+public:
+	MorphWaveTableOsc(const std::shared_ptr<MidiInputData> _midiInputData,
+					  std::shared_ptr<SynthOscParameters> _parameters,
+					  std::shared_ptr<WaveTableData> _waveTableData);
+
+	virtual ~MorphWaveTableOsc();
+
+	// --- ISynthOscillator
+	virtual bool reset(double _sampleRate);
+	virtual bool update(bool updateAllModRoutings = true);
+	virtual bool doNoteOn(double midiPitch, uint32_t _midiNoteNumber, uint32_t midiNoteVelocity);
+
+	// --- **7**
+	virtual std::vector<std::string> getWaveformNames(uint32_t bankIndex);
+	virtual std::vector<std::string> getBankNames() { return waveTableData->getMorphWaveBankNames(bankSet); }
+
+	// --- main render function
+	virtual const OscillatorOutputData renderAudioOutput();
+
+protected:
+	// --- unison lanes read the selected pair
+	virtual void readUnisonLanes(const double* laneReadIndex, double* laneOutput);
+
+	// --- currently selected morphing bank
+	IMorphingWaveBank* selectedMorphBank = nullptr;
+
+	// --- our copy of the selected pair; holds our own read index
+	MorphTablePair morphTablePair;
+
+	// --- location across the bank [0, numWaves - 1]
+	double morphLocation = 0.0;
+};
+
+
+#endif /* defined(__morphWavetableOscillator_h__) */
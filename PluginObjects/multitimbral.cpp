@@ -0,0 +1,212 @@
+// --- Synth Core v1.0
+//
+#include "multitimbral.h"
+
+void MultiTimbralEngine::setNumParts(uint32_t _numParts, std::shared_ptr<WaveSampleData> waveSampleData)
+{
+	if (_numParts > kMaxSynthParts)
+		_numParts = kMaxSynthParts;
+
+	// --- parts are kept when the count drops, so their settings survive; one coming back is
+	//     brought up to date with the initialize and reset calls it missed
+	for (uint32_t i = numParts; i < _numParts; i++)
+	{
+		if (!parts[i])
+		{
+			parts[i].reset(new SynthPart);
+			parts[i]->engine.reset(new SynthEngine(std::make_shared<WaveTableData>(), waveSampleData));
+			parts[i]->parameters = parts[i]->engine->getParameters();
+		}
+
+		SynthPart& part = *parts[i];
+		if (initialized && !part.initialized)
+		{
+			part.engine->initialize(pluginInfo);
+			part.initialized = true;
+		}
+		if (sampleRate > 0.0 && part.sampleRate != sampleRate)
+		{
+			part.engine->reset(sampleRate);
+			part.sampleRate = sampleRate;
+		}
+		part.numEvents = 0;
+		part.nextEvent = 0;
+	}
+
+	numParts = _numParts;
+}
+
+bool MultiTimbralEngine::initialize(PluginInfo _pluginInfo)
+{
+	pluginInfo = _pluginInfo;
+	initialized = true;
+
+	for (uint32_t i = 0; i < numParts; i++)
+	{
+		parts[i]->engine->initialize(pluginInfo);
+		parts[i]->initialized = true;
+	}
+
+	return true;
+}
+
+bool MultiTimbralEngine::reset(double _sampleRate)
+{
+	sampleRate = _sampleRate;
+
+	for (uint32_t i = 0; i < numParts; i++)
+	{
+		parts[i]->engine->reset(sampleRate);
+		parts[i]->sampleRate = sampleRate;
+		parts[i]->numEvents = 0;
+		parts[i]->nextEvent = 0;
+	}
+
+	return true;
+}
+
+SynthEngineParameters MultiTimbralEngine::getPartParameters(uint32_t part)
+{
+	if (part >= numParts)
+		return SynthEngineParameters();
+
+	return parts[part]->engine->getParameters();
+}
+
+void MultiTimbralEngine::setPartParameters(uint32_t part, const SynthEngineParameters& _parameters)
+{
+	if (part >= numParts)
+		return;
+
+	// --- values only; the part's voices keep pointing at its own structures
+	parts[part]->parameters.copyParameterValues(_parameters);
+	parts[part]->engine->setParameters(parts[part]->parameters);
+}
+
+bool MultiTimbralEngine::processMIDIEvent(midiEvent& event, uint32_t frame)
+{
+	if (event.midiChannel >= numParts)
+		return false;
+
+	// --- full: every part renders up to this event, then this part's queue is fired and emptied
+	SynthPart& part = *parts[event.midiChannel];
+	if (part.numEvents >= kMaxPartEvents)
+	{
+		renderBlockTo(frame);
+		firePartEvents(part);
+	}
+
+	part.events[part.numEvents] = event;
+	part.events[part.numEvents].midiSampleOffset = frame;
+	part.numEvents++;
+
+	return true;
+}
+
+void MultiTimbralEngine::renderPartJob(void* context, uint32_t job)
+{
+	MultiTimbralEngine* multiTimbralEngine = (MultiTimbralEngine*)context;
+	multiTimbralEngine->renderPart(*multiTimbralEngine->parts[job]);
+}
+
+void MultiTimbralEngine::renderPart(SynthPart& part)
+{
+	uint32_t chunkEnd = chunkStart + chunkFrames;
+
+	for (uint32_t i = 0; i < chunkFrames; i++)
+	{
+		// --- fire this frame's events, same as the single engine does
+		while (part.nextEvent < part.numEvents && part.events[part.nextEvent].midiSampleOffset <= chunkStart + i)
+		{
+			part.engine->processMIDIEvent(part.events[part.nextEvent]);
+			part.nextEvent++;
+		}
+
+		const SynthRenderData render = part.engine->renderAudioOutput();
+		part.outputs[0][i] = (float)render.synthOutputs[0];
+		part.outputs[1][i] = (float)render.synthOutputs[1];
+	}
+
+	// --- events stamped past the end (should not happen) fire at the end of the buffer
+	if (chunkEnd >= renderFrames)
+		firePartEvents(part);
+
+	// --- each part has its own master FX
+	float* partOutputs[2] = { part.outputs[0], part.outputs[1] };
+	part.engine->processMasterFX(partOutputs, 2, chunkFrames);
+}
+
+void MultiTimbralEngine::firePartEvents(SynthPart& part)
+{
+	while (part.nextEvent < part.numEvents)
+	{
+		part.engine->processMIDIEvent(part.events[part.nextEvent]);
+		part.nextEvent++;
+	}
+
+	part.numEvents = 0;
+	part.nextEvent = 0;
+}
+
+void MultiTimbralEngine::beginAudioBlock(float* left, float* right, uint32_t numFrames)
+{
+	blockLeft = left;
+	blockRight = right;
+	renderFrames = left ? numFrames : 0;
+	blockFrame = 0;
+}
+
+void MultiTimbralEngine::renderBlockTo(uint32_t endFrame)
+{
+	if (!blockLeft)
+		return;
+
+	if (endFrame > renderFrames)
+		endFrame = renderFrames;
+
+	while (blockFrame < endFrame)
+	{
+		chunkStart = blockFrame;
+		chunkFrames = endFrame - blockFrame;
+		if (chunkFrames > kPartRenderFrames)
+			chunkFrames = kPartRenderFrames;
+
+		workerPool.runJobs(&MultiTimbralEngine::renderPartJob, this, numParts);
+
+		// --- mix in part order
+		for (uint32_t i = 0; i < chunkFrames; i++)
+		{
+			float mixLeft = 0.f;
+			float mixRight = 0.f;
+			for (uint32_t p = 0; p < numParts; p++)
+			{
+				mixLeft += parts[p]->outputs[0][i];
+				mixRight += parts[p]->outputs[1][i];
+			}
+
+			blockLeft[chunkStart + i] = mixLeft;
+			if (blockRight)
+				blockRight[chunkStart + i] = mixRight;
+		}
+
+		blockFrame += chunkFrames;
+	}
+}
+
+void MultiTimbralEngine::renderAudioBlock()
+{
+	renderBlockTo(renderFrames);
+
+	// --- the event queues are per buffer; anything still queued fires at the end
+	for (uint32_t p = 0; p < numParts; p++)
+		firePartEvents(*parts[p]);
+
+	blockLeft = nullptr;
+	blockRight = nullptr;
+}
+
+void MultiTimbralEngine::renderAudioBlock(float* left, float* right, uint32_t numFrames)
+{
+	beginAudioBlock(left, right, numFrames);
+	renderAudioBlock();
+}
@@ -0,0 +1,120 @@
+#ifndef __multiTimbral_h__
+#define __multiTimbral_h__
+
+// --- includes
+#include "synthcore.h"
+#include "synthworkerpool.h"
+
+// --- one part per MIDI channel
+const uint32_t kMaxSynthParts = 16;
+
+// --- MIDI events a part queues; when one part's queue fills, the buffer is rendered up to the
+//     next event and that queue is emptied
+const uint32_t kMaxPartEvents = 256;
+
+// --- parts render in chunks of this many frames
+const uint32_t kPartRenderFrames = 256;
+
+/**
+\struct SynthPart
+\ingroup SynthClasses
+\brief One part of a MultiTimbralEngine: an engine with its own parameters plus the MIDI events
+queued for it this buffer and the scratch output it renders into.
+*/
+struct SynthPart
+{
+	std::unique_ptr<SynthEngine> engine;
+	SynthEngineParameters parameters;
+
+	// --- what the engine was last set up with; a part kept while inactive misses both
+	bool initialized = false;
+	double sampleRate = 0.0;
+
+	// --- this buffer's events, in frame order; midiSampleOffset is the buffer frame
+	midiEvent events[kMaxPartEvents];
+	uint32_t numEvents = 0;
+	uint32_t nextEvent = 0;
+
+	// --- current chunk
+	float outputs[2][kPartRenderFrames] = { { 0.f } };
+};
+
+/**
+\class MultiTimbralEngine
+\ingroup SynthClasses
+\brief Up to kMaxSynthParts SynthEngines keyed by MIDI channel (channel N plays part N), each
+with its own parameters, voices and master FX.
+
+MIDI events are queued per part with their frame offsets while the buffer's events are fired into
+the buffer opened with beginAudioBlock( ); renderAudioBlock( ) then renders the parts, one job per
+part on a SynthWorkerPool, and mixes them in part order so the result does not depend on which
+thread rendered what. If a part's queue fills, all parts are rendered up to the new event's frame
+and that part's queued events are fired, so no event is lost.
+
+The parts share the wavesamples. Each part has its own WaveTableData so it can reset its banks
+on its own; the table memory behind them is shared through the SharedTableStore.
+
+setNumParts( ) and setNumWorkers( ) allocate and must not be called while the audio thread is
+processing.
+*/
+class MultiTimbralEngine
+{
+public:
+	MultiTimbralEngine() {}
+	~MultiTimbralEngine() {}
+
+	// --- non-realtime; new parts are initialized and reset with the last values passed in
+	void setNumParts(uint32_t _numParts, std::shared_ptr<WaveSampleData> waveSampleData);
+	uint32_t getNumParts() { return numParts; }
+
+	void setNumWorkers(uint32_t numWorkers) { workerPool.setNumWorkers(numWorkers); }
+	uint32_t getNumWorkers() { return workerPool.getNumWorkers(); }
+
+	bool initialize(PluginInfo _pluginInfo);
+	bool reset(double _sampleRate);
+
+	// --- part presets: setPartParameters( ) copies the values into the part, call it where
+	//     SynthEngine::setParameters( ) would be called (top of the buffer)
+	SynthEngineParameters getPartParameters(uint32_t part);
+	void setPartParameters(uint32_t part, const SynthEngineParameters& _parameters);
+
+	// --- audio thread: open the buffer the queued events render into; right may be nullptr (mono)
+	void beginAudioBlock(float* left, float* right, uint32_t numFrames);
+
+	// --- audio thread: queue an event for its channel's part at this buffer frame; false if the
+	//     channel has no part
+	bool processMIDIEvent(midiEvent& event, uint32_t frame);
+
+	// --- audio thread: render and mix all parts over the rest of the open buffer
+	void renderAudioBlock();
+
+	// --- audio thread: beginAudioBlock( ) + renderAudioBlock( ) for events queued beforehand
+	void renderAudioBlock(float* left, float* right, uint32_t numFrames);
+
+protected:
+	uint32_t numParts = 0;
+	std::unique_ptr<SynthPart> parts[kMaxSynthParts];
+
+	PluginInfo pluginInfo;
+	bool initialized = false;
+	double sampleRate = 0.0;
+
+	SynthWorkerPool workerPool;
+
+	// --- the open buffer, how far it has been rendered and the chunk being rendered by the jobs
+	float* blockLeft = nullptr;
+	float* blockRight = nullptr;
+	uint32_t renderFrames = 0;
+	uint32_t blockFrame = 0;
+	uint32_t chunkStart = 0;
+	uint32_t chunkFrames = 0;
+
+	void renderBlockTo(uint32_t endFrame);
+	void firePartEvents(SynthPart& part);
+
+	// --- a job renders one part over the current chunk
+	static void renderPartJob(void* context, uint32_t job);
+	void renderPart(SynthPart& part);
+};
+
+#endif /* defined(__multiTimbral_h__) */
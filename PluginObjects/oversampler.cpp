@@ -0,0 +1,130 @@
+// --- Synth Core v1.0
+//
+#include "oversampler.h"
+
+#include <algorithm>
+
+// --- zeroth order modified Bessel function of the first kind, for the Kaiser window
+static double besselI0(double x)
+{
+	double sum = 1.0;
+	double term = 1.0;
+	for (uint32_t k = 1; k < 64 && term > 1.0e-12 * sum; k++)
+	{
+		double halfXOverK = 0.5 * x / (double)k;
+		term *= halfXOverK * halfXOverK;
+		sum += term;
+	}
+	return sum;
+}
+
+// --- passband edge 20kHz at 44.1kHz (0.4535 fs at the base rate), stopband edge at the base
+//     rate Nyquist, Kaiser beta for the stopband depth
+const double kOversamplerPassbandEdge = 20000.0 / 44100.0;
+const double kOversamplerStopbandEdge = 0.5;
+const double kOversamplerKaiserBeta = 9.2;
+
+// --- Kaiser windowed-sinc, cutoff halfway through the transition band, unity gain at DC
+//
+//     NOTE: through an up/down pair this is within 0.001dB up to 20kHz (at 44.1kHz and up) and
+//           better than 90dB down from the base rate Nyquist, which is where the decimator
+//           folds back into the audio band; the transition band is above 20kHz
+void getOversamplerFilterIR(uint32_t ratio, double* filterIR)
+{
+	const uint32_t FIRLength = ratio * kOversamplerPhaseLength;
+	const double fc = 0.5 * (kOversamplerPassbandEdge + kOversamplerStopbandEdge) / (double)ratio;
+	const double center = 0.5 * (double)(FIRLength - 1);
+	const double windowNorm = 1.0 / besselI0(kOversamplerKaiserBeta);
+
+	double dcGain = 0.0;
+	for (uint32_t i = 0; i < FIRLength; i++)
+	{
+		double t = (double)i - center;
+		double sinc = sin(kTwoPi * fc * t) / (kPi * t);
+		double r = t / center;
+		double window = besselI0(kOversamplerKaiserBeta * sqrt(std::max(0.0, 1.0 - r * r))) * windowNorm;
+
+		filterIR[i] = sinc * window;
+		dcGain += filterIR[i];
+	}
+
+	for (uint32_t i = 0; i < FIRLength; i++)
+		filterIR[i] /= dcGain;
+}
+
+// --- PolyphaseInterpolator ----------------------------------------------------------------
+void PolyphaseInterpolator::initialize(uint32_t _ratio)
+{
+	ratio = _ratio == 4 ? 4 : 2;
+
+	double filterIR[kMaxOversamplerFIRLength];
+	getOversamplerFilterIR(ratio, filterIR);
+
+	// --- decompose; the interpolator gain makes up for the zeros that are never stuffed
+	for (uint32_t phase = 0; phase < ratio; phase++)
+	{
+		for (uint32_t i = 0; i < kOversamplerPhaseLength; i++)
+			phaseCoeffs[phase][i] = (double)ratio * filterIR[i * ratio + phase];
+	}
+
+	clear();
+}
+
+void PolyphaseInterpolator::clear()
+{
+	memset(history, 0, sizeof(history));
+	writeIndex = 0;
+}
+
+void PolyphaseInterpolator::interpolateAudio(double xn, double* output)
+{
+	// --- write twice so the newest kOversamplerPhaseLength samples are always contiguous
+	writeIndex = writeIndex == 0 ? kOversamplerPhaseLength - 1 : writeIndex - 1;
+	history[writeIndex] = xn;
+	history[writeIndex + kOversamplerPhaseLength] = xn;
+
+	const double* window = &history[writeIndex];
+	for (uint32_t phase = 0; phase < ratio; phase++)
+	{
+		const double* coeffs = phaseCoeffs[phase];
+		double yn = 0.0;
+		for (uint32_t i = 0; i < kOversamplerPhaseLength; i++)
+			yn += coeffs[i] * window[i];
+
+		output[phase] = yn;
+	}
+}
+
+// --- PolyphaseDecimator -------------------------------------------------------------------
+void PolyphaseDecimator::initialize(uint32_t _ratio)
+{
+	ratio = _ratio == 4 ? 4 : 2;
+	FIRLength = ratio * kOversamplerPhaseLength;
+	getOversamplerFilterIR(ratio, filterIR);
+
+	clear();
+}
+
+void PolyphaseDecimator::clear()
+{
+	memset(history, 0, sizeof(history));
+	writeIndex = 0;
+}
+
+double PolyphaseDecimator::decimateAudio(const double* input)
+{
+	for (uint32_t i = 0; i < ratio; i++)
+	{
+		writeIndex = writeIndex == 0 ? FIRLength - 1 : writeIndex - 1;
+		history[writeIndex] = input[i];
+		history[writeIndex + FIRLength] = input[i];
+	}
+
+	// --- only the output we keep
+	const double* window = &history[writeIndex];
+	double yn = 0.0;
+	for (uint32_t i = 0; i < FIRLength; i++)
+		yn += filterIR[i] * window[i];
+
+	return yn;
+}
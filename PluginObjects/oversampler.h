@@ -0,0 +1,77 @@
+#ifndef __overSampler_h__
+#define __overSampler_h__
+
+// --- includes
+#include "synthdefs.h"
+
+// --- the voice oversampler's anti-aliasing FIR is kOversamplerPhaseLength taps per phase:
+//     256 taps at 2x, 512 at 4x
+const uint32_t kMaxOversamplingRatio = 4;
+const uint32_t kOversamplerPhaseLength = 128;
+const uint32_t kMaxOversamplerFIRLength = kMaxOversamplingRatio * kOversamplerPhaseLength;
+
+/**
+\class PolyphaseInterpolator
+\ingroup SynthClasses
+\brief Upsamples by 2 or 4 with a polyphase FIR: each output phase is its own
+kOversamplerPhaseLength-tap filter run over the same input history, so no zero-stuffed samples
+are ever multiplied. Every phase is a plain dot product over contiguous arrays, which the
+compiler vectorizes. Latency is kOversamplerPhaseLength / 2 samples at the base rate.
+*/
+class PolyphaseInterpolator
+{
+public:
+	PolyphaseInterpolator() {}
+	~PolyphaseInterpolator() {}
+
+	// --- no allocation; safe to call from the audio thread
+	void initialize(uint32_t _ratio);
+	void clear();
+
+	// --- one input sample -> ratio output samples, in time order
+	void interpolateAudio(double xn, double* output);
+
+protected:
+	uint32_t ratio = 2;
+
+	// --- phase k holds h[k], h[k + ratio], h[k + 2*ratio]...
+	double phaseCoeffs[kMaxOversamplingRatio][kOversamplerPhaseLength] = { { 0.0 } };
+
+	// --- mirrored history: newest first at history[writeIndex], always contiguous
+	double history[2 * kOversamplerPhaseLength] = { 0.0 };
+	uint32_t writeIndex = 0;
+};
+
+/**
+\class PolyphaseDecimator
+\ingroup SynthClasses
+\brief Downsamples by 2 or 4 with the same FIR as PolyphaseInterpolator; only the output that
+is kept is computed, one dot product per ratio input samples.
+*/
+class PolyphaseDecimator
+{
+public:
+	PolyphaseDecimator() {}
+	~PolyphaseDecimator() {}
+
+	// --- no allocation; safe to call from the audio thread
+	void initialize(uint32_t _ratio);
+	void clear();
+
+	// --- ratio input samples, in time order -> one output sample
+	double decimateAudio(const double* input);
+
+protected:
+	uint32_t ratio = 2;
+	uint32_t FIRLength = 2 * kOversamplerPhaseLength;
+	double filterIR[kMaxOversamplerFIRLength] = { 0.0 };
+
+	// --- mirrored history: newest first at history[writeIndex], always contiguous
+	double history[2 * kMaxOversamplerFIRLength] = { 0.0 };
+	uint32_t writeIndex = 0;
+};
+
+// --- fills filterIR (ratio * kOversamplerPhaseLength taps) with the anti-aliasing LPF
+void getOversamplerFilterIR(uint32_t ratio, double* filterIR);
+
+#endif /* defined(__overSampler_h__) */
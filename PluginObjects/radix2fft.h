@@ -0,0 +1,104 @@
+#ifndef __radix2FFT_h__
+#define __radix2FFT_h__
+
+// --- includes
+#include "guiconstants.h"
+
+#include <stdint.h>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+/**
+\class Radix2FFT
+\ingroup SynthClasses
+\brief In-place radix-2 complex FFT with a precomputed bit-reversal table and twiddles;
+initialize( ) allocates, the transforms do not. Neither direction scales (like FFTW), so a
+forward/inverse pair multiplies the signal by N.
+*/
+class Radix2FFT
+{
+public:
+	Radix2FFT() {}
+	~Radix2FFT() {}
+
+	// --- N must be a power of two
+	void initialize(uint32_t N)
+	{
+		length = N;
+
+		// --- bit reversal permutation
+		bitReverse.assign(N, 0);
+		for (uint32_t i = 1, j = 0; i < N; i++)
+		{
+			uint32_t bit = N >> 1;
+			for (; j & bit; bit >>= 1)
+				j ^= bit;
+			j ^= bit;
+			bitReverse[i] = j;
+		}
+
+		// --- forward twiddles, exp(-j*2*pi*k/N)
+		twiddleReal.assign(N / 2, 0.0);
+		twiddleImag.assign(N / 2, 0.0);
+		for (uint32_t k = 0; k < N / 2; k++)
+		{
+			twiddleReal[k] = cos(kTwoPi * k / N);
+			twiddleImag[k] = -sin(kTwoPi * k / N);
+		}
+	}
+
+	// --- in place, length points each
+	void forwardFFT(double* real, double* imag) { transform(real, imag, 1.0); }
+	void inverseFFT(double* real, double* imag) { transform(real, imag, -1.0); }
+
+	uint32_t getLength() { return length; }
+
+	static bool isPowerOfTwo(uint32_t N) { return N > 0 && (N & (N - 1)) == 0; }
+
+protected:
+	uint32_t length = 0;
+	std::vector<uint32_t> bitReverse;
+	std::vector<double> twiddleReal;
+	std::vector<double> twiddleImag;
+
+	// --- twiddleSign = -1 uses the conjugate twiddles (inverse)
+	void transform(double* real, double* imag, double twiddleSign)
+	{
+		for (uint32_t i = 0; i < length; i++)
+		{
+			uint32_t j = bitReverse[i];
+			if (i < j)
+			{
+				std::swap(real[i], real[j]);
+				std::swap(imag[i], imag[j]);
+			}
+		}
+
+		for (uint32_t len = 2; len <= length; len <<= 1)
+		{
+			uint32_t half = len / 2;
+			uint32_t step = length / len;
+
+			for (uint32_t i = 0; i < length; i += len)
+			{
+				for (uint32_t k = 0; k < half; k++)
+				{
+					double wReal = twiddleReal[k * step];
+					double wImag = twiddleSign * twiddleImag[k * step];
+
+					uint32_t a = i + k;
+					uint32_t b = a + half;
+					double tReal = real[b] * wReal - imag[b] * wImag;
+					double tImag = real[b] * wImag + imag[b] * wReal;
+					real[b] = real[a] - tReal;
+					imag[b] = imag[a] - tImag;
+					real[a] += tReal;
+					imag[a] += tImag;
+				}
+			}
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,213 @@
+// --- Synth Core v1.0
+//
+#include "samplestreamer.h"
+
+#include <algorithm>
+
+// --- SampleStream -------------------------------------------------------------------------
+SampleStream::SampleStream(moodycamel::spsc_sema::LightweightSemaphore* _ioWakeup)
+	: blockPool(kSampleStreamBlocks)
+	, filledBlocks(kSampleStreamBlocks)
+	, emptyBlocks(kSampleStreamBlocks)
+	, requestSequence(0)
+	, requestWaveData(nullptr)
+	, requestStartFrame(0)
+	, requestLoopStartFrame(0)
+	, requestLoopEndFrame(0)
+	, isLooping(false)
+	, ioWakeup(_ioWakeup)
+{
+	// --- every block starts out empty, owned by the I/O side
+	for (uint32_t i = 0; i < kSampleStreamBlocks; i++)
+		emptyBlocks.try_enqueue(&blockPool[i]);
+}
+
+void SampleStream::start(const WaveData* waveData, uint64_t startFrame, uint64_t loopStartFrame, uint64_t loopEndFrame, bool looping)
+{
+	// --- sequence lock: odd while the fields are being written
+	uint32_t sequence = requestSequence.load(std::memory_order_relaxed);
+	requestSequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	requestWaveData.store(waveData, std::memory_order_relaxed);
+	requestStartFrame.store(startFrame, std::memory_order_relaxed);
+	requestLoopStartFrame.store(loopStartFrame, std::memory_order_relaxed);
+	requestLoopEndFrame.store(loopEndFrame, std::memory_order_relaxed);
+	isLooping.store(looping, std::memory_order_relaxed);
+
+	audioGeneration = sequence + 2;
+	requestSequence.store(audioGeneration, std::memory_order_release);
+
+	// --- anything already decoded belongs to the old request
+	SampleStreamBlock* block = nullptr;
+	while (filledBlocks.try_dequeue(block))
+		emptyBlocks.try_enqueue(block);
+
+	if (ioWakeup)
+		ioWakeup->signal();
+}
+
+SampleStreamBlock* SampleStream::getNextBlock()
+{
+	SampleStreamBlock* block = nullptr;
+	while (filledBlocks.try_dequeue(block))
+	{
+		if (block->generation == audioGeneration)
+			return block;
+
+		// --- decoded for an older request before the I/O thread saw the new one
+		releaseBlock(block);
+	}
+
+	return nullptr;
+}
+
+void SampleStream::releaseBlock(SampleStreamBlock* block)
+{
+	if (!block)
+		return;
+
+	emptyBlocks.try_enqueue(block);
+
+	if (ioWakeup)
+		ioWakeup->signal();
+}
+
+// --- I/O thread; returns true if a new request was picked up
+bool SampleStream::readRequest()
+{
+	uint32_t sequence = requestSequence.load(std::memory_order_acquire);
+	if (sequence == ioGeneration || (sequence & 1))
+		return false;
+
+	const WaveData* waveData = requestWaveData.load(std::memory_order_relaxed);
+	uint64_t startFrame = requestStartFrame.load(std::memory_order_relaxed);
+	uint64_t loopStartFrame = requestLoopStartFrame.load(std::memory_order_relaxed);
+	uint64_t loopEndFrame = requestLoopEndFrame.load(std::memory_order_relaxed);
+
+	// --- torn read: the audio thread started another request while we were reading
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (requestSequence.load(std::memory_order_relaxed) != sequence)
+		return false;
+
+	ioGeneration = sequence;
+	ioWaveData = waveData;
+	ioCursor = startFrame;
+	ioLoopStartFrame = loopStartFrame;
+	ioLoopEndFrame = loopEndFrame;
+	ioFinished = !waveData || startFrame >= waveData->getFrameCount();
+
+	return true;
+}
+
+bool SampleStream::service()
+{
+	bool didWork = readRequest();
+
+	SampleStreamBlock* block = nullptr;
+	while (!ioFinished && emptyBlocks.try_dequeue(block))
+	{
+		fillBlock(block);
+		filledBlocks.try_enqueue(block);
+		didWork = true;
+
+		// --- a new note: switch now rather than decoding the rest of the old one
+		readRequest();
+	}
+
+	// --- get the OS reading the next block while the voice plays this one
+	if (!ioFinished)
+		ioWaveData->prefetchFrames(ioCursor, kSampleStreamBlockFrames);
+
+	return didWork;
+}
+
+void SampleStream::fillBlock(SampleStreamBlock* block)
+{
+	const uint64_t frameCount = ioWaveData->getFrameCount();
+	const uint32_t numChannels = ioWaveData->m_uNumChannels;
+
+	// --- looping is read once per block; a note-off lands on a block boundary
+	const bool looping = isLooping.load(std::memory_order_relaxed) &&
+		ioLoopEndFrame > ioLoopStartFrame && ioLoopEndFrame <= frameCount && ioCursor < ioLoopEndFrame;
+	const uint64_t segmentEnd = looping ? ioLoopEndFrame : frameCount;
+
+	const uint32_t blockFrames = (uint32_t)std::min((uint64_t)kSampleStreamBlockFrames, segmentEnd - ioCursor);
+
+	// --- only grows, and only here on the I/O thread
+	block->samples.resize((blockFrames + 1) * numChannels);
+	block->startFrame = ioCursor;
+	block->frameCount = blockFrames;
+	block->numChannels = numChannels;
+	block->generation = ioGeneration;
+
+	ioWaveData->readFrames(ioCursor, blockFrames, block->samples.data());
+	ioCursor += blockFrames;
+
+	// --- where the next block starts
+	if (ioCursor >= segmentEnd)
+	{
+		if (looping)
+			ioCursor = ioLoopStartFrame;
+		else
+			ioFinished = true;
+	}
+
+	// --- guard frame
+	float* guard = block->samples.data() + blockFrames * numChannels;
+	if (ioFinished)
+		std::fill(guard, guard + numChannels, 0.f);
+	else
+		ioWaveData->readFrames(ioCursor, 1, guard);
+
+	block->isLastBlock = ioFinished;
+}
+
+// --- SampleStreamer -----------------------------------------------------------------------
+SampleStreamer::SampleStreamer()
+	: stopStreaming(false)
+{
+	ioThread = std::thread(&SampleStreamer::streamSamples, this);
+}
+
+SampleStreamer::~SampleStreamer()
+{
+	stopStreaming.store(true);
+	ioWakeup.signal();
+
+	if (ioThread.joinable())
+		ioThread.join();
+}
+
+std::shared_ptr<SampleStream> SampleStreamer::createStream()
+{
+	std::shared_ptr<SampleStream> stream = std::make_shared<SampleStream>(&ioWakeup);
+
+	std::lock_guard<std::mutex> lock(streamsMutex);
+	streams.push_back(stream);
+
+	return stream;
+}
+
+void SampleStreamer::removeStream(const std::shared_ptr<SampleStream>& stream)
+{
+	std::lock_guard<std::mutex> lock(streamsMutex);
+	streams.erase(std::remove(streams.begin(), streams.end(), stream), streams.end());
+}
+
+void SampleStreamer::streamSamples()
+{
+	while (!stopStreaming.load())
+	{
+		// --- woken by start( ) and releaseBlock( ); the timeout is only a safety net
+		ioWakeup.wait(20000);
+
+		std::lock_guard<std::mutex> lock(streamsMutex);
+		for (auto& stream : streams)
+		{
+			if (stopStreaming.load())
+				break;
+			stream->service();
+		}
+	}
+}
@@ -0,0 +1,131 @@
+#ifndef __sampleStreamer_h__
+#define __sampleStreamer_h__
+
+// --- includes
+#include "synthdefs.h"
+#include "wavedata.h"
+#include "readerwriterqueue.h"
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+
+// --- streaming sizes: a voice holds kSampleStreamBlocks * kSampleStreamBlockFrames frames of
+//     look-ahead beyond the head (about 0.7 sec at 48kHz and unity pitch)
+const uint32_t kSampleStreamBlockFrames = 4096;
+const uint32_t kSampleStreamBlocks = 8;
+
+/**
+\struct SampleStreamBlock
+\ingroup SynthStructures
+\brief One window of decoded frames in play order. The frame after the last one (the next frame
+in play order, which is the loop start when the stream wrapped) is stored as a guard so a
+reader can interpolate across the block boundary.
+*/
+struct SampleStreamBlock
+{
+	std::vector<float> samples;		///< (frameCount + 1) * numChannels, interleaved
+	uint64_t startFrame = 0;		///< file frame of samples[0]
+	uint32_t frameCount = 0;
+	uint32_t numChannels = 0;
+	uint32_t generation = 0;		///< the start( ) request this block belongs to
+	bool isLastBlock = false;		///< end of file; nothing follows
+};
+
+/**
+\class SampleStream
+\ingroup SynthClasses
+\brief Lock-free hand-off of decoded sample blocks from the I/O thread to one oscillator.
+
+The audio thread calls start( ) at note-on and then takes blocks with getNextBlock( ) and
+returns them with releaseBlock( ); neither call blocks or allocates. The SampleStreamer's I/O
+thread calls service( ) to decode into the returned blocks. Blocks travel through two
+single-producer/single-consumer queues (filled and empty) and a start request is published
+with a sequence lock, so a burst of note-ons never waits on the disk; blocks from an older
+request are recycled unread.
+
+Forward loops are followed by the I/O thread (it wraps from loop end to loop start while
+looping is on); other loop types must be resident in the head.
+*/
+class SampleStream
+{
+public:
+	SampleStream(moodycamel::spsc_sema::LightweightSemaphore* _ioWakeup);
+	~SampleStream() { }
+
+	// --- audio thread: stream waveData from startFrame; loopEndFrame is exclusive and
+	//     0 means no loop
+	void start(const WaveData* waveData, uint64_t startFrame, uint64_t loopStartFrame, uint64_t loopEndFrame, bool looping);
+	void stop() { start(nullptr, 0, 0, 0, false); }
+
+	// --- audio thread: turn looping off to let the stream run on to the end (note-off)
+	void setLooping(bool looping) { isLooping.store(looping, std::memory_order_relaxed); }
+
+	// --- audio thread: next block for the current request, or nullptr if the I/O thread has
+	//     not caught up (underrun)
+	SampleStreamBlock* getNextBlock();
+	void releaseBlock(SampleStreamBlock* block);
+
+	// --- I/O thread: pick up a new request and fill any empty blocks; returns true if it did work
+	bool service();
+
+private:
+	// --- block pool; ownership moves between the two queues
+	std::vector<SampleStreamBlock> blockPool;
+	moodycamel::ReaderWriterQueue<SampleStreamBlock*> filledBlocks;
+	moodycamel::ReaderWriterQueue<SampleStreamBlock*> emptyBlocks;
+
+	// --- the start request: written by the audio thread under requestSequence (odd while writing)
+	std::atomic<uint32_t> requestSequence;
+	std::atomic<const WaveData*> requestWaveData;
+	std::atomic<uint64_t> requestStartFrame;
+	std::atomic<uint64_t> requestLoopStartFrame;
+	std::atomic<uint64_t> requestLoopEndFrame;
+	std::atomic<bool> isLooping;
+
+	// --- audio thread only
+	uint32_t audioGeneration = 0;
+
+	// --- I/O thread only
+	uint32_t ioGeneration = 0;
+	const WaveData* ioWaveData = nullptr;
+	uint64_t ioCursor = 0;
+	uint64_t ioLoopStartFrame = 0;
+	uint64_t ioLoopEndFrame = 0;
+	bool ioFinished = true;
+	bool readRequest();
+	void fillBlock(SampleStreamBlock* block);
+
+	// --- to wake the I/O thread
+	moodycamel::spsc_sema::LightweightSemaphore* ioWakeup = nullptr;
+};
+
+/**
+\class SampleStreamer
+\ingroup SynthClasses
+\brief Owns the sample I/O thread and the streams it services; one per WaveSampleData. Streams
+are created and removed on non-realtime threads (oscillator construction/destruction).
+*/
+class SampleStreamer
+{
+public:
+	SampleStreamer();
+	~SampleStreamer();
+
+	// --- register a new stream with the I/O thread
+	std::shared_ptr<SampleStream> createStream();
+	void removeStream(const std::shared_ptr<SampleStream>& stream);
+
+private:
+	std::thread ioThread;
+	std::atomic<bool> stopStreaming;
+	moodycamel::spsc_sema::LightweightSemaphore ioWakeup;
+
+	// --- the audio thread never takes this
+	std::mutex streamsMutex;
+	std::vector<std::shared_ptr<SampleStream>> streams;
+
+	void streamSamples();
+};
+
+#endif /* defined(__sampleStreamer_h__) */
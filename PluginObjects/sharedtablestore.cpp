@@ -0,0 +1,61 @@
+// --- Synth Core v1.0
+//
+#include "sharedtablestore.h"
+
+SharedTableStore& SharedTableStore::getInstance()
+{
+	// --- entries own nothing, so destruction order against instances does not matter
+	static SharedTableStore store;
+	return store;
+}
+
+std::shared_ptr<const void> SharedTableStore::find(const std::string& key)
+{
+	std::lock_guard<std::mutex> lock(storeMutex);
+
+	auto it = entries.find(key);
+	if (it == entries.end())
+		return nullptr;
+
+	return it->second.lock();
+}
+
+std::shared_ptr<const void> SharedTableStore::insert(const std::string& key, std::shared_ptr<const void> data)
+{
+	std::lock_guard<std::mutex> lock(storeMutex);
+
+	// --- someone else finished first: use theirs
+	auto it = entries.find(key);
+	if (it != entries.end())
+	{
+		std::shared_ptr<const void> existing = it->second.lock();
+		if (existing)
+			return existing;
+	}
+
+	// --- drop dead entries while we are here
+	for (auto entry = entries.begin(); entry != entries.end(); )
+	{
+		if (entry->second.expired())
+			entry = entries.erase(entry);
+		else
+			++entry;
+	}
+
+	entries[key] = data;
+	return data;
+}
+
+uint32_t SharedTableStore::getNumEntries()
+{
+	std::lock_guard<std::mutex> lock(storeMutex);
+
+	uint32_t count = 0;
+	for (auto it = entries.begin(); it != entries.end(); ++it)
+	{
+		if (!it->second.expired())
+			count++;
+	}
+
+	return count;
+}
@@ -0,0 +1,62 @@
+#ifndef __sharedTableStore_h__
+#define __sharedTableStore_h__
+
+// --- includes
+#include <memory>
+#include <mutex>
+#include <map>
+#include <string>
+#include <functional>
+
+/**
+\class SharedTableStore
+\ingroup SynthClasses
+\brief Process-wide store of immutable table memory (decoded brick files, generated
+band-limited tables, morph pair tables) shared by every plugin instance in the host.
+
+Entries are keyed by table identity and reference counted with std::shared_ptr; the store only
+holds weak references, so memory goes away with the last instance that uses it. Objects that
+select tables (Wavetable, banks) stay per-instance and only point at the shared data.
+
+Key prefixes name the stored type ("brick:", "bltable:", "morph:") so one key never maps to
+two types.
+*/
+class SharedTableStore
+{
+public:
+	// --- the one store for this process (this module)
+	static SharedTableStore& getInstance();
+
+	// --- return the live entry for key, or build it with createData() and share it.
+	//     createData() runs without the lock held; if two instances race, the first one
+	//     stored wins and the other's copy is dropped
+	template <typename T>
+	std::shared_ptr<const T> acquire(const std::string& key, const std::function<std::shared_ptr<T>()>& createData)
+	{
+		std::shared_ptr<const void> existing = find(key);
+		if (existing)
+			return std::static_pointer_cast<const T>(existing);
+
+		std::shared_ptr<const T> created = createData();
+		if (!created)
+			return nullptr;
+
+		return std::static_pointer_cast<const T>(insert(key, created));
+	}
+
+	// --- number of live entries (for diagnostics)
+	uint32_t getNumEntries();
+
+private:
+	SharedTableStore() { }
+	SharedTableStore(const SharedTableStore&) = delete;
+	SharedTableStore& operator=(const SharedTableStore&) = delete;
+
+	std::shared_ptr<const void> find(const std::string& key);
+	std::shared_ptr<const void> insert(const std::string& key, std::shared_ptr<const void> data);
+
+	std::mutex storeMutex;
+	std::map<std::string, std::weak_ptr<const void>> entries;
+};
+
+#endif /* defined(__sharedTableStore_h__) */
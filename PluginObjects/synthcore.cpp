@@ -6,7 +6,8 @@
 SynthVoice::SynthVoice(const std::shared_ptr<MidiInputData> _midiInputData, 
 						const std::shared_ptr<MidiOutputData> _midiOutputData, 
 						std::shared_ptr<SynthVoiceParameters> _parameters, 
-						std::shared_ptr<WaveTableData> _waveTableData)
+						std::shared_ptr<WaveTableData> _waveTableData,
+						std::shared_ptr<WaveSampleData> _waveSampleData)
 : ISynthComponent()
 , midiInputData(_midiInputData)		//<- set our midi dat interface value
 , midiOutputData(_midiOutputData)
@@ -23,10 +24,10 @@ SynthVoice::SynthVoice(const std::shared_ptr<MidiInputData> _midiInputData,
 		parameters = std::make_shared<SynthVoiceParameters>();
 
 	// --- create subcomponents
-	osc1.reset(new SynthOsc(midiInputData, parameters->osc1Parameters, _waveTableData));
-	osc2.reset(new SynthOsc(midiInputData, parameters->osc2Parameters, _waveTableData));
-	osc3.reset(new SynthOsc(midiInputData, parameters->osc3Parameters, _waveTableData));
-	osc4.reset(new SynthOsc(midiInputData, parameters->osc4Parameters, _waveTableData));
+	osc1.reset(new SynthOsc(midiInputData, parameters->osc1Parameters, _waveTableData, _waveSampleData));
+	osc2.reset(new SynthOsc(midiInputData, parameters->osc2Parameters, _waveTableData, _waveSampleData));
+	osc3.reset(new SynthOsc(midiInputData, parameters->osc3Parameters, _waveTableData, _waveSampleData));
+	osc4.reset(new SynthOsc(midiInputData, parameters->osc4Parameters, _waveTableData, _waveSampleData));
 	
 	// lfo1 is a smart pointer object; we can use . operators or -> operators
 	// smart pointers will be constructed per voice, but will be shared after that point
@@ -85,8 +86,9 @@ std::vector<std::string> SynthVoice::getBankNames(uint32_t oscIndex)
 // --- NOTE: parameters.dllFolderPath MUST be set before this call!!
 bool SynthVoice::initialize(PluginInfo pluginInfo)
 {
-	// --- use this to setup morphing wave table osc
-	// add your code here
+	// --- morphing wavetable oscillators live inside each SynthOsc and share the
+	//     morphing banks in WaveTableData; select with SynthOscParameters::oscType
+	//     and route to kOscN_Morph
 
 	return true;
 }
@@ -96,6 +98,7 @@ bool SynthVoice::reset(double _sampleRate)
 {
 	// --- clear output array
 	synthOutputData.clear();
+	sampleRate = _sampleRate;
 
 	// --- reset sub objects
 	osc1->reset(_sampleRate);
@@ -110,7 +113,9 @@ bool SynthVoice::reset(double _sampleRate)
 	ampEG->reset(_sampleRate);
 	EG2->reset(_sampleRate);
 
+	filterOversampling = 1;
 	moogFilter->reset(_sampleRate);
+	setOversamplingRatio(parameters->oversamplingRatio);
 
 	dca->reset(_sampleRate);
 
@@ -182,15 +187,37 @@ const SynthRenderData SynthVoice::renderAudioOutput()
 	// --- run the granularity counter
 	bool updateAllModRoutings = needsComponentUpdate();
 
-	// --- update/render (add more here)
-	lfo1->update(updateAllModRoutings);
-	lfo1Output = lfo1->renderModulatorOutput();
+	// --- LFOs render only what the matrix reads
+	if (updateAllModRoutings)
+	{
+		lfo1->setOutputMask(getRoutedLFOOutputs(*modDestinationColumns, kLFO1_Normal, kLFO1_QuadPhase));
+		lfo2->setOutputMask(getRoutedLFOOutputs(*modDestinationColumns, kLFO2_Normal, kLFO2_QuadPhase));
+	}
+
+	// --- update/render (add more here); global modulators were rendered once by the engine
+	if (globalLFO1Output && parameters->lfo1Parameters->globalLFO)
+		lfo1Output = *globalLFO1Output;
+	else
+	{
+		lfo1->update(updateAllModRoutings);
+		lfo1Output = lfo1->renderModulatorOutput();
+	}
 
-	lfo2->update(updateAllModRoutings);
-	lfo2Output = lfo2->renderModulatorOutput();
+	if (globalLFO2Output && parameters->lfo2Parameters->globalLFO)
+		lfo2Output = *globalLFO2Output;
+	else
+	{
+		lfo2->update(updateAllModRoutings);
+		lfo2Output = lfo2->renderModulatorOutput();
+	}
 
-	rotor->update(updateAllModRoutings);
-	rotorOutput = rotor->renderModulatorOutput();
+	if (globalRotorOutput && parameters->rotorParameters->globalRotor)
+		rotorOutput = *globalRotorOutput;
+	else
+	{
+		rotor->update(updateAllModRoutings);
+		rotorOutput = rotor->renderModulatorOutput();
+	}
 	
 	// --- update/render (add more here)
 	ampEG->update(updateAllModRoutings);
@@ -198,6 +225,8 @@ const SynthRenderData SynthVoice::renderAudioOutput()
 	EG2->update(updateAllModRoutings);
 	EG2Output = EG2->renderModulatorOutput();
 
+	if (updateAllModRoutings)
+		setOversamplingRatio(parameters->oversamplingRatio);
 	moogFilter->update(updateAllModRoutings);
 
 	// --- do all modulations
@@ -212,47 +241,44 @@ const SynthRenderData SynthVoice::renderAudioOutput()
 	dca->update(updateAllModRoutings);
 
 	// --- render Oscillators (add more here)
-	osc1Output = osc1->renderAudioOutput();	// and here....
-	osc2Output = osc2->renderAudioOutput();
-	osc3Output = osc3->renderAudioOutput();
-	osc4Output = osc4->renderAudioOutput();
+	renderOscillators(updateAllModRoutings);
 
-	// --- blend oscillator outputs
-	
-	/*double oscOut = osc1Output.outputs[0] * 0.25
-		+ osc2Output.outputs[0] * 0.25
-		+ osc3Output.outputs[0] * 0.25
-		+ osc4Output.outputs[0] * 0.25;*/
-	double oscOut = 0.0;
+	// --- blend oscillator outputs; the oscillators are stereo (unison spread, stereo samples)
+	//     and so is the rest of the voice
+	double mixGain[kNumVoiceOscillators] = { 0.0 };
 	if (parameters->rotorParameters->mode == 0)
 	{
-		oscOut = osc1Output.outputs[0] * parameters->vectorJSData.vectorA
-			+ osc2Output.outputs[0] * parameters->vectorJSData.vectorB
-			+ osc3Output.outputs[0] * parameters->vectorJSData.vectorC
-			+ osc4Output.outputs[0] * parameters->vectorJSData.vectorD;
+		mixGain[0] = parameters->vectorJSData.vectorA;
+		mixGain[1] = parameters->vectorJSData.vectorB;
+		mixGain[2] = parameters->vectorJSData.vectorC;
+		mixGain[3] = parameters->vectorJSData.vectorD;
 	}
 	else // if using the rotor... 
 	{
-		oscOut = osc1Output.outputs[0] * rotorOutput.modulationOutputs[0]
-			+ osc2Output.outputs[0] * rotorOutput.modulationOutputs[1]
-			- osc3Output.outputs[0] * rotorOutput.modulationOutputs[0]
-			- osc4Output.outputs[0] * rotorOutput.modulationOutputs[1];
+		mixGain[0] = rotorOutput.modulationOutputs[0];
+		mixGain[1] = rotorOutput.modulationOutputs[1];
+		mixGain[2] = -rotorOutput.modulationOutputs[0];
+		mixGain[3] = -rotorOutput.modulationOutputs[1];
 	}
 
-
-	// --- this voice is MONO up to this point
-	SynthProcessorData audioData;
-	audioData.numInputChannels = 1;		// mono in
+	SynthProcessorData& audioData = voiceAudioData;
+	audioData.numInputChannels = 2;		// stereo in
 	audioData.numOutputChannels = 2;	// stereo out
-	audioData.inputs[0] = oscOut;
+	for (uint32_t i = 0; i < 2; i++)
+	{
+		audioData.inputs[i] = osc1Output.outputs[i] * mixGain[0]
+			+ osc2Output.outputs[i] * mixGain[1]
+			+ osc3Output.outputs[i] * mixGain[2]
+			+ osc4Output.outputs[i] * mixGain[3];
+	}
 	
-	// --- Process through filter
-	moogFilter->processSynthAudio(&audioData);
-	// --- inline, copy MONO output back to input
-	audioData.inputs[0] = audioData.outputs[0];
-	audioData.numOutputChannels = 2;// stereo out
+	// --- Process through filter; both channels run in one pass
+	processFilterSection(&audioData);
+	// --- inline, copy output back to input
+	audioData.inputs[LEFT_CHANNEL] = audioData.outputs[LEFT_CHANNEL];
+	audioData.inputs[RIGHT_CHANNEL] = audioData.outputs[RIGHT_CHANNEL];
 
-	// --- dca will make stereo and pan
+	// --- dca applies the gain and pans
 	dca->processSynthAudio(&audioData);
 
 	// --- check for note off condition
@@ -287,8 +313,8 @@ const SynthRenderData SynthVoice::renderAudioOutput()
 	synthOutputData.channelCount = 2;
 
 	// --- summation for the simple core
-	synthOutputData.synthOutputs[0] = audioData.outputs[1];
-	synthOutputData.synthOutputs[1] = audioData.outputs[1];
+	synthOutputData.synthOutputs[0] = audioData.outputs[LEFT_CHANNEL];
+	synthOutputData.synthOutputs[1] = audioData.outputs[RIGHT_CHANNEL];
 
 	// - USE THESE TO TEST MODULATIONS
 	//synthOutputData.synthOutputs[0] = lfo1Output.modulationOutputs[kLFONormalOutput];
@@ -301,10 +327,167 @@ const SynthRenderData SynthVoice::renderAudioOutput()
 	return synthOutputData;
 }
 
+/**
+\brief Render a run of frames for the engine's block path; may run on a worker thread, so it
+only touches this voice and reads the shared parameters and MIDI data
+
+\param left, right voice outputs, numFrames long
+\param lfo1Block, lfo2Block, rotorBlock the engine's global modulator outputs, one per frame
+
+\return the number of frames rendered; the voice went idle after the last one
+*/
+uint32_t SynthVoice::renderAudioBlock(double* left, double* right, uint32_t numFrames,
+	const ModOutputData* lfo1Block, const ModOutputData* lfo2Block, const ModOutputData* rotorBlock)
+{
+	// --- point the global outputs at each frame of the blocks, then back at the engine's
+	const ModOutputData* engineLFO1Output = globalLFO1Output;
+	const ModOutputData* engineLFO2Output = globalLFO2Output;
+	const ModOutputData* engineRotorOutput = globalRotorOutput;
+
+	uint32_t frame = 0;
+	for (; frame < numFrames && voiceIsRunning; frame++)
+	{
+		globalLFO1Output = &lfo1Block[frame];
+		globalLFO2Output = &lfo2Block[frame];
+		globalRotorOutput = &rotorBlock[frame];
+
+		const SynthRenderData render = renderAudioOutput();
+		left[frame] = render.synthOutputs[0];
+		right[frame] = render.synthOutputs[1];
+	}
+
+	globalLFO1Output = engineLFO1Output;
+	globalLFO2Output = engineLFO2Output;
+	globalRotorOutput = engineRotorOutput;
+
+	return frame;
+}
+
+// --- the FM matrix uses each modulator's previous output, so the oscillators can modulate each
+//     other in any order; feedback uses the average of the last two, which keeps it from
+//     ringing at Nyquist
+void SynthVoice::renderOscillators(bool updateAllModRoutings)
+{
+	// --- check for a matrix at the update rate; when it goes off, so do the phase offsets
+	if (updateAllModRoutings)
+	{
+		bool phaseModActive = false;
+		for (uint32_t modulator = 0; modulator < kNumVoiceOscillators; modulator++)
+			for (uint32_t carrier = 0; carrier < kNumVoiceOscillators; carrier++)
+				phaseModActive |= parameters->oscPhaseModMatrix[modulator][carrier] != 0.0;
+
+		if (!phaseModActive && oscPhaseModActive)
+		{
+			for (uint32_t i = 0; i < kNumVoiceOscillators; i++)
+				*oscPhaseModInput[i] = 0.0;
+		}
+		oscPhaseModActive = phaseModActive;
+	}
+
+	if (oscPhaseModActive)
+	{
+		double phaseMod[kNumVoiceOscillators] = { 0.0 };
+		for (uint32_t modulator = 0; modulator < kNumVoiceOscillators; modulator++)
+		{
+			double lastOutput = oscPhaseModHistory[modulator][0];
+			double feedbackOutput = 0.5 * (lastOutput + oscPhaseModHistory[modulator][1]);
+
+			for (uint32_t carrier = 0; carrier < kNumVoiceOscillators; carrier++)
+				phaseMod[carrier] += parameters->oscPhaseModMatrix[modulator][carrier] * (carrier == modulator ? feedbackOutput : lastOutput);
+		}
+
+		for (uint32_t i = 0; i < kNumVoiceOscillators; i++)
+			*oscPhaseModInput[i] = phaseMod[i];
+	}
+
+	osc1Output = osc1->renderAudioOutput();
+	osc2Output = osc2->renderAudioOutput();
+	osc3Output = osc3->renderAudioOutput();
+	osc4Output = osc4->renderAudioOutput();
+
+	if (oscPhaseModActive)
+	{
+		const OscillatorOutputData* oscOutputs[kNumVoiceOscillators] = { &osc1Output, &osc2Output, &osc3Output, &osc4Output };
+		for (uint32_t i = 0; i < kNumVoiceOscillators; i++)
+		{
+			oscPhaseModHistory[i][1] = oscPhaseModHistory[i][0];
+			oscPhaseModHistory[i][0] = 0.5 * (oscOutputs[i]->outputs[0] + oscOutputs[i]->outputs[1]);
+		}
+	}
+}
+
+// --- the filter runs at the oversampled rate; changing the ratio resets it
+void SynthVoice::setOversamplingRatio(uint32_t ratio)
+{
+	if (ratio != 2 && ratio != 4)
+		ratio = 1;
+
+	if (ratio == filterOversampling || sampleRate <= 0.0)
+		return;
+
+	filterOversampling = ratio;
+	moogFilter->reset(sampleRate * filterOversampling);
+
+	if (filterOversampling > 1)
+	{
+		for (uint32_t i = 0; i < 2; i++)
+		{
+			filterInterpolator[i].initialize(filterOversampling);
+			filterDecimator[i].initialize(filterOversampling);
+		}
+	}
+}
+
+// --- oscillator mix in, filtered and saturated out, one or two channels; the filter's self
+//     oscillation and the saturation are the parts that alias, so only they run at the
+//     oversampled rate
+void SynthVoice::processFilterSection(SynthProcessorData* audioData)
+{
+	const double saturation = parameters->filterSaturation;
+	const uint32_t numChannels = audioData->numInputChannels > 1 ? 2 : 1;
+
+	if (filterOversampling == 1)
+	{
+		moogFilter->processSynthAudio(audioData);
+		if (saturation > 0.0)
+		{
+			for (uint32_t ch = 0; ch < numChannels; ch++)
+				audioData->outputs[ch] = tanhWaveShaper(audioData->outputs[ch], saturation);
+		}
+		return;
+	}
+
+	double oversampledAudio[2][kMaxOversamplingRatio];
+	for (uint32_t ch = 0; ch < numChannels; ch++)
+		filterInterpolator[ch].interpolateAudio(audioData->inputs[ch], oversampledAudio[ch]);
+
+	SynthProcessorData& oversampledData = oversampledAudioData;
+	oversampledData.numInputChannels = numChannels;
+	oversampledData.numOutputChannels = numChannels;
+	for (uint32_t i = 0; i < filterOversampling; i++)
+	{
+		for (uint32_t ch = 0; ch < numChannels; ch++)
+			oversampledData.inputs[ch] = oversampledAudio[ch][i];
+
+		moogFilter->processSynthAudio(&oversampledData);
+
+		for (uint32_t ch = 0; ch < numChannels; ch++)
+		{
+			oversampledAudio[ch][i] = oversampledData.outputs[ch];
+			if (saturation > 0.0)
+				oversampledAudio[ch][i] = tanhWaveShaper(oversampledAudio[ch][i], saturation);
+		}
+	}
+
+	for (uint32_t ch = 0; ch < numChannels; ch++)
+		audioData->outputs[ch] = filterDecimator[ch].decimateAudio(oversampledAudio[ch]);
+}
+
 bool SynthVoice::doNoteOn(midiEvent& event)
 {
 	// --- calculate MIDI -> pitch value
-	double midiPitch = midiNoteNumberToOscFrequency(event.midiData1) * pow(2.0, parameters->voiceUnisonDetune_Cents / 1200.0);
+	// --- voice unison stashes this voice's detune (cents) in the event's aux data
+	double midiPitch = midiNoteNumberToOscFrequency(event.midiData1) * pow(2.0, (parameters->voiceUnisonDetune_Cents + event.auxDoubleData1) / 1200.0);
 	
 	// --- OR lookup midiFreqTable[event.midiData1];
 	//        double midiPitch = midiFreqTable[event.midiData1];
@@ -327,6 +510,9 @@ bool SynthVoice::doNoteOn(midiEvent& event)
 	// --- send to dca
 	dca->doNoteOn(midiPitch, event.midiData1, event.midiData2);
 
+	// --- FM starts from rest
+	memset(oscPhaseModHistory, 0, sizeof(oscPhaseModHistory));
+
 	//  EGs
 	ampEG->doNoteOn(midiPitch, event.midiData1, event.midiData2);
 	EG2->doNoteOn(midiPitch, event.midiData1, event.midiData2);
@@ -402,6 +588,13 @@ bool SynthVoice::processMIDIEvent(midiEvent& event)
 }
 
 SynthEngine::SynthEngine()
+	: SynthEngine(std::make_shared<WaveTableData>(), std::make_shared<WaveSampleData>())
+{
+}
+
+SynthEngine::SynthEngine(std::shared_ptr<WaveTableData> _waveTableData, std::shared_ptr<WaveSampleData> _waveSampleData)
+	: waveTableData(_waveTableData)
+	, waveSampleData(_waveSampleData)
 {
 	// --- this is recommended by the MIDI Manufacturer's Asssociation to force a reset
 	//     so that the state is known
@@ -464,11 +657,19 @@ SynthEngine::SynthEngine()
 		// --- reset is the constructor for this kind of smartpointer
 		//
 		//     Pass our this pointer for the IMIDIData interface - safe
-		synthVoices[i].reset(new SynthVoice(midiInputData, midiOutputData, parameters.voiceParameters, waveTableData));
+		synthVoices[i].reset(new SynthVoice(midiInputData, midiOutputData, parameters.voiceParameters, waveTableData, waveSampleData));
 
 		// --- pass safe pointer to voices to share the common matrix core
 		synthVoices[i]->setModMatrixPtrs(parameters.modSourceData, parameters.modDestinationData);
 	}
+
+	// --- global modulators share the voice parameters, so the same GUI controls drive them
+	globalLFO1.reset(new SynthLFO(midiInputData, parameters.voiceParameters->lfo1Parameters));
+	globalLFO2.reset(new SynthLFO(midiInputData, parameters.voiceParameters->lfo2Parameters));
+	globalRotor.reset(new WankelRotor(midiInputData, parameters.voiceParameters->rotorParameters));
+
+	for (unsigned int i = 0; i < MAX_VOICES; i++)
+		synthVoices[i]->setGlobalModulatorOutputs(&globalLFO1Output, &globalLFO2Output, &globalRotorOutput);
 }
 
 /**
@@ -488,18 +689,47 @@ bool SynthEngine::reset(double _sampleRate)
 	{
 		// --- smart poitner access looks normal (->) 
 		synthVoices[i]->reset(_sampleRate); // this calls reset() on the smart-pointers underlying naked pointer
+
+		// --- each voice gets its own noise stream
+		synthVoices[i]->seedNoise(deriveNoiseSeed(parameters.noiseSeed, i));
 	}
 
-	// --- create FX
-	// add more here
+	// --- global modulators; streams after the voices'
+	globalLFO1->reset(_sampleRate);
+	globalLFO2->reset(_sampleRate);
+	globalRotor->reset(_sampleRate);
+	globalLFO1->seedNoise(deriveNoiseSeed(parameters.noiseSeed, MAX_VOICES));
+	globalLFO2->seedNoise(deriveNoiseSeed(parameters.noiseSeed, MAX_VOICES + 1));
+	globalRotor->seedNoise(deriveNoiseSeed(parameters.noiseSeed, MAX_VOICES + 2));
+	globalLFO1Output.clear();
+	globalLFO2Output.clear();
+	globalRotorOutput.clear();
+	globalGranularityCounter = -1;
+
+	// --- master FX
+	masterFX.reset(_sampleRate);
+
+	// --- block rendering
+	numQueuedMIDIEvents = 0;
+	nextQueuedMIDIEvent = 0;
+	blockLeft = nullptr;
+	blockRight = nullptr;
 
 	return true;
 }
 
 bool SynthEngine::initialize(PluginInfo pluginInfo)
 { 
-	// --- parse wavesamples
+	// --- parse wavesamples: each folder in <DLL folder>/samples is a set; only the heads are
+	//     decoded here, the rest streams from disk
 	std::string targetFolder = pluginInfo.pathToDLL;
+#if defined _WINDOWS || defined _WINDLL
+	waveSampleData->createSampleSets(targetFolder + "\\samples");
+#else
+	waveSampleData->createSampleSets(targetFolder + "/samples");
+#endif
+	for (auto& loadError : waveSampleData->getLoadErrors())
+		TRACE("-- Sample not loaded: %s \n", loadError.c_str());
 
 	// --- loop
 	for (unsigned int i = 0; i < MAX_VOICES; i++)
@@ -533,6 +763,39 @@ std::vector<std::string> SynthEngine::getBankNames(uint32_t voiceIndex, uint32_t
 	return synthVoices[voiceIndex]->getBankNames(oscillatorIndex);
 }
 
+void SynthEngine::processMasterFX(float** outputs, uint32_t numChannels, uint32_t numFrames)
+{
+	if (!masterFX.isActive() || !outputs || numChannels == 0)
+		return;
+
+	// --- mono outputs run the chain on a dual-mono pair and keep the left
+	bool stereo = numChannels > 1;
+	float* left = outputs[0];
+	float* right = stereo ? outputs[1] : outputs[0];
+
+	for (uint32_t frame = 0; frame < numFrames; frame += kMasterFXBlockSize)
+	{
+		uint32_t blockSize = numFrames - frame;
+		if (blockSize > kMasterFXBlockSize)
+			blockSize = kMasterFXBlockSize;
+
+		for (uint32_t i = 0; i < blockSize; i++)
+		{
+			masterFXLeft[i] = left[frame + i];
+			masterFXRight[i] = right[frame + i];
+		}
+
+		masterFX.processAudioBlock(masterFXLeft, masterFXRight, blockSize);
+
+		for (uint32_t i = 0; i < blockSize; i++)
+		{
+			left[frame + i] = (float)masterFXLeft[i];
+			if (stereo)
+				right[frame + i] = (float)masterFXRight[i];
+		}
+	}
+}
+
 const SynthRenderData SynthEngine::renderAudioOutput()
 {
 	// --- clear accumumlators
@@ -543,9 +806,12 @@ const SynthRenderData SynthEngine::renderAudioOutput()
 
 	// --- -12dB per active channel to avoid clipping
 	double gainFactor = 0.25; 
-	if (parameters.mode == SynthMode::kUnison)
+	if (voiceUnison)
 		gainFactor = 0.125;
 
+	// --- once for all voices
+	renderGlobalModulators();
+
 	// --- loop through voices and render/accumulate them
 	for (unsigned int i = 0; i < MAX_VOICES; i++)
 	{
@@ -577,6 +843,249 @@ const SynthRenderData SynthEngine::renderAudioOutput()
 	return synthOutputData;
 }
 
+/**
+\brief Open a buffer for block rendering; the events queued from here on render into it
+
+\param left, right outputs; right may be nullptr (mono)
+\param numFrames frames in the buffer
+*/
+void SynthEngine::beginAudioBlock(float* left, float* right, uint32_t numFrames)
+{
+	blockLeft = left;
+	blockRight = right;
+	blockFrames = left ? numFrames : 0;
+	blockFrame = 0;
+}
+
+/**
+\brief Queue a MIDI event for renderAudioBlock( ); events must arrive in frame order
+
+Operation:
+- a full queue is emptied first: the open buffer is rendered up to this frame and the queued
+  events fire, exactly as renderAudioBlock( ) would have done; with no buffer open they fire now
+
+\param event the MIDI event
+\param frame buffer frame to fire it at
+*/
+void SynthEngine::queueMIDIEvent(midiEvent& event, uint32_t frame)
+{
+	if (numQueuedMIDIEvents >= kMaxQueuedMIDIEvents)
+	{
+		renderBlockTo(frame);
+		fireQueuedMIDIEvents();
+	}
+
+	queuedMIDIEvents[numQueuedMIDIEvents] = event;
+	queuedMIDIEvents[numQueuedMIDIEvents].midiSampleOffset = frame;
+	numQueuedMIDIEvents++;
+}
+
+/**
+\brief Render the rest of the open buffer: the same output as calling processMIDIEvent( ) and
+renderAudioOutput( ) frame by frame, with the voices rendered on the voice worker pool
+
+Operation:
+- fire the events due at the current frame
+- render up to the next event frame, at most kVoiceRenderFrames at a time
+- events stamped past the end fire at the end of the buffer
+*/
+void SynthEngine::renderAudioBlock()
+{
+	renderBlockTo(blockFrames);
+	fireQueuedMIDIEvents();
+
+	blockLeft = nullptr;
+	blockRight = nullptr;
+}
+
+/**
+\brief Render a buffer whose events are already queued
+
+\param left, right outputs; right may be nullptr (mono)
+\param numFrames frames to render
+*/
+void SynthEngine::renderAudioBlock(float* left, float* right, uint32_t numFrames)
+{
+	beginAudioBlock(left, right, numFrames);
+	renderAudioBlock();
+}
+
+/**
+\brief Render the open buffer from where it was left up to endFrame, firing the queued events
+due on the way; the events at endFrame itself are left queued
+*/
+void SynthEngine::renderBlockTo(uint32_t endFrame)
+{
+	if (!blockLeft)
+		return;
+
+	if (endFrame > blockFrames)
+		endFrame = blockFrames;
+
+	while (blockFrame < endFrame)
+	{
+		while (nextQueuedMIDIEvent < numQueuedMIDIEvents && queuedMIDIEvents[nextQueuedMIDIEvent].midiSampleOffset <= blockFrame)
+		{
+			processMIDIEvent(queuedMIDIEvents[nextQueuedMIDIEvent]);
+			nextQueuedMIDIEvent++;
+		}
+
+		uint32_t segmentEnd = endFrame;
+		if (nextQueuedMIDIEvent < numQueuedMIDIEvents && queuedMIDIEvents[nextQueuedMIDIEvent].midiSampleOffset < segmentEnd)
+			segmentEnd = queuedMIDIEvents[nextQueuedMIDIEvent].midiSampleOffset;
+		if (segmentEnd - blockFrame > kVoiceRenderFrames)
+			segmentEnd = blockFrame + kVoiceRenderFrames;
+
+		renderSegment(blockLeft + blockFrame, blockRight ? blockRight + blockFrame : nullptr, segmentEnd - blockFrame);
+		blockFrame = segmentEnd;
+	}
+}
+
+/**
+\brief Fire whatever is left in the queue and empty it
+*/
+void SynthEngine::fireQueuedMIDIEvents()
+{
+	while (nextQueuedMIDIEvent < numQueuedMIDIEvents)
+	{
+		processMIDIEvent(queuedMIDIEvents[nextQueuedMIDIEvent]);
+		nextQueuedMIDIEvent++;
+	}
+
+	numQueuedMIDIEvents = 0;
+	nextQueuedMIDIEvent = 0;
+}
+
+/**
+\brief Render a run of frames with no MIDI events inside it
+*/
+void SynthEngine::renderSegment(float* left, float* right, uint32_t numFrames)
+{
+	// --- the global modulators run every frame, sounding or not, as in renderAudioOutput( )
+	for (uint32_t i = 0; i < numFrames; i++)
+	{
+		renderGlobalModulators();
+		globalLFO1Block[i] = globalLFO1Output;
+		globalLFO2Block[i] = globalLFO2Output;
+		globalRotorBlock[i] = globalRotorOutput;
+	}
+
+	// --- voices only change state at events, so the active set holds for the segment
+	numSegmentVoices = 0;
+	for (unsigned int i = 0; i < MAX_VOICES; i++)
+	{
+		if (synthVoices[i]->isVoiceActive())
+			segmentVoices[numSegmentVoices++] = i;
+	}
+
+	// --- two chunks per thread leaves the early finishers something to steal
+	segmentFrames = numFrames;
+	numVoiceJobs = numSegmentVoices;
+	if (numVoiceJobs > 2 * (voicePool.getNumWorkers() + 1))
+		numVoiceJobs = 2 * (voicePool.getNumWorkers() + 1);
+	voicePool.runJobs(&SynthEngine::renderVoiceJob, this, numVoiceJobs);
+
+	// --- same gain, order and master volume as renderAudioOutput( )
+	double gainFactor = voiceUnison ? 0.125 : 0.25;
+	double masterVol = midi14_bitToDouble(midiInputData->globalMIDIData[kMIDIMasterVolumeLSB], midiInputData->globalMIDIData[kMIDIMasterVolumeMSB], 0.001, 4.0);
+
+	for (uint32_t i = 0; i < numFrames; i++)
+	{
+		double outputs[2] = { 0.0, 0.0 };
+		for (uint32_t v = 0; v < numSegmentVoices; v++)
+		{
+			uint32_t voice = segmentVoices[v];
+			if (i >= voiceBlockFrames[voice])
+				continue;
+
+			outputs[LEFT_CHANNEL] += gainFactor * voiceBlock[voice][0][i];
+			outputs[RIGHT_CHANNEL] += gainFactor * voiceBlock[voice][1][i];
+		}
+
+		left[i] = (float)(outputs[LEFT_CHANNEL] * masterVol);
+		if (right)
+			right[i] = (float)(outputs[RIGHT_CHANNEL] * masterVol);
+	}
+}
+
+/**
+\brief One job of renderSegment( ): a contiguous chunk of the segment's active voices
+*/
+void SynthEngine::renderVoiceJob(void* context, uint32_t job)
+{
+	SynthEngine* engine = (SynthEngine*)context;
+
+	uint32_t firstVoice = engine->numSegmentVoices * job / engine->numVoiceJobs;
+	uint32_t lastVoice = engine->numSegmentVoices * (job + 1) / engine->numVoiceJobs;
+	for (uint32_t v = firstVoice; v < lastVoice; v++)
+	{
+		uint32_t voice = engine->segmentVoices[v];
+		engine->voiceBlockFrames[voice] = engine->synthVoices[voice]->renderAudioBlock(
+			engine->voiceBlock[voice][0], engine->voiceBlock[voice][1], engine->segmentFrames,
+			engine->globalLFO1Block, engine->globalLFO2Block, engine->globalRotorBlock);
+	}
+}
+
+/**
+\brief Render the LFOs and rotor flagged as global, once for all voices; the voices copy
+these outputs instead of running their own
+*/
+void SynthEngine::renderGlobalModulators()
+{
+	std::shared_ptr<SynthVoiceParameters> voiceParameters = parameters.voiceParameters;
+
+	// --- run the granularity counter, as in SynthVoice::needsComponentUpdate( )
+	bool updateAllModRoutings = globalGranularityCounter < 0;
+	globalGranularityCounter++;
+	if (globalGranularityCounter == (int)globalUpdateGranularity)
+	{
+		globalGranularityCounter = 0;
+		updateAllModRoutings = true;
+	}
+
+	// --- same output masks as the voices' own LFOs, rescanned on the update ticks
+	if (voiceParameters->lfo1Parameters->globalLFO)
+	{
+		if (updateAllModRoutings)
+			globalLFO1->setOutputMask(getRoutedLFOOutputs(*parameters.modDestinationData, kLFO1_Normal, kLFO1_QuadPhase));
+		globalLFO1->update(updateAllModRoutings);
+		globalLFO1Output = globalLFO1->renderModulatorOutput();
+	}
+
+	if (voiceParameters->lfo2Parameters->globalLFO)
+	{
+		if (updateAllModRoutings)
+			globalLFO2->setOutputMask(getRoutedLFOOutputs(*parameters.modDestinationData, kLFO2_Normal, kLFO2_QuadPhase));
+		globalLFO2->update(updateAllModRoutings);
+		globalLFO2Output = globalLFO2->renderModulatorOutput();
+	}
+
+	if (voiceParameters->rotorParameters->globalRotor)
+	{
+		globalRotor->update(updateAllModRoutings);
+		globalRotorOutput = globalRotor->renderModulatorOutput();
+	}
+}
+
+/**
+\brief Note-on for the global modulators: they are shared, so only the first note of a phrase
+(no voices sounding) restarts them; later notes join the running LFO
+*/
+void SynthEngine::startGlobalModulators(midiEvent& event)
+{
+	for (unsigned int i = 0; i < MAX_VOICES; i++)
+	{
+		if (synthVoices[i]->isVoiceActive())
+			return;
+	}
+
+	double midiPitch = midiNoteNumberToOscFrequency(event.midiData1);
+	globalLFO1->doNoteOn(midiPitch, event.midiData1, event.midiData2);
+	globalLFO2->doNoteOn(midiPitch, event.midiData1, event.midiData2);
+	globalRotor->doNoteOn(midiPitch, event.midiData1, event.midiData2);
+	globalGranularityCounter = -1;
+}
+
 /**
 \brief The MIDI event handler function; for note on/off messages it finds the voices to turn on/off.
 MIDI CC information is placed in the shared CC array.
@@ -599,8 +1108,23 @@ bool SynthEngine::processMIDIEvent(midiEvent& event)
 		TRACE("-- Note On Ch:%d Note:%d Vel:%d \n", event.midiChannel, event.midiData1, event.midiData2);
 		TRACE("-- LAST Note On Note:%d \n", event.auxUintData1);
 
-		// --- mono mode
-		if (parameters.mode == SynthMode::kMono)
+		// --- first note of a phrase starts the global modulators
+		startGlobalModulators(event);
+
+		// --- voice unison: voices 0-3 detuned around the note, the detune rides in the event
+		//     so that a voice being stolen picks it up when it restarts
+		if (voiceUnison)
+		{
+			const double unisonDetune[4] = { 0.707, 1.0, -1.0, 0.0 };
+			for (uint32_t i = 0; i < 4 && i < MAX_VOICES; i++)
+			{
+				midiEvent unisonEvent = event;
+				unisonEvent.auxDoubleData1 = unisonDetune[i] * parameters.masterUnisonDetune_Cents;
+				synthVoices[i]->processMIDIEvent(unisonEvent);
+			}
+		}
+		// --- mono and unison modes; the oscillators render the unison copies inside voice 0
+		else if (parameters.mode == SynthMode::kMono || parameters.mode == SynthMode::kUnison)
 		{
 			// --- just use voice 0 and do the note EG variables will handle the rest
 			synthVoices[0]->processMIDIEvent(event);
@@ -632,31 +1156,6 @@ bool SynthEngine::processMIDIEvent(midiEvent& event)
 					synthVoices[i]->incrementTimestamp();
 			}
 		}
-		else if (parameters.mode == SynthMode::kUnison)
-		{
-			// --- UNISON mode is heavily dependent on the manufacturer's 
-			//     implementation and decision
-			//     for the synth core, we will use 3 voices detuned as: -parameters.unisonDetune_Cents, 0, +parameters.unisonDetune_Cents
-			// NEEDS detune and pan in order to be implementing the Unison
-
-			parameters.voiceParameters->voiceUnisonDetune_Cents = 0.707*parameters.masterUnisonDetune_Cents;
-			parameters.voiceParameters->dcaParameters->panValue = -0.5;
-			synthVoices[0]->processMIDIEvent(event);
-
-			parameters.voiceParameters->voiceUnisonDetune_Cents = parameters.masterUnisonDetune_Cents;
-			parameters.voiceParameters->dcaParameters->panValue = -1.0;
-			synthVoices[1]->processMIDIEvent(event);
-
-			parameters.voiceParameters->voiceUnisonDetune_Cents = -parameters.masterUnisonDetune_Cents;
-			parameters.voiceParameters->dcaParameters->panValue = 1.0;
-			synthVoices[2]->processMIDIEvent(event);
-
-			parameters.voiceParameters->voiceUnisonDetune_Cents = 0.0;
-			parameters.voiceParameters->dcaParameters->panValue = 0.5;
-			synthVoices[3]->processMIDIEvent(event);
-
-			parameters.voiceParameters->dcaParameters->panValue = 0.0;
-		}
 
 		// --- need to store these for things like portamento
 		// --- store global data for note ON event: set previous note-on data
@@ -667,8 +1166,16 @@ bool SynthEngine::processMIDIEvent(midiEvent& event)
 	{
 		TRACE("-- Note Off Ch:%d Note:%d Vel:%d \n", event.midiChannel, event.midiData1, event.midiData2);
 
-		// --- for mono, we only use one voice, number [0]
-		if (parameters.mode == SynthMode::kMono)
+		// --- voice unison releases all of its voices
+		if (voiceUnison)
+		{
+			for (uint32_t i = 0; i < 4 && i < MAX_VOICES; i++)
+				synthVoices[i]->processMIDIEvent(event);
+
+			return true;
+		}
+		// --- for mono and unison, we only use one voice, number [0]
+		else if (parameters.mode == SynthMode::kMono || parameters.mode == SynthMode::kUnison)
 		{
 			if (synthVoices[0]->isVoiceActive())
 			{
@@ -697,16 +1204,6 @@ bool SynthEngine::processMIDIEvent(midiEvent& event)
 				TRACE("-- DID NOT FOUND NOTE OFF index:%d \n", voiceIndex);
 			// --- this is very bad - it means we probably have a stuck note... :\
 
-			return true;
-		}
-		else if (parameters.mode == SynthMode::kUnison)
-		{
-			// --- this will get complicated with voice stealing.
-			synthVoices[0]->processMIDIEvent(event);
-			synthVoices[1]->processMIDIEvent(event);
-			synthVoices[2]->processMIDIEvent(event);
-			synthVoices[3]->processMIDIEvent(event);
-
 			return true;
 		}
 	}
@@ -758,6 +1255,9 @@ void SynthEngine::setParameters(const SynthEngineParameters& _parameters)
 	// --- store parameters
 	parameters = _parameters;
 
+	// --- master FX settings are latched here, once per buffer
+	masterFX.setParameters(parameters.masterFXParameters);
+
 	// --- master volume maps to MIDI RPN see http://www.somascape.org/midi/tech/spec.html#usx7F0401
 	double masterVolumeRaw = dB2Raw(parameters.masterVolume_dB);
 	boundValue(masterVolumeRaw, 0.001, 4.0);
@@ -798,51 +1298,33 @@ void SynthEngine::setParameters(const SynthEngineParameters& _parameters)
 	// --- map -8192 -> 8191 to MIDI 14-bit
 	bipolarIntToMIDI14_bit(mtFine, -8192, 8191, midiInputData->globalMIDIData[kMIDIMasterTuneFineLSB], midiInputData->globalMIDIData[kMIDIMasterTuneFineMSB]);
 
-	// --- now trickle down the voice parameters
-	for (unsigned int i = 0; i < MAX_VOICES; i++)
+	// --- unison is rendered inside the wavetable oscillators; the sample oscillator streams one
+	//     read position, so with one in the patch the engine detunes voices 0-3 instead
+	bool unison = parameters.mode == SynthMode::kUnison || (parameters.mode == SynthMode::kPoly && parameters.enablePolyUnison);
+
+	std::shared_ptr<SynthOscParameters> oscParameters[4] = { parameters.voiceParameters->osc1Parameters,
+															  parameters.voiceParameters->osc2Parameters,
+															  parameters.voiceParameters->osc3Parameters,
+															  parameters.voiceParameters->osc4Parameters };
+	voiceUnison = false;
+	for (auto& oscParameter : oscParameters)
 	{
-		if (synthVoices[i]->isVoiceActive())
-		{
-			// -- note the special handling for unison mode - you could probably
-			//    clean this up
-			/*if (parameters.mode == SynthMode::kUnison)
-			{	
-				if (i == 0)
-				{
-					parameters.voiceParameters->voiceUnisonDetune_Cents = 0.0;
-					parameters.voiceParameters->dcaParameters->panValue = 0.5;
-				}
-				else if (i == 1)
-				{
-					parameters.voiceParameters->voiceUnisonDetune_Cents = parameters.masterUnisonDetune_Cents;
-					parameters.voiceParameters->dcaParameters->panValue = -1.0;
-				}
-				else if (i == 2)
-				{
-					parameters.voiceParameters->voiceUnisonDetune_Cents = -parameters.masterUnisonDetune_Cents;
-					parameters.voiceParameters->dcaParameters->panValue = 1.0;
-				}
-				else if (i == 3)
-				{
-					parameters.voiceParameters->voiceUnisonDetune_Cents = 0.707*parameters.masterUnisonDetune_Cents;
-					parameters.voiceParameters->dcaParameters->panValue = -0.5;
-				}
-			}
-			else
-			{
-				parameters.voiceParameters->voiceUnisonDetune_Cents = 0.0;
-				parameters.voiceParameters->dcaParameters->panValue = 0.0;
-			}*/
-			
-			// the stuff above didn't make sense to me... I'll set unisonDetunes in the doNoteOn instead of setParameters
-			if (parameters.mode != SynthMode::kUnison)
-			{
-				parameters.voiceParameters->voiceUnisonDetune_Cents = 0.0;
-				parameters.voiceParameters->dcaParameters->panValue = 0.0;
-			}
+		if (unison && oscParameter->oscType == SynthOscType::kWaveSample)
+			voiceUnison = true;
+	}
 
-		}
+	uint32_t unisonVoices = 1;
+	if (unison && !voiceUnison)
+		unisonVoices = parameters.masterUnisonVoices;
+
+	for (auto& oscParameter : oscParameters)
+	{
+		oscParameter->unisonVoices = unisonVoices;
+		oscParameter->unisonSpreadCents = parameters.masterUnisonDetune_Cents;
 	}
+
+	parameters.voiceParameters->voiceUnisonDetune_Cents = 0.0;
+	parameters.voiceParameters->dcaParameters->panValue = 0.0;
 }
 
 // --- find the first free voice
@@ -11,6 +11,9 @@
 #include "synthlfo.h"
 #include "dca_eg.h"
 #include "wankelrotor.h"
+#include "oversampler.h"
+#include "masterfx.h"
+#include "synthworkerpool.h"
 
 #include <array>
 
@@ -79,11 +82,20 @@ enum modDestination
 	kShapeX,
 	kShapeY,
 
+	// --- wavetable morph location (morphing oscillators only)
+	kOsc1_Morph,
+	kOsc2_Morph,
+	kOsc3_Morph,
+	kOsc4_Morph,
+
 	// --- remain last, will always be the size of modulator array
 	kNumModDestinations
 };
 
 
+// --- pitched oscillators per voice
+const uint32_t kNumVoiceOscillators = 4;
+
 /**
 \struct SynthVoiceParameters
 \ingroup SynthStructures
@@ -108,6 +120,9 @@ struct SynthVoiceParameters
 		legatoMode = params.legatoMode;
 		freeRunOscMode = params.freeRunOscMode;
 		voiceUnisonDetune_Cents = params.voiceUnisonDetune_Cents;
+		memcpy(oscPhaseModMatrix, params.oscPhaseModMatrix, sizeof(oscPhaseModMatrix));
+		oversamplingRatio = params.oversamplingRatio;
+		filterSaturation = params.filterSaturation;
 
 		osc1Parameters = params.osc1Parameters;
 		osc2Parameters = params.osc2Parameters;
@@ -131,6 +146,50 @@ struct SynthVoiceParameters
 		return *this;
 	}
 
+	// --- operator= shares the component structures; this copies their contents instead, so
+	//     the voices that hold our pointers pick up the new values (presets, multi-part)
+	void copyParameterValues(const SynthVoiceParameters& params)
+	{
+		if (this == &params)
+			return;
+
+		SynthVoiceParameters ownStructures = *this;
+		std::shared_ptr<SynthLFOParameters> rotorLFO1 = rotorParameters->lfo1Parameters;
+		std::shared_ptr<SynthLFOParameters> rotorLFO2 = rotorParameters->lfo2Parameters;
+
+		// --- scalars
+		*this = params;
+		osc1Parameters = ownStructures.osc1Parameters;
+		osc2Parameters = ownStructures.osc2Parameters;
+		osc3Parameters = ownStructures.osc3Parameters;
+		osc4Parameters = ownStructures.osc4Parameters;
+		dcaParameters = ownStructures.dcaParameters;
+		lfo1Parameters = ownStructures.lfo1Parameters;
+		lfo2Parameters = ownStructures.lfo2Parameters;
+		rotorParameters = ownStructures.rotorParameters;
+		ampEGParameters = ownStructures.ampEGParameters;
+		EG2Parameters = ownStructures.EG2Parameters;
+		moogFilterParameters = ownStructures.moogFilterParameters;
+
+		// --- structures
+		*osc1Parameters = *params.osc1Parameters;
+		*osc2Parameters = *params.osc2Parameters;
+		*osc3Parameters = *params.osc3Parameters;
+		*osc4Parameters = *params.osc4Parameters;
+		*dcaParameters = *params.dcaParameters;
+		*lfo1Parameters = *params.lfo1Parameters;
+		*lfo2Parameters = *params.lfo2Parameters;
+		*ampEGParameters = *params.ampEGParameters;
+		*EG2Parameters = *params.EG2Parameters;
+		*moogFilterParameters = *params.moogFilterParameters;
+
+		*rotorParameters = *params.rotorParameters;
+		rotorParameters->lfo1Parameters = rotorLFO1;
+		rotorParameters->lfo2Parameters = rotorLFO2;
+		*rotorLFO1 = *params.rotorParameters->lfo1Parameters;
+		*rotorLFO2 = *params.rotorParameters->lfo2Parameters;
+	}
+
 	// --- portamento (glide)
 	bool enablePortamento = false;
 
@@ -146,6 +205,15 @@ struct SynthVoiceParameters
 	// --- unison Detune - each voice will be detuned differently
 	double voiceUnisonDetune_Cents = 0.0;
 
+	// --- audio rate FM (phase modulation) between the oscillators: [modulator][carrier] is the
+	//     carrier's phase offset, in cycles, per unit of modulator output; the diagonal is feedback
+	double oscPhaseModMatrix[kNumVoiceOscillators][kNumVoiceOscillators] = { { 0.0 } };
+
+	// --- oscillator mix -> filter -> saturation runs at this multiple of the sample rate:
+	//     1 (off, for live use), 2 or 4
+	uint32_t oversamplingRatio = 1;
+	double filterSaturation = 0.0;		// --- tanh drive after the filter; 0 = off
+
 	// --- GUI CONTROL INTERFACE -------------------------------- //
 	// --- pitched oscillators
 	std::shared_ptr<SynthOscParameters> osc1Parameters = std::make_shared<SynthOscParameters>();
@@ -244,6 +312,22 @@ struct ModDestination
 	bool priorityModulation = false;	// < for high-priority, e.g. FM
 };
 
+// --- SynthLFO output mask for an LFO whose normal and quad phase outputs are the given mod
+//     sources: only outputs enabled in some destination column are rendered
+inline uint32_t getRoutedLFOOutputs(const std::array<ModDestination, kNumModDestinations>& modDestinations, uint32_t normalSource, uint32_t quadPhaseSource)
+{
+	uint32_t outputMask = 0;
+	for (uint32_t col = 0; col < kNumModDestinations; col++)
+	{
+		if (modDestinations[col].channelEnable[normalSource])
+			outputMask |= 1 << kLFONormalOutput;
+		if (modDestinations[col].channelEnable[quadPhaseSource])
+			outputMask |= 1 << kLFOQuadPhaseOutput;
+	}
+
+	return outputMask;
+}
+
 
 // --- engine mode: poly, mono or unison
 enum class voiceState { kNoteOnState, kNoteOffState };
@@ -264,7 +348,8 @@ public:
 	SynthVoice(const std::shared_ptr<MidiInputData> _midiInputData, 
 				const std::shared_ptr<MidiOutputData> _midiOutputData, 
 				std::shared_ptr<SynthVoiceParameters> _parameters, 
-				std::shared_ptr<WaveTableData> _waveTableData);
+				std::shared_ptr<WaveTableData> _waveTableData,
+				std::shared_ptr<WaveSampleData> _waveSampleData);
 
 	virtual ~SynthVoice();
 
@@ -287,6 +372,28 @@ public:
 	// --- specialized getters
 	bool isVoiceActive() { return voiceIsRunning; }
 
+	// --- engine-rendered modulators, read in place of lfo1, lfo2 and rotor when their global flag is set
+	void setGlobalModulatorOutputs(const ModOutputData* _globalLFO1Output, const ModOutputData* _globalLFO2Output, const ModOutputData* _globalRotorOutput)
+	{
+		globalLFO1Output = _globalLFO1Output;
+		globalLFO2Output = _globalLFO2Output;
+		globalRotorOutput = _globalRotorOutput;
+	}
+
+	// --- renders up to numFrames into left/right, reading the engine's global modulator outputs
+	//     frame by frame from the blocks; stops when the voice goes idle and returns the
+	//     number of frames rendered
+	uint32_t renderAudioBlock(double* left, double* right, uint32_t numFrames,
+		const ModOutputData* lfo1Block, const ModOutputData* lfo2Block, const ModOutputData* rotorBlock);
+
+	// --- seeds the noise sources of every modulator in the voice, each from its own stream
+	void seedNoise(uint64_t voiceSeed)
+	{
+		lfo1->seedNoise(deriveNoiseSeed(voiceSeed, 0));
+		lfo2->seedNoise(deriveNoiseSeed(voiceSeed, 1));
+		rotor->seedNoise(deriveNoiseSeed(voiceSeed, 2));
+	}
+
 	// --- voice state
 	voiceState getVoiceState() { return voiceNoteState; }
 	
@@ -356,6 +463,10 @@ protected:
 		modDestinationData[kOsc2_fo] = &(osc2->getModulators()->modulationInputs[kBipolarMod]);
 		modDestinationData[kOsc3_fo] = &(osc3->getModulators()->modulationInputs[kBipolarMod]);
 		modDestinationData[kOsc4_fo] = &(osc4->getModulators()->modulationInputs[kBipolarMod]);
+		modDestinationData[kOsc1_Morph] = &(osc1->getModulators()->modulationInputs[kWaveMorphMod]);
+		modDestinationData[kOsc2_Morph] = &(osc2->getModulators()->modulationInputs[kWaveMorphMod]);
+		modDestinationData[kOsc3_Morph] = &(osc3->getModulators()->modulationInputs[kWaveMorphMod]);
+		modDestinationData[kOsc4_Morph] = &(osc4->getModulators()->modulationInputs[kWaveMorphMod]);
 		modDestinationData[kLFO1_fo] = &(lfo1->getModulators()->modulationInputs[kFrequencyMod]);
 		modDestinationData[kLFO2_fo] = &(lfo2->getModulators()->modulationInputs[kFrequencyMod]);
 		modDestinationData[kDCA_EGMod] = &(dca->getModulators()->modulationInputs[kEGMod]);
@@ -367,8 +478,25 @@ protected:
 		modDestinationData[kFilter1_fc] = &(moogFilter->getModulators()->modulationInputs[kBipolarMod]);
 
 		modDestinationData[kDCA_SampleHoldMod] = &(dca->getModulators()->modulationInputs[kAuxBipolarMod_1]);	// Modulating using with DCA sample and hold
+
+		// --- audio rate phase modulation bypasses the matrix above; see renderOscillators( )
+		oscPhaseModInput[0] = &(osc1->getModulators()->modulationInputs[kPhaseMod]);
+		oscPhaseModInput[1] = &(osc2->getModulators()->modulationInputs[kPhaseMod]);
+		oscPhaseModInput[2] = &(osc3->getModulators()->modulationInputs[kPhaseMod]);
+		oscPhaseModInput[3] = &(osc4->getModulators()->modulationInputs[kPhaseMod]);
 	}
 
+	// --- render osc1 - osc4 into their outputs, running the oscillator FM matrix at audio rate
+	void renderOscillators(bool updateAllModRoutings);
+
+	// --- filter and saturation, oversampled or not; one or two channels
+	void setOversamplingRatio(uint32_t ratio);
+	void processFilterSection(SynthProcessorData* audioData);
+
+	// --- the voice's stereo path; kept here so the channel arrays are not built every sample
+	SynthProcessorData voiceAudioData;
+	SynthProcessorData oversampledAudioData;
+
 	// --- arrays to hold source/destination
 	double* modSourceData[kNumModSources] = { nullptr };
 	double* modDestinationData[kNumModDestinations] = { nullptr };
@@ -388,6 +516,17 @@ protected:
 	OscillatorOutputData osc2Output;
 	OscillatorOutputData osc3Output;
 	OscillatorOutputData osc4Output;
+
+	// --- oscillator FM: each oscillator's kPhaseMod input and its last two outputs
+	double* oscPhaseModInput[kNumVoiceOscillators] = { nullptr };
+	double oscPhaseModHistory[kNumVoiceOscillators][2] = { { 0.0 } };
+	bool oscPhaseModActive = false;
+
+	// --- the oversampled filter section
+	double sampleRate = 0.0;
+	uint32_t filterOversampling = 1;
+	PolyphaseInterpolator filterInterpolator[2];
+	PolyphaseDecimator filterDecimator[2];
 	// --------------------------------------------------
 	
 	// --- per-voice stuff
@@ -411,6 +550,11 @@ protected:
 	std::unique_ptr<SynthLFO> lfo1;
 	std::unique_ptr<SynthLFO> lfo2;
 	std::unique_ptr<WankelRotor> rotor;
+
+	// --- owned by the engine; nullptr until setGlobalModulatorOutputs()
+	const ModOutputData* globalLFO1Output = nullptr;
+	const ModOutputData* globalLFO2Output = nullptr;
+	const ModOutputData* globalRotorOutput = nullptr;
 	
 	// NOTE: smart pointer means only ONE thing can hold the pointer to that object. Once no instance of the pointer exists, it deletes itself
 	// Uses overloaded equals to know when an = is being used to copy, so it knows how many times it has been copied
@@ -485,6 +629,10 @@ struct SynthEngineParameters
 		masterTuningFine = params.masterTuningFine;
 
 		masterUnisonDetune_Cents = params.masterUnisonDetune_Cents;
+		masterUnisonVoices = params.masterUnisonVoices;
+		enablePolyUnison = params.enablePolyUnison;
+		noiseSeed = params.noiseSeed;
+		masterFXParameters = params.masterFXParameters;
 	
 		// --- important! 
 		voiceParameters = params.voiceParameters;
@@ -515,6 +663,17 @@ struct SynthEngineParameters
 	// --- unison Detune - this is the max detuning value NOTE a standard (or RPN or NRPN) parameter :/
 	double masterUnisonDetune_Cents = 0.0;
 
+	// --- unison copies rendered inside each oscillator [1, kMaxUnisonVoices]; used in unison mode,
+	//     and in poly mode when enablePolyUnison is set
+	uint32_t masterUnisonVoices = 4;
+	bool enablePolyUnison = false;
+
+	// --- seed for all voice noise generators, applied on reset(); same seed -> same render
+	uint64_t noiseSeed = 0;
+
+	// --- post-voice FX chain on the summed output
+	MasterFXParameters masterFXParameters;
+
 	// --- VOICE layer parameters
 	std::shared_ptr<SynthVoiceParameters> voiceParameters = std::make_shared<SynthVoiceParameters>();
 
@@ -522,6 +681,27 @@ struct SynthEngineParameters
 	std::shared_ptr<std::array<ModSource, kNumModSources>> modSourceData = std::make_shared<std::array<ModSource, kNumModSources>>();
 	std::shared_ptr<std::array<ModDestination, kNumModDestinations>> modDestinationData = std::make_shared<std::array<ModDestination, kNumModDestinations>>();
 
+	// --- deep copy: keeps our shared structures (the voices and matrix point at them) and
+	//     copies the other set's values into them
+	void copyParameterValues(const SynthEngineParameters& params)
+	{
+		if (this == &params)
+			return;
+
+		std::shared_ptr<SynthVoiceParameters> ownVoiceParameters = voiceParameters;
+		std::shared_ptr<std::array<ModSource, kNumModSources>> ownModSourceData = modSourceData;
+		std::shared_ptr<std::array<ModDestination, kNumModDestinations>> ownModDestinationData = modDestinationData;
+
+		*this = params;
+		voiceParameters = ownVoiceParameters;
+		modSourceData = ownModSourceData;
+		modDestinationData = ownModDestinationData;
+
+		voiceParameters->copyParameterValues(*params.voiceParameters);
+		*modSourceData = *params.modSourceData;
+		*modDestinationData = *params.modDestinationData;
+	}
+
 	// --- helper functions for the mod matrix rows/cols
 	void setMM_SourceMasterIntensity(uint32_t destination, double intensity)
 	{
@@ -573,6 +753,13 @@ struct SynthEngineParameters
 };
 
 
+// --- MIDI events the engine queues for renderAudioBlock( ); when it fills, the buffer is
+//     rendered up to the next event and the queue is emptied
+const uint32_t kMaxQueuedMIDIEvents = 256;
+
+// --- voices render in segments of at most this many frames
+const uint32_t kVoiceRenderFrames = 64;
+
 /**
 \class SynthEngine
 \ingroup SynthClasses
@@ -587,14 +774,24 @@ So we have:
 
 mono->voice[0];
 
-unison using an odd # voices (ex. 0, +, -)
-with unison, pick 3 voices and set detunes and pans
+unison is rendered inside the wavetable oscillators on voice[0]; the sample oscillator streams
+one read position, so patches that use it stack voice[0] - voice[3] at different detunes instead
+(in poly unison too, so those notes play as in unison mode)
 
 
 
 Control I/F:
 Use SynthEngineModifiers structure; note that it's SynthVoiceModifiers pointer is shared across all voices
 
+Block rendering:
+renderAudioOutput( ) renders one frame. Alternatively, open the buffer with beginAudioBlock( ),
+queue its MIDI events with queueMIDIEvent( ) and render the rest with renderAudioBlock( ): the
+buffer is cut into segments at the event frames, the active voices of each segment are split into
+chunks and rendered on the voice worker pool, and the voice outputs are summed in voice order so
+the output is bit-identical to renderAudioOutput( ) no matter which thread rendered which voice.
+If the event queue fills, the open buffer is rendered up to the new event's frame and the queued
+events are fired, so no event is lost and the output does not change.
+
 \author Will Pirkle
 \version Revision : 1.0
 \date Date : 2017 / 09 / 24
@@ -605,6 +802,10 @@ public:
 	SynthEngine();
 	virtual ~SynthEngine();
 
+	// --- multi-part: engines that share wavesamples; each keeps its own WaveTableData, whose table
+	//     memory is shared through the SharedTableStore
+	SynthEngine(std::shared_ptr<WaveTableData> _waveTableData, std::shared_ptr<WaveSampleData> _waveSampleData);
+
 	// --- ISynthEngine
 	virtual bool reset(double _sampleRate);
 	virtual const SynthRenderData renderAudioOutput();
@@ -614,7 +815,7 @@ public:
 	// --- get parameters
 	SynthEngineParameters getParameters();
 
-	// --- set parameters
+	// --- set parameters; audio thread, once per buffer (the master FX objects are updated here)
 	void setParameters(const SynthEngineParameters& _parameters);
 	
 	// --- helper function to get the array index of next available voice
@@ -633,6 +834,37 @@ public:
 	// --- get the bank names
 	std::vector<std::string> getBankNames(uint32_t voiceIndex, uint32_t oscillatorIndex);
 
+	// --- runs the master FX chain in place over a whole rendered buffer; call once per buffer
+	//     after the frames are rendered; numChannels is 1 or 2
+	void processMasterFX(float** outputs, uint32_t numChannels, uint32_t numFrames);
+
+	// --- shared samples, for other engines (multi-part)
+	std::shared_ptr<WaveSampleData> getWaveSampleData() { return waveSampleData; }
+
+	// --- impulse response for the master FX convolution; non-realtime, with the audio stopped
+	bool setMasterFXImpulseResponse(const double* irLeft, const double* irRight, uint32_t length) { return masterFX.setImpulseResponse(irLeft, irRight, length); }
+	bool loadMasterFXImpulseResponse(const char* filePath) { return masterFX.loadImpulseResponse(filePath); }
+
+	// --- false computes the convolution tail on the audio thread (offline rendering); non-realtime
+	void enableMasterFXConvolutionWorker(bool enable) { masterFX.enableConvolutionWorker(enable); }
+
+	// --- block rendering; voice workers are set non-realtime, with the audio stopped, and
+	//     0 renders every voice on the audio thread
+	void setNumVoiceWorkers(uint32_t numWorkers, bool pinWorkers = true) { voicePool.setNumWorkers(numWorkers, pinWorkers); }
+	uint32_t getNumVoiceWorkers() { return voicePool.getNumWorkers(); }
+
+	// --- audio thread: open the buffer the queued events render into; right may be nullptr (mono)
+	void beginAudioBlock(float* left, float* right, uint32_t numFrames);
+
+	// --- audio thread: queue an event to fire at this buffer frame in renderAudioBlock( )
+	void queueMIDIEvent(midiEvent& event, uint32_t frame);
+
+	// --- audio thread: render the rest of the open buffer, firing the queued events
+	void renderAudioBlock();
+
+	// --- audio thread: beginAudioBlock( ) + renderAudioBlock( ) for events queued beforehand
+	void renderAudioBlock(float* left, float* right, uint32_t numFrames);
+
 protected:
 	// --- our outputs, same number as synth voice!
 	SynthRenderData synthOutputData;
@@ -640,6 +872,9 @@ protected:
 	// --- our modifiers (parameters)
 	SynthEngineParameters parameters;
 
+	// --- unison with detuned voices 0-3, for patches with a sample oscillator; set in setParameters( )
+	bool voiceUnison = false;
+
 	// --- shared MIDI tables, via IMIDIData
 	std::shared_ptr<MidiInputData> midiInputData = std::make_shared<MidiInputData>();
 	std::shared_ptr<MidiOutputData> midiOutputData = std::make_shared<MidiOutputData>();
@@ -650,9 +885,59 @@ protected:
 	// --- shared tables, in case they are huge or need a long creation time
 	std::shared_ptr<WaveTableData> waveTableData = std::make_shared<WaveTableData>();
 
-private:
-	// --- ADD FX Here...
-
+	// --- shared WAV samples and their I/O thread; sets are found in initialize( )
+	std::shared_ptr<WaveSampleData> waveSampleData = std::make_shared<WaveSampleData>();
+
+	// --- global modulators: rendered once per sample for all voices when their global flag is set;
+	//     they share the voices' parameters
+	std::unique_ptr<SynthLFO> globalLFO1;
+	std::unique_ptr<SynthLFO> globalLFO2;
+	std::unique_ptr<WankelRotor> globalRotor;
+	ModOutputData globalLFO1Output;
+	ModOutputData globalLFO2Output;
+	ModOutputData globalRotorOutput;
+
+	// --- global modulator updates on the same granularity as the voices' components
+	uint32_t globalUpdateGranularity = 64;
+	int globalGranularityCounter = -1;			///< -1 = update NOW
+
+	void renderGlobalModulators();
+	void startGlobalModulators(midiEvent& event);
+
+	// --- block rendering: this buffer's events, in frame order; midiSampleOffset is the buffer frame
+	midiEvent queuedMIDIEvents[kMaxQueuedMIDIEvents];
+	uint32_t numQueuedMIDIEvents = 0;
+	uint32_t nextQueuedMIDIEvent = 0;
+
+	// --- the open buffer and how far it has been rendered
+	float* blockLeft = nullptr;
+	float* blockRight = nullptr;
+	uint32_t blockFrames = 0;
+	uint32_t blockFrame = 0;
+
+	void renderBlockTo(uint32_t endFrame);
+	void fireQueuedMIDIEvents();
+
+	// --- the segment being rendered: global modulators per frame, then the active voices in
+	//     index order, dealt out to the jobs in contiguous chunks; each voice has its own output
+	SynthWorkerPool voicePool;
+	ModOutputData globalLFO1Block[kVoiceRenderFrames];
+	ModOutputData globalLFO2Block[kVoiceRenderFrames];
+	ModOutputData globalRotorBlock[kVoiceRenderFrames];
+	uint32_t segmentFrames = 0;
+	uint32_t segmentVoices[MAX_VOICES] = { 0 };
+	uint32_t numSegmentVoices = 0;
+	uint32_t numVoiceJobs = 0;
+	double voiceBlock[MAX_VOICES][2][kVoiceRenderFrames] = { { { 0.0 } } };
+	uint32_t voiceBlockFrames[MAX_VOICES] = { 0 };
+
+	void renderSegment(float* left, float* right, uint32_t numFrames);
+	static void renderVoiceJob(void* context, uint32_t job);
+
+	// --- master FX; parameters follow the per-buffer setParameters( ) snapshot
+	MasterFXChain masterFX;
+	double masterFXLeft[kMasterFXBlockSize] = { 0.0 };
+	double masterFXRight[kMasterFXBlockSize] = { 0.0 };
 };
 
 
@@ -167,6 +167,88 @@ inline double doPNSequence(uint32_t& uPNRegister)
 	return fOut;
 }
 
+// --- splitmix64 step: turns any seed (including 0 and consecutive integers) into a
+//     well-mixed 64-bit value; used to derive per-voice and per-component seeds
+inline uint64_t deriveNoiseSeed(uint64_t seed, uint64_t stream)
+{
+	uint64_t z = seed + (stream + 1) * 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+// --- number of independent xorshift states run side by side in NoiseGenerator::fillWhiteNoise()
+const uint32_t kNoiseGeneratorLanes = 4;
+
+/**
+\struct NoiseGenerator
+\ingroup SynthStructures
+\brief Small xorshift64* white noise generator. Each component owns one and is seeded explicitly
+by the engine, so there is no shared libc rand() state between voices or threads and an offline
+render is bit-for-bit reproducible.
+
+doWhiteNoise() steps lane 0; fillWhiteNoise() steps all kNoiseGeneratorLanes lanes together
+so the block loop vectorizes.
+*/
+struct NoiseGenerator
+{
+	NoiseGenerator() { seed(0); }
+
+	void seed(uint64_t _seed)
+	{
+		// --- xorshift must never hold 0; splitmix output is 0 for exactly one input per lane
+		for (uint32_t i = 0; i < kNoiseGeneratorLanes; i++)
+		{
+			state[i] = deriveNoiseSeed(_seed, i);
+			if (state[i] == 0)
+				state[i] = 0x9E3779B97F4A7C15ULL;
+		}
+	}
+
+	// --- raw 64-bit output
+	inline uint64_t nextRandom()
+	{
+		return nextRandom(state[0]);
+	}
+
+	// --- [-1.0, +1.0)
+	inline double doWhiteNoise()
+	{
+		return toBipolar(nextRandom(state[0]));
+	}
+
+	// --- block fill, [-1.0, +1.0); lane i writes samples i, i + kNoiseGeneratorLanes, ...
+	void fillWhiteNoise(double* buffer, uint32_t count)
+	{
+		uint32_t i = 0;
+		for (; i + kNoiseGeneratorLanes <= count; i += kNoiseGeneratorLanes)
+		{
+			for (uint32_t lane = 0; lane < kNoiseGeneratorLanes; lane++)
+				buffer[i + lane] = toBipolar(nextRandom(state[lane]));
+		}
+
+		for (uint32_t lane = 0; i < count; i++, lane++)
+			buffer[i] = toBipolar(nextRandom(state[lane]));
+	}
+
+protected:
+	uint64_t state[kNoiseGeneratorLanes] = { 0 };
+
+	static inline uint64_t nextRandom(uint64_t& x)
+	{
+		x ^= x >> 12;
+		x ^= x << 25;
+		x ^= x >> 27;
+		return x * 0x2545F4914F6CDD1DULL;
+	}
+
+	// --- top 53 bits -> [0, 1) -> [-1, +1)
+	static inline double toBipolar(uint64_t r)
+	{
+		return 2.0 * ((double)(r >> 11) * (1.0 / 9007199254740992.0)) - 1.0;
+	}
+};
+
 /**
 \struct SynthRenderData
 \ingroup SynthStructures
@@ -762,6 +844,31 @@ inline bool checkAndWrapWaveTableIndex(double& index, unsigned int tableLength)
 	return false;
 }
 
+/** hard sync: where between this sample and the next a master phase [0, 1) wraps, as a fraction
+    of the sample interval (0, 1]; 0.0 if it does not wrap. No state, so a block loop can
+    evaluate it for every sample. */
+inline double hardSyncWrapFraction(double masterPhase, double masterPhaseInc)
+{
+	if (masterPhaseInc <= 0.0 || masterPhase + masterPhaseInc < 1.0)
+		return 0.0;
+
+	return (1.0 - masterPhase) / masterPhaseInc;
+}
+
+/** 2-point polyBLEP for a step of stepHeight that happens stepFraction (0, 1] of a sample
+    interval after the current sample: add the first to the current sample and the second to
+    the next one */
+inline double polyBLEPBeforeStep(double stepHeight, double stepFraction)
+{
+	double x = 1.0 - stepFraction;
+	return 0.5 * stepHeight * x * x;
+}
+
+inline double polyBLEPAfterStep(double stepHeight, double stepFraction)
+{
+	return -0.5 * stepHeight * stepFraction * stepFraction;
+}
+
 enum class XFadeType { kLinear, kConstantPower };
 
 /**
@@ -802,6 +909,8 @@ public:
 	// --- simple functions
 	void resetTimer() { counter = 0; }		///< reset the counter
 	void advanceTimer() { counter++; }		///< advance by 1
+	void advanceTimer(uint32_t count) { counter += count; }	///< advance by count
+	uint32_t getSamplesRemaining() { return counter >= targetValueInSamples ? 0 : targetValueInSamples - counter; } ///< ticks until expired
 	uint32_t getTick() { return counter; }		///< tick count
 	bool timerExpired() { return (counter >= targetValueInSamples); } ///< check if we hit target
 	void setTargetValueInSamples(uint32_t _targetValueInSamples) { targetValueInSamples = _targetValueInSamples; } ///< set target value
@@ -1050,6 +1159,12 @@ protected:
 // --- ALL oscillator waveforms
 //enum class SynthOscType { kFourierWaveTable, kVirtualAnalogBLEP, kHighResWaveTable };
 
+// --- oscillator engines that a SynthOsc can run
+enum class SynthOscType { kWaveTable, kMorphingWaveTable, kWaveSample };
+
+// --- max copies of the table read in one oscillator's unison
+const uint32_t kMaxUnisonVoices = 16;
+
 /**
 \struct SynthOscParameters
 \ingroup SynthStructures
@@ -1073,6 +1188,9 @@ struct SynthOscParameters
 		detuneSemitones = params.detuneSemitones;
 		detuneCents = params.detuneCents;
 		unisonDetuneCents = params.unisonDetuneCents;
+		unisonVoices = params.unisonVoices;
+		unisonSpreadCents = params.unisonSpreadCents;
+		unisonStereoWidth = params.unisonStereoWidth;
 
 		pulseWidth_Pct = params.pulseWidth_Pct;
 		outputAmplitude = params.outputAmplitude;
@@ -1085,6 +1203,7 @@ struct SynthOscParameters
 
 		morphModulation = params.morphModulation;
 		pitchMode = params.pitchMode;
+		oscType = params.oscType;
 
 		return *this;
 	}
@@ -1103,6 +1222,11 @@ struct SynthOscParameters
 	// --- this is a root-detuner for unison mode (could combine with detuneCents but would become tangled)
 	double unisonDetuneCents = 0.0;		// 1 = up one cent, -1 = down one cent
 
+	// --- unison inside the oscillator: detuned, phase-spread stereo copies of the table read
+	uint32_t unisonVoices = 1;			// [1, kMaxUnisonVoices]
+	double unisonSpreadCents = 0.0;		// outermost copies are +/- this
+	double unisonStereoWidth = 1.0;		// [0, 1] outermost copies are panned hard left/right at 1
+
 	double pulseWidth_Pct = 50.0;		// sqr wave only
 	double outputAmplitude = 1.0;		// raw value, NOT dB
 	
@@ -1114,6 +1238,9 @@ struct SynthOscParameters
 	bool enableHardSync = false;		// [1, +???]
 	bool enableFreeRunMode = false;		// [1, +???]
 	int pitchMode = 0;
+
+	// --- normal or morphing wavetable
+	SynthOscType oscType = SynthOscType::kWaveTable;
 };
 
 /**
@@ -1181,16 +1308,28 @@ inline double uint64ToDouble(uint64_t u)
 	return retValue;
 }
 
+// --- the table an IWaveTable picked for a note; the caller keeps it, so any number of voices
+//     (on any number of threads) can read the same IWaveTable
+struct WaveTableSelection
+{
+	const void* table = nullptr;	///< table cloaked as void*, format known to the IWaveTable
+	uint32_t tableLength = 0;
+};
+
 // --- for wave table data sources so they can be shared
 class IWaveTable
 {
 public:
-	// --- reset/regenerate wave tables
-	virtual void selectTable(uint32_t midiNoteNumber) = 0;
+	virtual ~IWaveTable() {}
 
-	virtual double readWaveTable(double readIndex) = 0;
+	// --- pick the table for a note; does not change the IWaveTable
+	virtual WaveTableSelection selectTable(uint32_t midiNoteNumber) = 0;
 
-	virtual uint32_t getWaveTableLength() = 0;
+	virtual double readWaveTable(const WaveTableSelection& selection, double readIndex) = 0;
+
+	// --- the selected table as plain doubles for callers that interpolate many reads at once;
+	//     nullptr if it is stored some other way. outputScale is applied after interpolation.
+	virtual const double* getTableSamples(const WaveTableSelection& selection, double& outputScale) { return nullptr; }
 };
 
 // --- informationn for morphing between two tables
@@ -1207,6 +1346,8 @@ struct MorphTablePair
 		table_1_Length = params.table_1_Length;
 		readIndex_0 = params.readIndex_0;
 		readIndex_1 = params.readIndex_1;
+		pairTable = params.pairTable;
+		morphFraction = params.morphFraction;
 
 		return *this;
 	}
@@ -1220,6 +1361,13 @@ struct MorphTablePair
 
 	double readIndex_0 = 0.0;
 	double readIndex_1 = 0.0;
+
+	// --- precomputed pair: interleaved { table_0[n], table_1[n] - table_0[n] } with two
+	//     guard points at the end, so a fused read never wraps; shared, never written
+	const double* pairTable = nullptr;
+
+	// --- crossfade position between table_0 and table_1 [0, 1]
+	double morphFraction = 0.0;
 };
 
 
@@ -1227,6 +1375,8 @@ struct MorphTablePair
 class IMorphingWaveBank
 {
 public:
+	virtual ~IMorphingWaveBank() {}
+
 	// --- reset/regenerate wave tables
 	virtual bool resetWaveTables(double sampleRate) = 0;
 
@@ -1255,16 +1405,19 @@ public:
 class IWaveBank
 {
 public:
+	virtual ~IWaveBank() {}
+
 	// --- reset/regenerate wave tables
 	virtual bool resetWaveTables(double sampleRate) = 0;
 
-	// --- select table to read based on MIDI Note number of pitch modulated oscillator
-	virtual IWaveTable* selectTable(int oscillatorWaveformIndex, uint32_t midiNoteNumber, uint32_t& tableLen) = 0;
+	// --- select table to read based on MIDI Note number of pitch modulated oscillator; the
+	//     selection is returned in selection and belongs to the caller
+	virtual IWaveTable* selectTable(int oscillatorWaveformIndex, uint32_t midiNoteNumber, WaveTableSelection& selection) = 0;
 
 	// --- read the selected wavetable and return a double value
 	//     linear interpolation is engaged by default
 	//     Should add Lagrange interpolation (maybe as class project?)
-	virtual double readWaveTable(IWaveTable* selectedWT, double readIndex) = 0;
+	virtual double readWaveTable(IWaveTable* selectedWT, const WaveTableSelection& selection, double readIndex) = 0;
 
 	// --- get the number of waves for this datasource
 	virtual uint32_t getNumWaveforms() = 0;
@@ -1316,7 +1469,11 @@ public:
 
 // --- for wave sample data sources so they can be shared
 class WaveData;
-enum class SampleLoopMode;
+
+// --- kSustain: play the smpl chunk loop while the note is held, then run on to the end
+//     kLoop: always loop (the smpl chunk loop, or the whole sample if there is none)
+//     kOneShot: ignore loops and play to the end
+enum class SampleLoopMode { kSustain, kLoop, kOneShot };
 
 class IWaveSample
 {
@@ -1,5 +1,37 @@
 #include "synthlfo.h"
 
+// --- one cycle of sin(2*pi*x) with a guard point for the interpolation, shared by all LFOs
+struct LFOSineTable
+{
+	LFOSineTable()
+	{
+		for (uint32_t i = 0; i <= kLFOSineTableLength; i++)
+			table[i] = sin(kTwoPi * (double)i / (double)kLFOSineTableLength);
+	}
+
+	double table[kLFOSineTableLength + 1];
+};
+
+const double* getLFOSineTable()
+{
+	static LFOSineTable sineTable;
+	return sineTable.table;
+}
+
+/**
+\brief linear interpolated sin(2*pi*modulo) for modulo on [0.0, 1.0]
+*/
+double SynthLFO::sineTableLookup(double modulo)
+{
+	double readIndex = modulo * (double)kLFOSineTableLength;
+	uint32_t index = (uint32_t)readIndex;
+	if (index >= kLFOSineTableLength)
+		index = kLFOSineTableLength - 1;
+
+	double frac = readIndex - (double)index;
+	return sineTable[index] + frac * (sineTable[index + 1] - sineTable[index]);
+}
+
 /**
 \brief runs priority modulators and updates
 */
@@ -73,114 +105,141 @@ const ModOutputData SynthLFO::renderModulatorOutput()
 		return lfoOutputData;
 	}
 
-	// --- QP output always follows location of current modulo; first set equal
-	modCounterQP = modCounter;	///< Quad Phase first follows current modulo
-
-	// --- then, advance modulo by quadPhaseInc = 0.25 = 90 degrees, AND wrap if needed
-	advanceAndCheckWrapModulo(modCounterQP, 0.25); ///< Quad Phase then advances by 90 degrees, wrapping if needed
+	// --- only the outputs something reads; the waveform is decoded once with a switch
+	const bool renderNormal = (outputMask & kLFONormalOutputs) != 0;
+	const bool renderQuadPhase = (outputMask & kLFOQuadPhaseOutputs) != 0;
+	double normalOutput = 0.0;
+	double quadPhaseOutput = 0.0;
 
-	// --- calculate the oscillator value
-	if (parameters->waveform == LFOWaveform::kSin)
+	if (renderQuadPhase)
 	{
-		// --- calculate normal angle
-		double angle = modCounter*2.0*kPi - kPi;
-
-		// --- norm output with parabolicSine approximation
-		lfoOutputData.modulationOutputs[kLFONormalOutput] = parabolicSine(-angle);
-
-		// --- calculate QP angle
-		angle = modCounterQP*2.0*kPi - kPi;
+		// --- QP output always follows location of current modulo; first set equal
+		modCounterQP = modCounter;	///< Quad Phase first follows current modulo
 
-		// --- calc QP output
-		lfoOutputData.modulationOutputs[kLFOQuadPhaseOutput] = parabolicSine(-angle);
+		// --- then, advance modulo by quadPhaseInc = 0.25 = 90 degrees, AND wrap if needed
+		advanceAndCheckWrapModulo(modCounterQP, 0.25); ///< Quad Phase then advances by 90 degrees, wrapping if needed
 	}
-	else if (parameters->waveform == LFOWaveform::kTriangle)
-	{
-		// --- triv saw
-		lfoOutputData.modulationOutputs[kLFONormalOutput] = unipolarToBipolar(modCounter);
-
-		// --- bipolar triagle
-		lfoOutputData.modulationOutputs[kLFONormalOutput] = 2.0*fabs(lfoOutputData.modulationOutputs[kLFONormalOutput]) - 1.0;
-
-		// -- quad phase
-		lfoOutputData.modulationOutputs[kLFOQuadPhaseOutput] = unipolarToBipolar(modCounterQP);
 
-		// bipolar triagle
-		lfoOutputData.modulationOutputs[kLFOQuadPhaseOutput] = 2.0*fabs(lfoOutputData.modulationOutputs[kLFOQuadPhaseOutput]) - 1.0;
-	}
-	else if (parameters->waveform == LFOWaveform::kSaw)
-	{
-		lfoOutputData.modulationOutputs[kLFONormalOutput] = unipolarToBipolar(modCounter);
-		lfoOutputData.modulationOutputs[kLFOQuadPhaseOutput] = unipolarToBipolar(modCounterQP);
-	}
-	else if (parameters->waveform == LFOWaveform::kNoise)
-	{
-		lfoOutputData.modulationOutputs[kLFONormalOutput] = doWhiteNoise();
-		lfoOutputData.modulationOutputs[kLFOQuadPhaseOutput] = doWhiteNoise();
-	}
-	else if (parameters->waveform == LFOWaveform::kQRNoise)
-	{
-		lfoOutputData.modulationOutputs[kLFONormalOutput] = doPNSequence(pnRegister);
-		lfoOutputData.modulationOutputs[kLFOQuadPhaseOutput] = doPNSequence(pnRegister);
-	}
-	else if (parameters->waveform == LFOWaveform::kRSH || parameters->waveform == LFOWaveform::kQRSH)
+	// --- calculate the oscillator value
+	switch (parameters->waveform)
 	{
-		// --- is this is the very first run? if so, form first output sample
-		if (randomSHCounter < 0)
+		case LFOWaveform::kSin:
 		{
-			if (parameters->waveform == LFOWaveform::kRSH)
-				randomSHValue = doWhiteNoise();
+			// --- sin(2*pi*modCounter); the table is exact, the parabolic approximation is the classic sound
+			if (parameters->useSineTable)
+			{
+				if (renderNormal)
+					normalOutput = sineTableLookup(modCounter);
+				if (renderQuadPhase)
+					quadPhaseOutput = sineTableLookup(modCounterQP);
+			}
 			else
-				randomSHValue = doPNSequence(pnRegister);
-
-			// --- init the sample counter, will be advanced below
-			randomSHCounter = 1.0;
+			{
+				if (renderNormal)
+					normalOutput = parabolicSine(-(modCounter*2.0*kPi - kPi));
+				if (renderQuadPhase)
+					quadPhaseOutput = parabolicSine(-(modCounterQP*2.0*kPi - kPi));
+			}
+			break;
 		}
-		// --- has hold time been exceeded? if so, generate next output sample
-		else if (randomSHCounter > (sampleRate / parameters->frequency_Hz))
+		case LFOWaveform::kTriangle:
 		{
-			// --- wrap counter
-			randomSHCounter -= sampleRate / parameters->frequency_Hz;
-
-			if (parameters->waveform == LFOWaveform::kRSH)
-				randomSHValue = doWhiteNoise();
-			else
-				randomSHValue = doPNSequence(pnRegister);
+			// --- triv saw -> bipolar triangle
+			if (renderNormal)
+				normalOutput = 2.0*fabs(unipolarToBipolar(modCounter)) - 1.0;
+			if (renderQuadPhase)
+				quadPhaseOutput = 2.0*fabs(unipolarToBipolar(modCounterQP)) - 1.0;
+			break;
+		}
+		case LFOWaveform::kSaw:
+		{
+			normalOutput = unipolarToBipolar(modCounter);
+			quadPhaseOutput = unipolarToBipolar(modCounterQP);
+			break;
+		}
+		case LFOWaveform::kNoise:
+		{
+			if (renderNormal)
+				normalOutput = noiseGenerator.doWhiteNoise();
+			if (renderQuadPhase)
+				quadPhaseOutput = noiseGenerator.doWhiteNoise();
+			break;
+		}
+		case LFOWaveform::kQRNoise:
+		{
+			if (renderNormal)
+				normalOutput = doPNSequence(pnRegister);
+			if (renderQuadPhase)
+				quadPhaseOutput = doPNSequence(pnRegister);
+			break;
+		}
+		case LFOWaveform::kRSH:
+		case LFOWaveform::kQRSH:
+		{
+			// --- the hold runs whether or not anyone reads it, so the steps stay in time
+			// --- is this is the very first run? if so, form first output sample
+			if (randomSHCounter < 0)
+			{
+				if (parameters->waveform == LFOWaveform::kRSH)
+					randomSHValue = noiseGenerator.doWhiteNoise();
+				else
+					randomSHValue = doPNSequence(pnRegister);
+
+				// --- init the sample counter, will be advanced below
+				randomSHCounter = 1.0;
+			}
+			// --- has hold time been exceeded? if so, generate next output sample
+			else if (randomSHCounter > (sampleRate / parameters->frequency_Hz))
+			{
+				// --- wrap counter
+				randomSHCounter -= sampleRate / parameters->frequency_Hz;
+
+				if (parameters->waveform == LFOWaveform::kRSH)
+					randomSHValue = noiseGenerator.doWhiteNoise();
+				else
+					randomSHValue = doPNSequence(pnRegister);
+			}
+
+			// --- advance the sample counter
+			randomSHCounter += 1.0;
+
+			normalOutput = randomSHValue;
+			quadPhaseOutput = randomSHValue;
+			break;
 		}
-
-		// --- advance the sample counter
-		randomSHCounter += 1.0;
-
-		lfoOutputData.modulationOutputs[kLFONormalOutput] = randomSHValue;
-		lfoOutputData.modulationOutputs[kLFOQuadPhaseOutput] = randomSHValue;
 	}
 
-	// --- scale by amplitude
-	lfoOutputData.modulationOutputs[kLFONormalOutput] *= parameters->outputAmplitude * rampAmp;
-	lfoOutputData.modulationOutputs[kLFOQuadPhaseOutput] *= parameters->outputAmplitude * rampAmp;
-
-	if (!lfo1_timer.timerExpired())	// if we are waiting to oscillate
+	// --- scale by amplitude; nothing until the delay has expired
+	if (lfo1_timer.timerExpired())
+	{
+		normalOutput *= parameters->outputAmplitude * rampAmp;
+		quadPhaseOutput *= parameters->outputAmplitude * rampAmp;
+	}
+	else
 	{
-		lfoOutputData.modulationOutputs[kLFONormalOutput] = 0.0;
-		lfoOutputData.modulationOutputs[kLFOQuadPhaseOutput] = 0.0;
+		normalOutput = 0.0;
+		quadPhaseOutput = 0.0;
 	}
 
+	lfoOutputData.modulationOutputs[kLFONormalOutput] = normalOutput;
+	lfoOutputData.modulationOutputs[kLFOQuadPhaseOutput] = quadPhaseOutput;
+
 	// --- invert two main outputs to make the opposite versions, scaling carries over
-	lfoOutputData.modulationOutputs[kLFONormalOutputInverted] = -lfoOutputData.modulationOutputs[kLFONormalOutput];
-	lfoOutputData.modulationOutputs[kLFOQuadPhaseOutputInverted] = -lfoOutputData.modulationOutputs[kLFOQuadPhaseOutput];
+	if (outputMask & (1 << kLFONormalOutputInverted))
+		lfoOutputData.modulationOutputs[kLFONormalOutputInverted] = -normalOutput;
+	if (outputMask & (1 << kLFOQuadPhaseOutputInverted))
+		lfoOutputData.modulationOutputs[kLFOQuadPhaseOutputInverted] = -quadPhaseOutput;
 	
 	// --- special unipolar from max output for tremolo
 	//
-	// --- first, convert to unipolar
-	lfoOutputData.modulationOutputs[kUnipolarOutputFromMax] = bipolarToUnipolar(lfoOutputData.modulationOutputs[kLFONormalOutput]);
-	lfoOutputData.modulationOutputs[kUnipolarOutputFromMin] = bipolarToUnipolar(lfoOutputData.modulationOutputs[kLFONormalOutput]);
-
-	// --- then shift upwards by enough to put peaks right at 1.0
+	// --- convert to unipolar, then shift upwards by enough to put peaks right at 1.0
 	//     NOTE: leaving the 0.5 in the equation - it is the unipolar offset when convering bipolar; but it could be changed...
-	lfoOutputData.modulationOutputs[kUnipolarOutputFromMax] = lfoOutputData.modulationOutputs[kUnipolarOutputFromMax] + (1.0 - 0.5 - (parameters->outputAmplitude / 2.0));
+	if (outputMask & (1 << kUnipolarOutputFromMax))
+		lfoOutputData.modulationOutputs[kUnipolarOutputFromMax] = bipolarToUnipolar(normalOutput) + (1.0 - 0.5 - (parameters->outputAmplitude / 2.0));
 	
 	// --- then shift down enough to put troughs at 0.0
-	lfoOutputData.modulationOutputs[kUnipolarOutputFromMin] = lfoOutputData.modulationOutputs[kUnipolarOutputFromMin] - (1.0 - 0.5 - (parameters->outputAmplitude / 2.0));
+	if (outputMask & (1 << kUnipolarOutputFromMin))
+		lfoOutputData.modulationOutputs[kUnipolarOutputFromMin] = bipolarToUnipolar(normalOutput) - (1.0 - 0.5 - (parameters->outputAmplitude / 2.0));
 
 	// --- setup for next sample period
 	advanceModulo(modCounter, phaseInc);		// phaseInc was set earlier to either phaseInc1 or 2
@@ -60,6 +60,15 @@ enum {
 	kUnipolarOutputFromMin
 };
 
+// --- SynthLFO::setOutputMask() bits; the normal group also feeds the inverted and unipolar outputs
+const uint32_t kLFONormalOutputs = (1 << kLFONormalOutput) | (1 << kLFONormalOutputInverted) | (1 << kUnipolarOutputFromMax) | (1 << kUnipolarOutputFromMin);
+const uint32_t kLFOQuadPhaseOutputs = (1 << kLFOQuadPhaseOutput) | (1 << kLFOQuadPhaseOutputInverted);
+const uint32_t kLFOAllOutputs = kLFONormalOutputs | kLFOQuadPhaseOutputs;
+
+// --- LFO sine table, see SynthLFOParameters::useSineTable
+const uint32_t kLFOSineTableLength = 1024;
+const double* getLFOSineTable();
+
 /**
 \struct SynthLFOParameters
 \ingroup SynthStructures
@@ -68,6 +77,9 @@ enum {
 - mode: mode of operation, see enum LFOMode
 - frequency_Hz: oscillation frequency
 - outputAmplitude: amplitude of LFO output (default 1.0)
+- useSineTable: kSin reads an exact sine table instead of the parabolic approximation
+- globalLFO: rendered once by the engine and shared by every voice instead of once per voice;
+  it is started by the first note of a phrase and ignores per-voice frequency modulation
 */
 
 struct SynthLFOParameters
@@ -90,6 +102,9 @@ struct SynthLFOParameters
 		shape = params.shape;
 		shapey = params.shapey;
 
+		useSineTable = params.useSineTable;
+		globalLFO = params.globalLFO;
+
 		return *this;
 	}
 
@@ -103,6 +118,9 @@ struct SynthLFOParameters
 	double rampTime_mSec = 0.0;
 	double shape = 0.5;
 	double shapey = 0.5;
+
+	bool useSineTable = false;
+	bool globalLFO = false;
 };
 
 
@@ -125,14 +143,25 @@ public:
 	SynthLFO(const std::shared_ptr<MidiInputData> _midiInputData, std::shared_ptr<SynthLFOParameters> _parameters)
 		: midiInputData(_midiInputData) 
 	, parameters(_parameters){
-		srand(time(NULL)); // --- seed random number generator
-
-		// --- randomize the PN register
-		pnRegister = rand();
+		// --- default seed; the engine re-seeds each voice with seedNoise()
+		seedNoise(0);
 
 	}	/* C-TOR */
 	virtual ~SynthLFO() {}				/* D-TOR */
 
+	/**
+	\brief Seeds the noise generator and the PN register for the noise and S&H waveforms
+	*/
+	void seedNoise(uint64_t seed)
+	{
+		noiseGenerator.seed(seed);
+
+		// --- randomize the PN register; an all-zero register never changes
+		pnRegister = (uint32_t)(noiseGenerator.nextRandom() >> 32);
+		if (pnRegister == 0)
+			pnRegister = 1;
+	}
+
 	/**
 	\brief Implements reset: 
 	updates sample rate and phaseInc, and resets modCounters
@@ -183,6 +212,9 @@ public:
 	// --- the oscillator function
 	const ModOutputData renderModulatorOutput();
 
+	// --- outputs to render, kLFO...Outputs bits; outputs left out stay at 0.0
+	void setOutputMask(uint32_t _outputMask) { outputMask = _outputMask; }
+
 	// --- get our modulators
 	virtual std::shared_ptr<ModInputData> getModulators() {
 		return modulators;
@@ -217,6 +249,16 @@ protected:
 	double shape = 0.5;
 	double shapey = 0.5;
 
+	// --- white noise for Noise and RS&H
+	NoiseGenerator noiseGenerator;
+
+	// --- what the owner reads
+	uint32_t outputMask = kLFOAllOutputs;
+
+	// --- shared sine table
+	const double* sineTable = getLFOSineTable();
+	double sineTableLookup(double modulo);
+
 	// --- 32-bit register for RS&H
 	uint32_t pnRegister = 0;			///< 32 bit register for PN oscillator
 	int randomSHCounter = -1;			///< random sample/hold counter;  -1 is reset condition
@@ -4,10 +4,12 @@
 
 SynthOsc::SynthOsc(const std::shared_ptr<MidiInputData> _midiInputData, 
 					std::shared_ptr<SynthOscParameters> _parameters, 
-					std::shared_ptr<WaveTableData> _waveTableData)
+					std::shared_ptr<WaveTableData> _waveTableData,
+					std::shared_ptr<WaveSampleData> _waveSampleData)
 	: midiInputData(_midiInputData)
 	, parameters(_parameters)
 	, waveTableData(_waveTableData)
+	, waveSampleData(_waveSampleData)
 {
 	// --- create subcomponents
 	if (!parameters)
@@ -15,28 +17,32 @@ SynthOsc::SynthOsc(const std::shared_ptr<MidiInputData> _midiInputData,
 
 	// --- create sub-components
 	wavetableOscillator.reset(new WaveTableOsc(midiInputData, parameters, waveTableData));
+	morphOscillator.reset(new MorphWaveTableOsc(midiInputData, parameters, waveTableData));
+	sampleOscillator.reset(new WaveSampleOsc(midiInputData, parameters, waveTableData, waveSampleData));
 
 	// --- **7**
 	wavetableOscillator->setBankSet(BANK_SET_0);
+	morphOscillator->setBankSet(BANK_SET_0);
 }
 
 // --- **7**
 void SynthOsc::setBankSet(uint32_t _bankSet)
 {
 	wavetableOscillator->setBankSet(_bankSet);
+	morphOscillator->setBankSet(_bankSet);
 }
 uint32_t SynthOsc::getBankSet()
 {
-	return wavetableOscillator->getBankSet();
+	return getSelectedOscillator()->getBankSet();
 }
 // --- **7**
 std::vector<std::string> SynthOsc::getWaveformNames(uint32_t bankIndex)
 {
-	return wavetableOscillator->getWaveformNames(bankIndex);
+	return getSelectedOscillator()->getWaveformNames(bankIndex);
 }
 std::vector<std::string> SynthOsc::getBankNames()
 {
-	return wavetableOscillator->getBankNames();
+	return getSelectedOscillator()->getBankNames();
 }
 SynthOsc::~SynthOsc()
 {
@@ -51,15 +57,21 @@ bool SynthOsc::reset(double _sampleRate)
 	wavetableOscillator->reset(_sampleRate);
 	wavetableOscillator->setModulators(modulators);
 
-	// --- for noise generation
-	srand(time(NULL));
+	morphOscillator->reset(_sampleRate);
+	morphOscillator->setModulators(modulators);
+
+	sampleOscillator->reset(_sampleRate);
+	sampleOscillator->setModulators(modulators);
 
 	return true;
 }
 
 bool SynthOsc::doNoteOn(double midiPitch, uint32_t _midiNoteNumber, uint32_t midiNoteVelocity)
 {
+	// --- both, so that a type change during a note picks up the pitch
 	wavetableOscillator->doNoteOn(midiPitch, _midiNoteNumber, midiNoteVelocity);
+	morphOscillator->doNoteOn(midiPitch, _midiNoteNumber, midiNoteVelocity);
+	sampleOscillator->doNoteOn(midiPitch, _midiNoteNumber, midiNoteVelocity);
 	
 	return true;
 }
@@ -67,13 +79,15 @@ bool SynthOsc::doNoteOn(double midiPitch, uint32_t _midiNoteNumber, uint32_t mid
 bool SynthOsc::doNoteOff(double midiPitch, uint32_t _midiNoteNumber, uint32_t midiNoteVelocity)
 {
 	wavetableOscillator->doNoteOff(midiPitch, _midiNoteNumber, midiNoteVelocity);
+	morphOscillator->doNoteOff(midiPitch, _midiNoteNumber, midiNoteVelocity);
+	sampleOscillator->doNoteOff(midiPitch, _midiNoteNumber, midiNoteVelocity);
 
 	return true;
 }
 
 bool SynthOsc::update(bool updateAllModRoutings)
 {
-	wavetableOscillator->update(updateAllModRoutings);
+	getSelectedOscillator()->update(updateAllModRoutings);
 
 	return true;
 }
@@ -84,7 +98,7 @@ const OscillatorOutputData SynthOsc::renderAudioOutput()
 	oscillatorAudioData.outputs[0] = 0.0;
 	oscillatorAudioData.outputs[1] = 0.0;
 
-	oscillatorAudioData = wavetableOscillator->renderAudioOutput();
+	oscillatorAudioData = getSelectedOscillator()->renderAudioOutput();
 	
 	return oscillatorAudioData;
 }
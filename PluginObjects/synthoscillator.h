@@ -4,6 +4,8 @@
 // --- we need these
 #include "synthdefs.h"
 #include "wavetableoscillator.h"
+#include "morphwavetableoscillator.h"
+#include "wavesampleoscillator.h"
 
 /**
 \class SynthOsc
@@ -20,7 +22,8 @@ class SynthOsc : public ISynthOscillator
 public:
 	SynthOsc(const std::shared_ptr<MidiInputData> _midiInputData, 
 			 std::shared_ptr<SynthOscParameters> _parameters, 
-			 std::shared_ptr<WaveTableData> _waveTableData);
+			 std::shared_ptr<WaveTableData> _waveTableData,
+			 std::shared_ptr<WaveSampleData> _waveSampleData);
 	virtual ~SynthOsc();
 
 	// --- ISynthOscillator
@@ -39,6 +42,8 @@ public:
 	virtual bool setGlideModulation(uint32_t _startMIDINote, uint32_t _endMIDINote, double glideTime_mSec)
 	{
 		wavetableOscillator->setGlideModulation(_startMIDINote, _endMIDINote, glideTime_mSec);
+		morphOscillator->setGlideModulation(_startMIDINote, _endMIDINote, glideTime_mSec);
+		sampleOscillator->setGlideModulation(_startMIDINote, _endMIDINote, glideTime_mSec);
 
 		return true;
 	}
@@ -68,12 +73,26 @@ protected:
 
 	// --- parameters
 	std::shared_ptr<WaveTableData> waveTableData = nullptr;
+	std::shared_ptr<WaveSampleData> waveSampleData = nullptr;
 
 	// --- our output
 	OscillatorOutputData oscillatorAudioData;
 
 	// --- smart pointers to the oscillator object
 	std::unique_ptr<WaveTableOsc> wavetableOscillator = nullptr;
+	std::unique_ptr<MorphWaveTableOsc> morphOscillator = nullptr;
+	std::unique_ptr<WaveSampleOsc> sampleOscillator = nullptr;
+
+	// --- the oscillator selected with parameters->oscType
+	WaveTableOsc* getSelectedOscillator()
+	{
+		if (parameters->oscType == SynthOscType::kMorphingWaveTable)
+			return morphOscillator.get();
+		if (parameters->oscType == SynthOscType::kWaveSample)
+			return sampleOscillator.get();
+
+		return wavetableOscillator.get();
+	}
 };
 
 
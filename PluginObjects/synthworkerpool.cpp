@@ -0,0 +1,205 @@
+// --- Synth Core v1.0
+//
+#include "synthworkerpool.h"
+
+#include <algorithm>
+
+#if defined _WINDOWS || defined _WINDLL
+#include <windows.h>
+#elif defined __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// --- job range words
+inline uint64_t packJobRange(uint32_t batch, uint32_t begin, uint32_t end)
+{
+	return ((uint64_t)(batch & 0xFFFF) << 48) | ((uint64_t)(begin & kMaxSynthJobs) << 24) | (uint64_t)(end & kMaxSynthJobs);
+}
+
+inline uint32_t getJobRangeBegin(uint64_t range) { return (uint32_t)((range >> 24) & kMaxSynthJobs); }
+inline uint32_t getJobRangeEnd(uint64_t range) { return (uint32_t)(range & kMaxSynthJobs); }
+
+// --- best effort; macOS only takes affinity hints, so nothing is done there
+static void pinThreadToCore(uint32_t core)
+{
+	uint32_t numCores = std::thread::hardware_concurrency();
+	if (numCores == 0)
+		return;
+	core %= numCores;
+
+#if defined _WINDOWS || defined _WINDLL
+	if (core < 8 * sizeof(DWORD_PTR))
+		SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << core);
+#elif defined __linux__
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	CPU_SET(core, &cpuSet);
+	pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+#endif
+}
+
+SynthWorkerPool::SynthWorkerPool()
+	: stopWorkers(false)
+	, pendingJobs(0)
+	, stolenJobs(0)
+{
+	for (uint32_t i = 0; i < kMaxSynthWorkers + 1; i++)
+		jobRanges[i].store(0);
+}
+
+SynthWorkerPool::~SynthWorkerPool()
+{
+	stopAllWorkers();
+}
+
+void SynthWorkerPool::setNumWorkers(uint32_t _numWorkers, bool _pinWorkers)
+{
+	if (_numWorkers > kMaxSynthWorkers)
+		_numWorkers = kMaxSynthWorkers;
+
+	if (_numWorkers == numWorkers && _pinWorkers == pinWorkers)
+		return;
+
+	stopAllWorkers();
+
+	numWorkers = _numWorkers;
+	pinWorkers = _pinWorkers;
+	stopWorkers.store(false);
+	for (uint32_t i = 0; i < numWorkers; i++)
+		workers.push_back(std::thread(&SynthWorkerPool::workerLoop, this, i));
+}
+
+void SynthWorkerPool::stopAllWorkers()
+{
+	stopWorkers.store(true);
+	for (uint32_t i = 0; i < workers.size(); i++)
+		workerWakeup[i].signal();
+
+	for (auto& worker : workers)
+	{
+		if (worker.joinable())
+			worker.join();
+	}
+
+	workers.clear();
+	numWorkers = 0;
+}
+
+void SynthWorkerPool::runJobs(SynthJobFunction _jobFunction, void* _jobContext, uint32_t numJobs)
+{
+	if (numJobs == 0)
+		return;
+
+	// --- serial
+	if (numWorkers == 0 || numJobs == 1)
+	{
+		for (uint32_t job = 0; job < numJobs; job++)
+			_jobFunction(_jobContext, job);
+		return;
+	}
+
+	if (numJobs > kMaxSynthJobs)
+		numJobs = kMaxSynthJobs;
+
+	// --- publish the batch; the range stores release the function and context
+	jobFunction = _jobFunction;
+	jobContext = _jobContext;
+	pendingJobs.store(numJobs, std::memory_order_relaxed);
+	batchNumber = (batchNumber + 1) & 0xFFFF;
+
+	// --- deal the jobs out evenly; threads left without a range can only steal
+	uint32_t numThreads = std::min(numWorkers + 1, numJobs);
+	for (uint32_t thread = 0; thread < numWorkers + 1; thread++)
+	{
+		uint32_t begin = 0;
+		uint32_t end = 0;
+		if (thread < numThreads)
+		{
+			begin = (uint32_t)((uint64_t)numJobs * thread / numThreads);
+			end = (uint32_t)((uint64_t)numJobs * (thread + 1) / numThreads);
+		}
+		jobRanges[thread].store(packJobRange(batchNumber, begin, end), std::memory_order_release);
+	}
+
+	// --- wake the workers that were dealt a range; we work through ours
+	for (uint32_t worker = 0; worker < numThreads - 1; worker++)
+		workerWakeup[worker].signal();
+
+	while (runNextJob(0))
+		;
+
+	// --- wait out the jobs the workers claimed
+	while (pendingJobs.load(std::memory_order_acquire) != 0)
+		std::this_thread::yield();
+}
+
+bool SynthWorkerPool::claimFront(uint32_t thread, uint32_t& job)
+{
+	uint64_t range = jobRanges[thread].load(std::memory_order_acquire);
+	while (getJobRangeBegin(range) < getJobRangeEnd(range))
+	{
+		if (jobRanges[thread].compare_exchange_weak(range, range + ((uint64_t)1 << 24), std::memory_order_acq_rel, std::memory_order_acquire))
+		{
+			job = getJobRangeBegin(range);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool SynthWorkerPool::claimBack(uint32_t thread, uint32_t& job)
+{
+	uint64_t range = jobRanges[thread].load(std::memory_order_acquire);
+	while (getJobRangeBegin(range) < getJobRangeEnd(range))
+	{
+		if (jobRanges[thread].compare_exchange_weak(range, range - 1, std::memory_order_acq_rel, std::memory_order_acquire))
+		{
+			job = getJobRangeEnd(range) - 1;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool SynthWorkerPool::runNextJob(uint32_t thread)
+{
+	// --- a successful claim holds the batch open, so the function and context are current
+	uint32_t job = 0;
+	bool claimed = claimFront(thread, job);
+
+	// --- steal, starting with the next thread over so the thieves spread out
+	for (uint32_t i = 1; !claimed && i < numWorkers + 1; i++)
+	{
+		if (claimBack((thread + i) % (numWorkers + 1), job))
+		{
+			claimed = true;
+			stolenJobs.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	if (!claimed)
+		return false;
+
+	jobFunction(jobContext, job);
+	pendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+	return true;
+}
+
+void SynthWorkerPool::workerLoop(uint32_t worker)
+{
+	if (pinWorkers)
+		pinThreadToCore(worker + 1);
+
+	while (true)
+	{
+		workerWakeup[worker].wait();
+		if (stopWorkers.load())
+			break;
+
+		while (runNextJob(worker + 1))
+			;
+	}
+}
@@ -0,0 +1,85 @@
+#ifndef __synthWorkerPool_h__
+#define __synthWorkerPool_h__
+
+// --- includes
+#include "synthdefs.h"
+#include "readerwriterqueue.h"
+
+#include <atomic>
+#include <thread>
+
+// --- most helper threads a pool will spawn
+const uint32_t kMaxSynthWorkers = 15;
+
+// --- most jobs in one batch (24-bit job ranges)
+const uint32_t kMaxSynthJobs = 0xFFFFFF;
+
+// --- a job: context is whatever the caller passed to runJobs( )
+typedef void(*SynthJobFunction)(void* context, uint32_t job);
+
+/**
+\class SynthWorkerPool
+\ingroup SynthClasses
+\brief Small pool of pre-spawned render threads for the audio thread.
+
+runJobs( ) publishes a batch of numbered jobs and wakes the workers; the calling thread works
+on the batch too and returns when every job has finished, so a batch never outlives the audio
+callback. Nothing is allocated or locked in runJobs( ).
+
+The jobs are dealt out as one contiguous range per thread (the caller is thread 0). Each thread
+takes jobs from the front of its own range and, once that is empty, steals from the back of the
+others, so a slow or late-waking thread does not hold up the batch. Every range word carries the
+batch number, which keeps a late worker from claiming a job of a batch that has already
+finished. Jobs may run on any thread in any order; callers that need deterministic results give
+each job its own output and combine them afterwards.
+
+Workers can be pinned to cores 1, 2, ... (core 0 is left to the host) where the platform
+supports it.
+
+setNumWorkers( ) spawns and joins threads and must not be called during runJobs( ).
+*/
+class SynthWorkerPool
+{
+public:
+	SynthWorkerPool();
+	~SynthWorkerPool();
+
+	// --- non-realtime: 0 workers runs every job on the calling thread
+	void setNumWorkers(uint32_t _numWorkers, bool _pinWorkers = false);
+	uint32_t getNumWorkers() { return numWorkers; }
+
+	// --- audio thread: calls jobFunction(context, job) for every job in [0, numJobs)
+	void runJobs(SynthJobFunction _jobFunction, void* _jobContext, uint32_t numJobs);
+
+	// --- jobs run by a thread other than the one they were dealt to (diagnostics)
+	uint64_t getStolenJobs() { return stolenJobs.load(std::memory_order_relaxed); }
+
+private:
+	uint32_t numWorkers = 0;
+	bool pinWorkers = false;
+	std::vector<std::thread> workers;
+	std::atomic<bool> stopWorkers;
+
+	// --- the semaphore is single-consumer, so each worker waits on its own
+	moodycamel::spsc_sema::LightweightSemaphore workerWakeup[kMaxSynthWorkers];
+
+	// --- the current batch; function and context only change once the batch has finished
+	SynthJobFunction jobFunction = nullptr;
+	void* jobContext = nullptr;
+	uint32_t batchNumber = 0;
+
+	// --- one job range per thread, caller first: [batch:16][begin:24][end:24]
+	std::atomic<uint64_t> jobRanges[kMaxSynthWorkers + 1];
+	std::atomic<uint32_t> pendingJobs;
+	std::atomic<uint64_t> stolenJobs;
+
+	// --- claim and run one job of the current batch, own range first; false if none are left
+	bool runNextJob(uint32_t thread);
+	bool claimFront(uint32_t thread, uint32_t& job);
+	bool claimBack(uint32_t thread, uint32_t& job);
+
+	void workerLoop(uint32_t worker);
+	void stopAllWorkers();
+};
+
+#endif /* defined(__synthWorkerPool_h__) */
@@ -2,6 +2,12 @@
 //
 #include "vafilters.h"
 
+// --- SSE2 is baseline on every x64 target
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VAFILTERS_SSE2 1
+#endif
+
 /**
 \brief Perform note-on operations for the component
 \return true if handled, false if not handled
@@ -42,7 +48,8 @@ bool MoogFilter::update(bool updateAllModRoutings)
 
 	// --- update limiter; NOTE: this does not use much CPU at all; dB are subtracted
 	//     and no raw conversions are done - cheap
-	limiters[MONO_CHANNEL].setThreshold_dB(parameters->truToneThreshold_dB);
+	limiters[LEFT_CHANNEL].setThreshold_dB(parameters->truToneThreshold_dB);
+	limiters[RIGHT_CHANNEL].setThreshold_dB(parameters->truToneThreshold_dB);
 
 	// --- calculate modulated filter fc
 	// --- for freq shifting as semitones
@@ -60,25 +67,72 @@ bool MoogFilter::update(bool updateAllModRoutings)
 
 	boundValue(fc1, freqModLow, freqModHigh);
 
-	// --- updte the subfilters
-	ZVAFilterParameters zvaParams = subFilter[0].getParameters();
-	zvaParams.fc = fc1;// parameters->fc;
-	zvaParams.filterAlgorithm = vaFilterAlgorithm::kLPF1;
+	// --- only recalculates if fc or Q has moved
+	calculateFilterCoeffs(fc1);
+
+	return true; // handled
+}
+
+// --- 4th order MOOG on both lanes; the SSE2 and scalar versions do the same operations in the
+//     same order, so they give the same results
+void MoogFilter::processLadder(double* lanes)
+{
+	// --- gain comp is a simple on/off switch LPF ONLY!!!!
+	double gainComp = parameters->enableGainComp ? 1.0 + 0.5*K : 1.0; // --- increase 0.5 for MORE bass
+
+#ifdef VAFILTERS_SSE2
+	__m128d state[NUM_SUBFILTERS];
+	for (int i = 0; i < NUM_SUBFILTERS; i++)
+		state[i] = _mm_load_pd(ladderState[i]);
+
+	// --- this is the sum of the scaled feedback paths from the S-ports of the subfilters
+	__m128d sigma = _mm_mul_pd(_mm_set1_pd(beta[0]), state[0]);
+	for (int i = 1; i < NUM_SUBFILTERS; i++)
+		sigma = _mm_add_pd(sigma, _mm_mul_pd(_mm_set1_pd(beta[i]), state[i]));
+
+	__m128d xn = _mm_loadu_pd(lanes);
+	if (parameters->enableGainComp)
+		xn = _mm_mul_pd(xn, _mm_set1_pd(gainComp));
+
+	// --- now figure out u(n) = alpha0*[x(n) - K*sigma]
+	__m128d yn = _mm_mul_pd(_mm_set1_pd(alpha0), _mm_sub_pd(xn, _mm_mul_pd(_mm_set1_pd(K), sigma)));
 
-	// --- do the update -- NOTE: the subfilters will only recalculate the coeffients
-	//							  if the cutoff frequency has changed so this is not as 
-	//							  CPU intensive as it looks but you could improve it a bit
-	//							  by performing the fc test here (you will need a member
-	//							  variable for per-run persistence)
+	// --- send u -> LPF1 and then cascade the outputs to form y(n)
+	const __m128d alpha = _mm_set1_pd(ladderAlpha);
 	for (int i = 0; i < NUM_SUBFILTERS; i++)
 	{
-		subFilter[i].setParameters(zvaParams);
+		__m128d vn = _mm_mul_pd(_mm_sub_pd(yn, state[i]), alpha);
+		yn = _mm_add_pd(vn, state[i]);
+		_mm_store_pd(ladderState[i], _mm_add_pd(vn, yn));
 	}
 
-	// --- changing fc on sub-filters requires recalc of Betas
-	calculateFilterCoeffs();
-
-	return true; // handled
+	_mm_storeu_pd(lanes, yn);
+#else
+	for (uint32_t lane = 0; lane < NUM_LADDER_LANES; lane++)
+	{
+		// --- this is the sum of the scaled feedback paths from the S-ports of the subfilters
+		double sigma = beta[0] * ladderState[0][lane];
+		for (int i = 1; i < NUM_SUBFILTERS; i++)
+			sigma += beta[i] * ladderState[i][lane];
+
+		double xn = lanes[lane];
+		if (parameters->enableGainComp)
+			xn *= gainComp;
+
+		// --- now figure out u(n) = alpha0*[x(n) - K*sigma]
+		double yn = alpha0*(xn - K*sigma);
+
+		// --- send u -> LPF1 and then cascade the outputs to form y(n)
+		for (int i = 0; i < NUM_SUBFILTERS; i++)
+		{
+			double vn = (yn - ladderState[i][lane])*ladderAlpha;
+			yn = vn + ladderState[i][lane];
+			ladderState[i][lane] = vn + yn;
+		}
+
+		lanes[lane] = yn;
+	}
+#endif
 }
 
 // --- process function
@@ -88,36 +142,17 @@ bool MoogFilter::processSynthAudio(SynthProcessorData* audioData)
 	if (audioData->numInputChannels == 0 || audioData->numOutputChannels == 0)
 		return false;
 
-	// --- this is a mono object, so it only has one input and one output channel
-	//     other channels will be ignored
-	double xn = audioData->inputs[MONO_CHANNEL];
-
-	// --- 4th order MOOG:
-	double sigma = 0.0;
+	// --- mono input runs in the left lane; the right lane is along for the ride
+	bool stereo = audioData->numInputChannels > 1 && audioData->numOutputChannels > 1;
+	double lanes[NUM_LADDER_LANES] = { audioData->inputs[LEFT_CHANNEL], stereo ? audioData->inputs[RIGHT_CHANNEL] : 0.0 };
 
-	// --- this is the sum of the scaled feedback paths from the S-ports of the subfilters
-	sigma = beta[0] * subFilter[0].getS0Port() +
-		beta[1] * subFilter[1].getS0Port() +
-		beta[2] * subFilter[2].getS0Port() +
-		beta[3] * subFilter[3].getS0Port();
-
-	// --- gain comp is a simple on/off switch LPF ONLY!!!!
-	if (parameters->enableGainComp)
-		xn *= 1.0 + 0.5*K; // --- increase 0.5 for MORE bass
-
-	// --- now figure out u(n) = alpha0*[x(n) - K*sigma]
-	double u = alpha0*(xn - K*sigma);
-
-	// --- send u -> LPF1 and then cascade the outputs to form y(n)
-	//     NOTE: verbose version; you can nest these function calls
-	double y0 = subFilter[0].processAudioSample(u); //< --- NOT x(n), u(n)
-	double y1 = subFilter[1].processAudioSample(y0);
-	double y2 = subFilter[2].processAudioSample(y1);
-	double yn = subFilter[3].processAudioSample(y2);
+	processLadder(lanes);
 
 	// -- do the limiter for self oscillation; could also nest with above if you want
-	audioData->outputs[MONO_CHANNEL] = limiters[MONO_CHANNEL].processAudio(yn);
+	audioData->outputs[LEFT_CHANNEL] = limiters[LEFT_CHANNEL].processAudio(lanes[LEFT_CHANNEL]);
+	if (stereo)
+		audioData->outputs[RIGHT_CHANNEL] = limiters[RIGHT_CHANNEL].processAudio(lanes[RIGHT_CHANNEL]);
 
 	// --- done
 	return true;
-}
\ No newline at end of file
+}
@@ -6,11 +6,16 @@
 #include "limiter.h"
 
 const int NUM_SUBFILTERS = 4;
+const uint32_t NUM_LADDER_LANES = 2;	// --- left, right
 const uint32_t SINGLE_CHANNEL = 1;
 const uint32_t MONO_CHANNEL = LEFT_CHANNEL;
 const double freqModLow = 20.0;
 const double freqModHigh = 18000.0;
 
+// --- MoogFilter recalculates its coefficients only when fc moves by more than this ratio
+//     (0.0005 is under one cent) or Q changes
+const double kMoogFcTolerance = 0.0005;
+
 /**
 \class ZVAFilterEx
 \ingroup SynthClasses
@@ -107,6 +112,10 @@ struct MoogFilterParameters
 \ingroup SynthClasses
 \brief Encapsulates a Moog Ladder Filter.
 
+The ladder runs two lanes (left and right) side by side on the same coefficients, as one SSE2
+kernel where available, so a stereo voice costs about what a mono one does. A mono input
+(numInputChannels = 1) runs in the left lane only.
+
 \author Will Pirkle
 \version Revision : 1.0
 \date Date : 2019 / 11 / 04
@@ -119,13 +128,6 @@ public:
 		midiInputData(_midiInputData)
 		, parameters(_parameters)
 	{
-		// --- setup four identical ZVAFilters as LPF1 types
-		ZVAFilterParameters params = subFilter[0].getParameters();
-		params.filterAlgorithm = vaFilterAlgorithm::kLPF1;
-		for (int i = 0; i < NUM_SUBFILTERS; i++)
-		{
-			subFilter[i].setParameters(params);
-		}
 	}		
 	~MoogFilter() {}	/* D-TOR */
 
@@ -138,33 +140,42 @@ public:
 	// --- set sample rate, then update coeffs
 	virtual bool reset(double _sampleRate)
 	{
-		// --- initialize four identical ZVAFilters as LPF1 types
-		for (int i = 0; i < NUM_SUBFILTERS; i++)
-		{
-			subFilter[i].reset(_sampleRate);
-		}
+		sampleRate = _sampleRate;
+
+		// --- clear the four LPF1 integrators of both lanes
+		memset(ladderState, 0, sizeof(ladderState));
 
 		// ---for self oscillating pure sine
-		limiters[MONO_CHANNEL].reset(_sampleRate);
+		limiters[LEFT_CHANNEL].reset(_sampleRate);
+		limiters[RIGHT_CHANNEL].reset(_sampleRate);
 
-		// --- setup
-		calculateFilterCoeffs();
+		// --- setup; new sample rate invalidates the cache
+		cachedFc = -1.0;
+		calculateFilterCoeffs(parameters->fc);
 		return true;
 	}
 
 	// --- the processor function
 	virtual bool processSynthAudio(SynthProcessorData* audioData);
 
-	// --- calculate MOOG coefficients
-	//     
-	void calculateFilterCoeffs()
+	// --- calculate MOOG coefficients; skipped when fc has moved less than kMoogFcTolerance
+	//     and Q is unchanged since the last calculation
+	void calculateFilterCoeffs(double fc)
 	{
+		if (parameters->Q == cachedQ && fabs(fc - cachedFc) <= kMoogFcTolerance * cachedFc)
+			return;
+
+		cachedFc = fc;
+		cachedQ = parameters->Q;
+
 		// --- Q is 1 -> 10 for my plugins; just map it to 0 -> 4
 		K = (4.0)*(parameters->Q - 1.0) / (10.0 - 1.0);
 
-		double G = subFilter[0].getAlpha();
-		double g = subFilter[0].getLittle_g();
+		// --- one prewarp for all four LPF1 sections: g = tan(wd*T/2), G = g/(1 + g)
+		double g = tan(kPi * fc / sampleRate);
 		double onePlus_g = 1.0 + g;
+		double G = g / onePlus_g;
+		ladderAlpha = G;
 
 		// --- follow cookbook instructions
 		beta[0] = (G*G*G / onePlus_g);
@@ -197,15 +208,28 @@ protected:
 	// --- set of double[MAX_MODULATION_CHANNELS]
 	std::shared_ptr<ModInputData> modulators = std::make_shared<ModInputData>();
 
-	// --- 4 subfilters
-	ZVAFilterEx subFilter[NUM_SUBFILTERS];				// --- NUM_SUBFILTERS filters
+	// --- sample rate
+	double sampleRate = 44100.0;
+
+	// --- the four LPF1 sections share one alpha, so they are kept as a flat state array
+	//     instead of four ZVAFilters (same math as ZVAFilter kLPF1); the lanes of each section
+	//     sit next to each other so one SSE2 register holds both
+	alignas(16) double ladderState[NUM_SUBFILTERS][NUM_LADDER_LANES] = { { 0.0 } };
+	double ladderAlpha = 0.0;	// --- G = g/(1 + g)
+
+	// --- coefficient cache
+	double cachedFc = -1.0;
+	double cachedQ = -1.0;
 
 	// --- four beta values
 	double beta[NUM_SUBFILTERS] = { 0.0, 0.0, 0.0, 0.0 };
 	double alpha0 = 1.0;	// --- our delay free loop correction coeffient (different from sub filters which also have their own)
 	double K = 0.0;			// --- this is 0.0 --> 4.0 = Q from 1 --> 10
 
-	// --- limiters; in theory can have MAX_PROCESSOR_CHANNELS (32) outputs but here is MONO
+	// --- runs one sample of both lanes through the ladder, in place
+	void processLadder(double* lanes);
+
+	// --- limiters; in theory can have MAX_PROCESSOR_CHANNELS (32) outputs but here is stereo
 	Limiter limiters[MAX_PROCESSOR_CHANNELS];
 
 	double keyTrackPitch = 440.0;
@@ -42,8 +42,7 @@ const ModOutputData WankelRotor::renderModulatorOutput()
 	}
 	else if (parameters->mode == 2)
 	{
-		rotorOutputData.modulationOutputs[0] = doWhiteNoise();
-		rotorOutputData.modulationOutputs[1] = doWhiteNoise();
+		noiseGenerator.fillWhiteNoise(rotorOutputData.modulationOutputs, 2);
 	}
 	
 	return rotorOutputData;
@@ -23,6 +23,7 @@ struct WankelRotorParameters
 		mode = params.mode;
 		shape = params.shape;
 		freq = params.freq;
+		globalRotor = params.globalRotor;
 
 		lfo1Parameters = params.lfo1Parameters;
 		lfo2Parameters = params.lfo2Parameters;
@@ -35,6 +36,9 @@ struct WankelRotorParameters
 	double shape = 0.0;
 	double freq = 0.0;
 
+	// --- render the rotor once in the engine and share it with every voice (see SynthLFOParameters::globalLFO)
+	bool globalRotor = false;
+
 	std::shared_ptr<SynthLFOParameters> lfo1Parameters = std::make_shared<SynthLFOParameters>();
 	std::shared_ptr<SynthLFOParameters> lfo2Parameters = std::make_shared<SynthLFOParameters>();
 };
@@ -54,18 +58,34 @@ public:
 	WankelRotor(const std::shared_ptr<MidiInputData> _midiInputData, std::shared_ptr<WankelRotorParameters> _parameters)
 		: midiInputData(_midiInputData) 
 	, parameters(_parameters){
-		srand(time(NULL)); // --- seed random number generator
-
-		// --- randomize the PN register
-		pnRegister = rand();
-
 		// --- create subcomponents
 		lfo1.reset(new SynthLFO(midiInputData, parameters->lfo1Parameters));
 		lfo2.reset(new SynthLFO(midiInputData, parameters->lfo2Parameters));
 
+		// --- the rotor reads lfo1 normal and lfo2 quad phase only
+		lfo1->setOutputMask(1 << kLFONormalOutput);
+		lfo2->setOutputMask(1 << kLFOQuadPhaseOutput);
+
+		// --- default seed; the engine re-seeds each voice with seedNoise()
+		seedNoise(0);
+
 	}	/* C-TOR */
 	virtual ~WankelRotor() {}				/* D-TOR */
 
+	/**
+	\brief Seeds the rotor's noise generator and PN register, and its two LFOs from separate streams
+	*/
+	void seedNoise(uint64_t seed)
+	{
+		noiseGenerator.seed(seed);
+		lfo1->seedNoise(deriveNoiseSeed(seed, 1));
+		lfo2->seedNoise(deriveNoiseSeed(seed, 2));
+
+		pnRegister = (uint32_t)(noiseGenerator.nextRandom() >> 32);
+		if (pnRegister == 0)
+			pnRegister = 1;
+	}
+
 	/**
 	\brief Implements reset: 
 	updates sample rate and phaseInc, and resets modCounters
@@ -126,6 +146,9 @@ protected:
 	std::shared_ptr<SynthLFO> lfo1;
 	std::shared_ptr<SynthLFO> lfo2;
 
+	// --- white noise for mode 2
+	NoiseGenerator noiseGenerator;
+
 	// --- 32-bit register for RS&H
 	uint32_t pnRegister = 0;			///< 32 bit register for PN oscillator
 	int randomSHCounter = -1;			///< random sample/hold counter;  -1 is reset condition
@@ -1,49 +1,98 @@
-
 #ifndef __wavedata_h__
 #define __wavedata_h__
 
+// --- includes
+#include "mappedfile.h"
+#include <memory>
+
 // This is a helper object for reading Wave files into floating point buffers.
-// It is NOT optimized for speed (yet)
-#if defined _WINDOWS || defined _WINDLL
-//#include <windows.h>
+//
+// THE FOLLOWING TYPES ARE SUPPORTED:
+//
+// WAVE_FORMAT_PCM, WAVE_FORMAT_IEEE_FLOAT and WAVE_FORMAT_EXTENSIBLE
+//
+// 16-BIT Signed Integer PCM
+// 24-BIT Signed Integer PCM 3-ByteAlign
+// 24-BIT Signed Integer PCM 4-ByteAlign
+// 32-BIT Signed Integer PCM
+// 32-BIT Floating Point
+// 64-BIT Floating Point
+
+// --- how the sample words are stored in the data chunk
+enum class WaveSampleEncoding { kUnsupported, kPCM16, kPCM24, kPCM32, kFloat32, kFloat64 };
+
+/**
+\struct WaveFileInfo
+\ingroup SynthStructures
+\brief Everything found in the fmt, data and smpl chunks of a WAV file; filled in by one pass
+over the chunk list.
+*/
+struct WaveFileInfo
+{
+	uint32_t formatTag = 0;			///< 1 = PCM, 3 = float (extensible files report their sub-format)
+	uint32_t numChannels = 0;
+	uint32_t sampleRate = 0;
+	uint32_t bitsPerSample = 0;
+	uint32_t blockAlign = 0;		///< bytes per frame
+	WaveSampleEncoding encoding = WaveSampleEncoding::kUnsupported;
+
+	uint64_t dataOffset = 0;		///< byte offset of the first frame
+	uint64_t frameCount = 0;		///< clipped to what is actually in the file
+
+	// --- smpl chunk; loop points are in frames
+	bool hasSampleChunk = false;
+	uint32_t midiNote = 0;
+	uint32_t midiPitchFraction = 0;
+	uint32_t smpteFormat = 0;
+	uint32_t smpteOffset = 0;
+	uint32_t loopCount = 0;
+	uint32_t loopType = 0;			///< first loop only: 0 = forward, 1 = ping-pong, 2 = reverse
+	uint32_t loopStartFrame = 0;
+	uint32_t loopEndFrame = 0;
+};
 
-// wave file parser
-class WaveData
+/**
+\class WaveFileReader
+\ingroup SynthClasses
+\brief Memory-maps a WAV file, parses its chunks once and decodes any window of frames to
+interleaved float32 on demand; nothing is decoded until asked for, so a large file can be
+opened and streamed without reading it all.
+
+readFrames( ) is const and only reads the mapping so several threads may decode from one reader.
+*/
+class WaveFileReader
 {
-public:	// Functions
-	//
-	// One Time Initialization
-	// pFilePath is the FULLY qualified file name + additional path info
-	// VALID Examples: audio.wav
-	//				   //samples//audio.wav
-	WaveData(const char* pFilePath);
+public:
+	WaveFileReader() { }
+	~WaveFileReader() { close(); }
 
-	// One Time Destruction
-	~WaveData(void);
+	// --- map and parse; returns false with a reason if the file is not a WAV we can decode
+	bool open(const std::string& filePath, std::string* errorString = nullptr);
+	void close();
 
-	unsigned int m_uNumChannels;
-	unsigned int m_uSampleRate;
-	unsigned int m_uSampleCount;
-	unsigned int m_uLoopCount;
-	unsigned int m_uLoopStartIndex;
-	unsigned int m_uLoopEndIndex;
-	unsigned int m_uLoopType;
-	unsigned int m_uMIDINote;
-	unsigned int m_uMIDIPitchFraction;
-	unsigned int m_uSMPTEFormat;
-	unsigned int m_uSMPTEOffset;
-
-	bool m_bWaveLoaded;
-
-	// --- the WAV file converted to floats on range of -1.0 --> +1.0
-	float* m_pWaveBuffer = nullptr;
+	bool isOpen() const { return info.encoding != WaveSampleEncoding::kUnsupported; }
+	const WaveFileInfo& getInfo() const { return info; }
 
-protected:
-	bool readWaveFile(const char* pFilePath);
-	void* m_hFile;
+	// --- decode frames [startFrame, startFrame + frameCount) as interleaved floats on the range
+	//     of -1.0 --> +1.0; returns the number of frames written (clipped at the end of the file)
+	uint64_t readFrames(uint64_t startFrame, uint64_t frameCount, float* dest) const;
+
+	// --- hint that a window of frames will be read soon
+	void prefetchFrames(uint64_t startFrame, uint64_t frameCount) const;
+
+private:
+	MappedFile file;
+	WaveFileInfo info;
+
+	bool parseChunks(std::string* errorString);
 };
 
-#else // MacOS Version here!
+// --- bulk converters to float -1.0 --> +1.0; src may be unaligned, count is in samples (not frames)
+void convertPCM16ToFloat(const uint8_t* src, float* dest, uint64_t count);
+void convertPCM24ToFloat(const uint8_t* src, float* dest, uint64_t count);
+void convertPCM32ToFloat(const uint8_t* src, float* dest, uint64_t count);
+void convertFloat32ToFloat(const uint8_t* src, float* dest, uint64_t count);
+void convertFloat64ToFloat(const uint8_t* src, float* dest, uint64_t count);
 
 // wave file parser
 class WaveData
@@ -54,32 +103,55 @@ public:	// Functions
 	// pFilePath is the FULLY qualified file name + additional path info
 	// VALID Examples: audio.wav
 	//				   //samples//audio.wav
-	WaveData(const char* pFilePath);
+	//
+	// streamFromDisk = true keeps the file mapped and leaves m_pWaveBuffer = nullptr;
+	// use readFrames( ) to decode windows of audio as they are needed
+	WaveData(const char* pFilePath, bool streamFromDisk = false);
 
 	// One Time Destruction
 	~WaveData(void);
 
-	UINT m_uNumChannels;
-	UINT m_uSampleRate;
-	UINT m_uSampleCount;
-	UINT m_uLoopCount;
-	UINT m_uLoopStartIndex;
-	UINT m_uLoopEndIndex;
-	UINT m_uLoopType;
-	UINT m_uMIDINote;
-	UINT m_uMIDIPitchFraction;
-	UINT m_uSMPTEFormat;
-	UINT m_uSMPTEOffset;
+	unsigned int m_uNumChannels = 0;
+	unsigned int m_uSampleRate = 0;
+	unsigned int m_uSampleCount = 0;		///< interleaved samples = frames * channels
+	unsigned int m_uLoopCount = 0;
+	unsigned int m_uLoopStartIndex = 0;		///< interleaved sample index
+	unsigned int m_uLoopEndIndex = 0;		///< interleaved sample index
+	unsigned int m_uLoopType = 0;
+	unsigned int m_uMIDINote = 0;
+	unsigned int m_uMIDIPitchFraction = 0;
+	unsigned int m_uSMPTEFormat = 0;
+	unsigned int m_uSMPTEOffset = 0;
+
+	bool m_bWaveLoaded = false;
+	std::string m_strLoadError;				///< why m_bWaveLoaded is false
+
+	// --- the WAV file converted to floats on range of -1.0 --> +1.0 (nullptr when streaming);
+	//     followed by one zeroed guard frame so interpolators can read frame n + 1
+	float* m_pWaveBuffer = nullptr;
 
-	bool m_bWaveLoaded;
+	// --- streaming access; also works on a fully loaded file
+	bool isStreaming() const { return streamReader != nullptr; }
+	uint64_t getFrameCount() const { return m_uNumChannels > 0 ? m_uSampleCount / m_uNumChannels : 0; }
+	uint64_t readFrames(uint64_t startFrame, uint64_t frameCount, float* dest) const;
+	void prefetchFrames(uint64_t startFrame, uint64_t frameCount) const;
 
-	// the WAV file converted to floats on range of -1.0 --> +1.0
-	float* m_pWaveBuffer;
+	// --- the head is the start of the file held in RAM so playback can begin before a stream
+	//     catches up; like m_pWaveBuffer it has one guard frame after getHeadFrames( ) frames.
+	//     A fully loaded file is all head.
+	bool preloadHead(uint64_t frameCount);
+	const float* getHeadBuffer() const { return streamReader ? headBuffer.data() : m_pWaveBuffer; }
+	uint64_t getHeadFrames() const { return streamReader ? headFrames : getFrameCount(); }
 
 protected:
-	bool readWaveFile(const char* pFilePath);
+	bool readWaveFile(const char* pFilePath, bool streamFromDisk);
+
+	// --- kept open in streaming mode only
+	std::unique_ptr<WaveFileReader> streamReader;
+
+	// --- streaming mode head
+	std::vector<float> headBuffer;
+	uint64_t headFrames = 0;
 };
 
 #endif
-
-#endif
\ No newline at end of file
@@ -0,0 +1,299 @@
+// --- Synth Core v1.0
+//
+#include "wavesampledata.h"
+
+#include <algorithm>
+#include <cctype>
+
+#if defined _WINDOWS || defined _WINDLL
+#include <windows.h>
+const std::string kSamplePathSeparator = "\\";
+#else
+#include <sys/stat.h>
+#include <dirent.h>
+const std::string kSamplePathSeparator = "/";
+#endif
+
+// --- sorted names of the .wav files and subfolders in a folder (not recursive)
+static bool listSampleFolder(const std::string& folderPath, std::vector<std::string>& waveFiles, std::vector<std::string>& subFolders)
+{
+	std::vector<std::pair<std::string, bool>> entries; // --- name, isFolder
+
+#if defined _WINDOWS || defined _WINDLL
+	WIN32_FIND_DATAA findData;
+	HANDLE hFind = FindFirstFileA((folderPath + kSamplePathSeparator + "*").c_str(), &findData);
+	if (hFind == INVALID_HANDLE_VALUE)
+		return false;
+
+	do
+	{
+		entries.push_back(std::make_pair(std::string(findData.cFileName), (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0));
+	} while (FindNextFileA(hFind, &findData));
+
+	FindClose(hFind);
+#else
+	DIR* dir = opendir(folderPath.c_str());
+	if (!dir)
+		return false;
+
+	while (struct dirent* entry = readdir(dir))
+	{
+		std::string name = entry->d_name;
+		struct stat fileStat;
+		if (stat((folderPath + kSamplePathSeparator + name).c_str(), &fileStat) != 0)
+			continue;
+
+		entries.push_back(std::make_pair(name, S_ISDIR(fileStat.st_mode)));
+	}
+
+	closedir(dir);
+#endif
+
+	for (auto& entry : entries)
+	{
+		const std::string& name = entry.first;
+		if (name.empty() || name[0] == '.')
+			continue;
+
+		if (entry.second)
+		{
+			subFolders.push_back(name);
+			continue;
+		}
+
+		// --- .wav or .WAV
+		if (name.size() > 4)
+		{
+			std::string extension = name.substr(name.size() - 4);
+			std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+			if (extension == ".wav")
+				waveFiles.push_back(name);
+		}
+	}
+
+	std::sort(waveFiles.begin(), waveFiles.end());
+	std::sort(subFolders.begin(), subFolders.end());
+
+	return true;
+}
+
+// --- WaveSampleSource ---------------------------------------------------------------------
+bool WaveSampleSource::midiNoteFromFileName(const std::string& fileName, uint32_t& midiNote)
+{
+	for (size_t i = 0; i < fileName.size(); i++)
+	{
+		if (!isdigit((unsigned char)fileName[i]))
+			continue;
+
+		uint32_t number = 0;
+		size_t j = i;
+		while (j < fileName.size() && isdigit((unsigned char)fileName[j]) && number < 1000)
+			number = number * 10 + (fileName[j++] - '0');
+
+		if (number <= 127)
+		{
+			midiNote = number;
+			return true;
+		}
+		i = j;
+	}
+
+	return false;
+}
+
+void WaveSampleSource::createWaveSamples(std::string sampleFolder, SampleLoopMode _loopMode)
+{
+	loopMode = _loopMode;
+	waveSamples.clear();
+	loadErrors.clear();
+
+	// --- the folder name is the set name
+	size_t separator = sampleFolder.find_last_of("/\\");
+	sampleSetName = separator == std::string::npos ? sampleFolder : sampleFolder.substr(separator + 1);
+
+	std::vector<std::string> waveFiles;
+	std::vector<std::string> subFolders;
+	if (!listSampleFolder(sampleFolder, waveFiles, subFolders))
+		return;
+
+	for (auto& fileName : waveFiles)
+	{
+		if (waveSamples.size() >= kMaxWaveSamples)
+		{
+			loadErrors.push_back(fileName + ": more than " + std::to_string(kMaxWaveSamples) + " samples in the folder");
+			continue;
+		}
+
+		// --- map and parse only; nothing is decoded yet
+		std::string filePath = sampleFolder + kSamplePathSeparator + fileName;
+		std::unique_ptr<WaveData> waveData(new WaveData(filePath.c_str(), true));
+		if (!waveData->m_bWaveLoaded)
+		{
+			loadErrors.push_back(fileName + ": " + waveData->m_strLoadError);
+			continue;
+		}
+		if (waveData->getFrameCount() == 0)
+		{
+			loadErrors.push_back(fileName + ": no audio");
+			continue;
+		}
+
+		WaveSampleInfo info;
+		info.fileName = fileName;
+
+		// --- unity note: smpl chunk, then file name, then middle C
+		if (waveData->m_uMIDINote > 0 && waveData->m_uMIDINote <= 127)
+			info.unityMIDINote = waveData->m_uMIDINote;
+		else
+			midiNoteFromFileName(fileName, info.unityMIDINote);
+
+		// --- loop points (smpl loop end is inclusive)
+		const uint64_t frameCount = waveData->getFrameCount();
+		const uint32_t numChannels = waveData->m_uNumChannels;
+		if (loopMode != SampleLoopMode::kOneShot)
+		{
+			uint64_t loopStart = waveData->m_uLoopStartIndex / numChannels;
+			uint64_t loopEnd = std::min((uint64_t)(waveData->m_uLoopEndIndex / numChannels) + 1, frameCount);
+
+			if (waveData->m_uLoopCount > 0 && loopEnd > loopStart + 1)
+			{
+				info.loopStartFrame = loopStart;
+				info.loopEndFrame = loopEnd;
+				info.loopType = waveData->m_uLoopType <= 2 ? waveData->m_uLoopType : 0;
+			}
+			else if (loopMode == SampleLoopMode::kLoop)
+			{
+				info.loopStartFrame = 0;
+				info.loopEndFrame = frameCount;
+			}
+		}
+
+		// --- short loops live in RAM; long ones are streamed and can only run forward
+		uint64_t headFrames = kSampleHeadFrames;
+		if (info.loopEndFrame > 0 && info.loopEndFrame <= kMaxResidentLoopFrames)
+		{
+			headFrames = std::max(headFrames, info.loopEndFrame);
+			info.isLoopResident = true;
+		}
+		else
+			info.loopType = 0;
+
+		waveData->preloadHead(headFrames);
+
+		info.waveData = std::move(waveData);
+		waveSamples.push_back(std::move(info));
+	}
+
+	std::stable_sort(waveSamples.begin(), waveSamples.end(),
+		[](const WaveSampleInfo& a, const WaveSampleInfo& b) { return a.unityMIDINote < b.unityMIDINote; });
+
+	// --- nearest sample for every note; ties go to the higher sample (pitched down)
+	for (uint32_t note = 0; note < 128; note++)
+	{
+		uint32_t bestIndex = 0;
+		int bestDistance = 1000;
+		for (uint32_t i = 0; i < waveSamples.size(); i++)
+		{
+			int distance = abs((int)waveSamples[i].unityMIDINote - (int)note);
+			if (distance <= bestDistance)
+			{
+				bestDistance = distance;
+				bestIndex = i;
+			}
+		}
+		noteMap[note] = bestIndex;
+	}
+}
+
+const WaveData* WaveSampleSource::selectWaveSample(double oscillatorFrequency, uint32_t& midiNoteNumber)
+{
+	if (waveSamples.empty())
+		return nullptr;
+
+	const WaveSampleInfo& info = waveSamples[noteMap[midiNoteNumberFromOscFrequency(oscillatorFrequency)]];
+	midiNoteNumber = info.unityMIDINote;
+
+	return info.waveData.get();
+}
+
+const WaveSampleInfo* WaveSampleSource::getWaveSampleInfo(const WaveData* waveData)
+{
+	for (auto& info : waveSamples)
+	{
+		if (info.waveData.get() == waveData)
+			return &info;
+	}
+
+	return nullptr;
+}
+
+// --- WaveSampleData -----------------------------------------------------------------------
+WaveSampleData::WaveSampleData()
+	: setsLoaded(false)
+	, streamer(new SampleStreamer)
+{
+}
+
+WaveSampleData::~WaveSampleData()
+{
+	// --- stop the I/O thread before the samples go away
+	streamer.reset();
+}
+
+uint32_t WaveSampleData::createSampleSets(const std::string& samplesFolder, SampleLoopMode loopMode)
+{
+	// --- one time only; the audio thread reads the sets without a lock
+	if (setsLoaded.load())
+		return sampleSets.size();
+
+	std::vector<std::string> waveFiles;
+	std::vector<std::string> subFolders;
+	listSampleFolder(samplesFolder, waveFiles, subFolders);
+
+	// --- loose files in the top folder make a set too
+	std::vector<std::string> setFolders;
+	if (!waveFiles.empty())
+		setFolders.push_back(samplesFolder);
+	for (auto& subFolder : subFolders)
+		setFolders.push_back(samplesFolder + kSamplePathSeparator + subFolder);
+
+	for (auto& setFolder : setFolders)
+	{
+		if (sampleSets.size() >= kMaxWaveSampleSets)
+		{
+			loadErrors.push_back(setFolder + ": more than " + std::to_string(kMaxWaveSampleSets) + " sample folders");
+			continue;
+		}
+
+		std::unique_ptr<WaveSampleSource> sampleSet(new WaveSampleSource);
+		sampleSet->createWaveSamples(setFolder, loopMode);
+		for (auto& loadError : sampleSet->getLoadErrors())
+			loadErrors.push_back(setFolder + kSamplePathSeparator + loadError);
+
+		if (sampleSet->getWaveSampleCount() > 0)
+			sampleSets.push_back(std::move(sampleSet));
+	}
+
+	setsLoaded.store(true, std::memory_order_release);
+	return sampleSets.size();
+}
+
+WaveSampleSource* WaveSampleData::getInterface(uint32_t sampleSetIndex)
+{
+	if (!setsLoaded.load(std::memory_order_acquire) || sampleSetIndex >= sampleSets.size())
+		return nullptr;
+
+	return sampleSets[sampleSetIndex].get();
+}
+
+std::vector<std::string> WaveSampleData::getSampleSetNames()
+{
+	std::vector<std::string> names;
+	if (!setsLoaded.load(std::memory_order_acquire))
+		return names;
+
+	for (auto& sampleSet : sampleSets)
+		names.push_back(sampleSet->getSampleSetName());
+
+	return names;
+}
@@ -0,0 +1,113 @@
+#ifndef __waveSampleData_h__
+#define __waveSampleData_h__
+
+// --- includes
+#include "synthdefs.h"
+#include "wavedata.h"
+#include "samplestreamer.h"
+
+// --- frames of every sample decoded into RAM at load time; covers the I/O thread's start-up
+//     latency (about 0.34 sec at 48kHz and unity pitch)
+const uint32_t kSampleHeadFrames = 16384;
+
+// --- loops that end before this are made resident in the head so the voice can play them
+//     in any direction without the I/O thread (about 5.5 sec at 48kHz)
+const uint32_t kMaxResidentLoopFrames = 262144;
+
+// --- up to 128 samples per folder, 32 folders (the waveform index range)
+const uint32_t kMaxWaveSamples = 128;
+const uint32_t kMaxWaveSampleSets = 32;
+
+/**
+\struct WaveSampleInfo
+\ingroup SynthStructures
+\brief One streamed sample with the playback decisions made at load time.
+*/
+struct WaveSampleInfo
+{
+	std::unique_ptr<WaveData> waveData;
+	std::string fileName;
+	uint32_t unityMIDINote = 60;	///< from the smpl chunk, else from the file name
+
+	// --- loop in frames; loopEndFrame is exclusive and 0 means no loop
+	uint64_t loopStartFrame = 0;
+	uint64_t loopEndFrame = 0;
+	uint32_t loopType = 0;			///< 0 = forward, 1 = ping-pong, 2 = reverse
+	bool isLoopResident = false;	///< the whole loop is inside the head
+};
+
+/**
+\class WaveSampleSource
+\ingroup SynthClasses
+\brief A folder of WAV files played as one multisample; each file is opened in streaming mode
+and only its head is decoded, so opening a multi-gigabyte folder costs kSampleHeadFrames per
+file. Samples are mapped to MIDI notes by their unity note.
+*/
+class WaveSampleSource : public IWaveSample
+{
+public:
+	WaveSampleSource() { }
+	virtual ~WaveSampleSource() { }
+
+	// --- IWaveSample
+	virtual void createWaveSamples(std::string sampleFolder, SampleLoopMode _loopMode);
+	virtual const WaveData* selectWaveSample(double oscillatorFrequency, uint32_t& midiNoteNumber);
+	virtual SampleLoopMode getLoopMode() { return loopMode; }
+	virtual uint32_t getWaveSampleCount() { return waveSamples.size(); }
+
+	// --- the loop and resident decisions for a sample returned by selectWaveSample( )
+	const WaveSampleInfo* getWaveSampleInfo(const WaveData* waveData);
+
+	std::string getSampleSetName() { return sampleSetName; }
+
+	// --- "file: reason" for every WAV file in the folder that was not loaded
+	const std::vector<std::string>& getLoadErrors() { return loadErrors; }
+
+private:
+	std::vector<WaveSampleInfo> waveSamples; // --- sorted by unity note
+	std::vector<std::string> loadErrors;
+	uint32_t noteMap[128] = { 0 };			 // --- MIDI note -> nearest sample
+	SampleLoopMode loopMode = SampleLoopMode::kSustain;
+	std::string sampleSetName;
+
+	// --- first number 0 - 127 in the file name, e.g. Piano_060.wav
+	static bool midiNoteFromFileName(const std::string& fileName, uint32_t& midiNote);
+};
+
+// --- stores up to kMaxWaveSampleSets folders of samples plus the I/O thread that streams them
+//     NOTE: this is the ONE AND ONLY wavesample datasource for the entire synth
+//
+//     Sets are created once in SynthEngine::initialize( ) before audio starts; getInterface( )
+//     returns nullptr until then.
+class WaveSampleData
+{
+public:
+	WaveSampleData();
+	~WaveSampleData();
+
+	// --- each subfolder of samplesFolder with WAV files becomes a set; returns the number of sets
+	uint32_t createSampleSets(const std::string& samplesFolder, SampleLoopMode loopMode = SampleLoopMode::kSustain);
+
+	// --- nullptr if the set does not exist (or nothing is loaded yet)
+	WaveSampleSource* getInterface(uint32_t sampleSetIndex);
+
+	uint32_t getNumSampleSets() { return setsLoaded.load(std::memory_order_acquire) ? sampleSets.size() : 0; }
+	std::vector<std::string> getSampleSetNames();
+
+	// --- "folder/file: reason" for every WAV file that was not loaded, including those of
+	//     folders that ended up with no playable samples
+	std::vector<std::string> getLoadErrors() { return setsLoaded.load(std::memory_order_acquire) ? loadErrors : std::vector<std::string>(); }
+
+	// --- for the oscillators' streams
+	SampleStreamer* getStreamer() { return streamer.get(); }
+
+private:
+	std::vector<std::unique_ptr<WaveSampleSource>> sampleSets;
+	std::vector<std::string> loadErrors;
+	std::atomic<bool> setsLoaded;
+
+	// --- declared last so the I/O thread stops before the samples it reads are destroyed
+	std::unique_ptr<SampleStreamer> streamer;
+};
+
+#endif /* defined(__waveSampleData_h__) */
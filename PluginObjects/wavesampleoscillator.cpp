@@ -0,0 +1,273 @@
+// --- Synth Core v1.0
+//
+#include "wavesampleoscillator.h"
+
+// --- oscillator
+WaveSampleOsc::WaveSampleOsc(const std::shared_ptr<MidiInputData> _midiInputData,
+							 std::shared_ptr<SynthOscParameters> _parameters,
+							 std::shared_ptr<WaveTableData> _waveTableData,
+							 std::shared_ptr<WaveSampleData> _waveSampleData)
+	: WaveTableOsc(_midiInputData, _parameters, _waveTableData)
+	, waveSampleData(_waveSampleData)
+{
+	if (!waveSampleData)
+		waveSampleData = std::make_shared<WaveSampleData>();
+
+	// --- one stream per oscillator, serviced by the shared I/O thread
+	sampleStream = waveSampleData->getStreamer()->createStream();
+}
+
+WaveSampleOsc::~WaveSampleOsc()
+{
+	stopSample();
+	waveSampleData->getStreamer()->removeStream(sampleStream);
+}
+
+void WaveSampleOsc::stopSample()
+{
+	if (currentBlock)
+		sampleStream->releaseBlock(currentBlock);
+	currentBlock = nullptr;
+
+	sampleStream->stop();
+	selectedSample = nullptr;
+	selectedSampleInfo = nullptr;
+	sampleFinished = true;
+}
+
+// --- ISynthOscillator
+bool WaveSampleOsc::reset(double _sampleRate)
+{
+	WaveTableOsc::reset(_sampleRate);
+
+	stopSample();
+	underrunCount = 0;
+
+	return true;
+}
+
+bool WaveSampleOsc::doNoteOn(double midiPitch, uint32_t _midiNoteNumber, uint32_t midiNoteVelocity)
+{
+	WaveTableOsc::doNoteOn(midiPitch, _midiNoteNumber, midiNoteVelocity);
+
+	// --- samples always restart; free-run does not apply
+	stopSample();
+
+	// --- no disk traffic for voices that are not playing samples
+	if (parameters->oscType != SynthOscType::kWaveSample)
+		return true;
+
+	WaveSampleSource* sampleSet = waveSampleData->getInterface(parameters->oscillatorWaveformIndex);
+	if (!sampleSet)
+		return true;
+
+	uint32_t unityMIDINote = 60;
+	loopMode = sampleSet->getLoopMode();
+	selectedSample = sampleSet->selectWaveSample(midiPitch, unityMIDINote);
+	selectedSampleInfo = sampleSet->getWaveSampleInfo(selectedSample);
+	if (!selectedSample || !selectedSampleInfo)
+	{
+		selectedSample = nullptr;
+		return true;
+	}
+
+	// --- smpl pitch fraction is in 1/2^32 semitone
+	double pitchFraction = (double)selectedSample->m_uMIDIPitchFraction / 4294967296.0;
+	unityFrequency = midiNoteNumberToOscFrequency(unityMIDINote) * pow(2.0, pitchFraction / 12.0);
+
+	headBuffer = selectedSample->getHeadBuffer();
+	headFrames = selectedSample->getHeadFrames();
+	samplePosition = 0.0;
+	playDirection = 1.0;
+	readingBlocks = false;
+	sampleFinished = false;
+	loopActive = selectedSampleInfo->loopEndFrame > 0;
+
+	// --- stream everything after the head unless a resident loop will play forever
+	bool needsStream = headFrames < selectedSample->getFrameCount();
+	if (loopMode == SampleLoopMode::kLoop && selectedSampleInfo->isLoopResident)
+		needsStream = false;
+
+	if (needsStream)
+		sampleStream->start(selectedSample, headFrames, selectedSampleInfo->loopStartFrame, selectedSampleInfo->loopEndFrame, loopActive);
+
+	return true;
+}
+
+bool WaveSampleOsc::doNoteOff(double midiPitch, uint32_t _midiNoteNumber, uint32_t midiNoteVelocity)
+{
+	// --- sustain loops let go and run on to the end; the EG does the rest
+	if (loopMode == SampleLoopMode::kSustain)
+	{
+		loopActive = false;
+		playDirection = 1.0;
+		sampleStream->setLooping(false);
+	}
+
+	return true;
+}
+
+bool WaveSampleOsc::update(bool updateAllModRoutings)
+{
+	// --- Run priority modulators
+	// --- note that this is a dummy call, just to keep the glide modulator synced
+	glideModulator.getNextGlideModSemitones();
+
+	// --- End Priority modulators
+	if (!updateAllModRoutings)
+		return true;
+
+	// --- pitch calculation, shared with the wavetable oscillators
+	calculateOscillatorFrequency();
+
+	// --- file frames per output sample
+	if (selectedSample && sampleRate > 0.0)
+		sampleInc = (oscillatorFrequency / unityFrequency) * ((double)selectedSample->m_uSampleRate / sampleRate);
+	else
+		sampleInc = 0.0;
+
+	return true;
+}
+
+const OscillatorOutputData WaveSampleOsc::renderAudioOutput()
+{
+	// --- prep output buffer
+	oscillatorAudioData.outputs[0] = 0.0;
+	oscillatorAudioData.outputs[1] = 0.0;
+
+	if (sampleFinished)
+		return oscillatorAudioData;
+
+	double left = 0.0;
+	double right = 0.0;
+	if (readingBlocks ? readBlock(left, right) : readHead(left, right))
+	{
+		// --- scale by output amplitude
+		double amplitude = parameters->outputAmplitude * modulators->modulationInputs[kAmpMod];
+		oscillatorAudioData.outputs[0] = left * amplitude;
+		oscillatorAudioData.outputs[1] = right * amplitude;
+	}
+
+	return oscillatorAudioData;
+}
+
+// --- head playback, with resident loops
+bool WaveSampleOsc::readHead(double& left, double& right)
+{
+	const uint32_t numChannels = selectedSample->m_uNumChannels;
+	const uint32_t rightChannel = numChannels > 1 ? 1 : 0;
+	const bool residentLoop = loopActive && selectedSampleInfo->isLoopResident;
+	const uint64_t loopStart = selectedSampleInfo->loopStartFrame;
+	const uint64_t loopEnd = selectedSampleInfo->loopEndFrame;
+
+	// --- the head has a guard frame; only a forward loop has to wrap for interpolation
+	uint64_t index = (uint64_t)samplePosition;
+	uint64_t nextIndex = index + 1;
+	if (residentLoop && selectedSampleInfo->loopType == 0 && nextIndex >= loopEnd)
+		nextIndex = loopStart;
+
+	double fraction = samplePosition - (double)index;
+	const float* frame = headBuffer + index * numChannels;
+	const float* nextFrame = headBuffer + nextIndex * numChannels;
+	left = frame[0] + fraction * (nextFrame[0] - frame[0]);
+	right = frame[rightChannel] + fraction * (nextFrame[rightChannel] - frame[rightChannel]);
+
+	// --- advance
+	samplePosition += sampleInc * playDirection;
+
+	if (residentLoop)
+	{
+		const double loopLength = (double)(loopEnd - loopStart);
+		const double lastFrame = (double)(loopEnd - 1);
+		if (playDirection > 0.0 && samplePosition >= (double)loopEnd)
+		{
+			// --- forward wraps; ping-pong and reverse turn around at the end
+			if (selectedSampleInfo->loopType == 0)
+				samplePosition -= loopLength;
+			else
+			{
+				samplePosition = lastFrame - (samplePosition - (double)loopEnd);
+				playDirection = -1.0;
+			}
+		}
+		else if (playDirection < 0.0 && samplePosition < (double)loopStart)
+		{
+			// --- ping-pong turns around, reverse jumps back to the end
+			if (selectedSampleInfo->loopType == 1)
+			{
+				samplePosition = (double)loopStart + ((double)loopStart - samplePosition);
+				playDirection = 1.0;
+			}
+			else
+				samplePosition += loopLength;
+		}
+
+		// --- a loop shorter than one increment
+		boundValue(samplePosition, (double)loopStart, lastFrame);
+	}
+	else if (samplePosition < 0.0)
+		samplePosition = 0.0;
+
+	// --- off the end of the head: the stream takes over, or we are done
+	if (samplePosition >= (double)headFrames)
+	{
+		if (headFrames >= selectedSample->getFrameCount())
+			sampleFinished = true;
+		else
+		{
+			samplePosition -= (double)headFrames;
+			readingBlocks = true;
+		}
+	}
+
+	return true;
+}
+
+// --- stream playback; blocks arrive in play order with streamed loops already unrolled
+bool WaveSampleOsc::readBlock(double& left, double& right)
+{
+	if (!currentBlock)
+	{
+		currentBlock = sampleStream->getNextBlock();
+		if (!currentBlock)
+		{
+			underrunCount++;
+			return false;
+		}
+	}
+
+	const uint32_t numChannels = currentBlock->numChannels;
+	const uint32_t rightChannel = numChannels > 1 ? 1 : 0;
+
+	// --- every block has a guard frame
+	uint64_t index = (uint64_t)samplePosition;
+	double fraction = samplePosition - (double)index;
+	const float* frame = currentBlock->samples.data() + index * numChannels;
+	const float* nextFrame = frame + numChannels;
+	left = frame[0] + fraction * (nextFrame[0] - frame[0]);
+	right = frame[rightChannel] + fraction * (nextFrame[rightChannel] - frame[rightChannel]);
+
+	// --- advance, crossing into the next block(s) if needed
+	samplePosition += sampleInc;
+	while (samplePosition >= (double)currentBlock->frameCount)
+	{
+		samplePosition -= (double)currentBlock->frameCount;
+
+		bool lastBlock = currentBlock->isLastBlock;
+		sampleStream->releaseBlock(currentBlock);
+		currentBlock = nullptr;
+
+		if (lastBlock)
+		{
+			sampleFinished = true;
+			break;
+		}
+
+		// --- nullptr is an underrun; we try again next sample
+		currentBlock = sampleStream->getNextBlock();
+		if (!currentBlock)
+			break;
+	}
+
+	return true;
+}
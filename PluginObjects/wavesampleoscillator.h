@@ -0,0 +1,84 @@
+#ifndef __waveSampleOscillator_h__
+#define __waveSampleOscillator_h__
+
+// --- includes
+#include "synthdefs.h"
+#include "wavetableoscillator.h"
+#include "wavesampledata.h"
+
+/**
+\class WaveSampleOsc
+\ingroup SynthClasses
+\brief Sample playback oscillator; plays the multisample selected with
+SynthOscParameters::oscillatorWaveformIndex from WaveSampleData.
+
+Playback starts in the sample's head (RAM) and continues from blocks that the SampleStreamer's
+I/O thread decodes ahead of it, so render never touches the disk. Loops come from the smpl chunk
+and follow the set's SampleLoopMode; resident loops play forward, ping-pong or reverse, streamed
+loops play forward. If the stream falls behind, the oscillator outputs silence and waits rather
+than skipping audio.
+
+Pitch and glide are shared with WaveTableOsc; detuneCents, hard sync and the unison lanes are not
+used (SynthEngine does unison for this oscillator with detuned voices).
+*/
+class WaveSampleOsc : public WaveTableOsc
+{
+public:
+	WaveSampleOsc(const std::shared_ptr<MidiInputData> _midiInputData,
+				  std::shared_ptr<SynthOscParameters> _parameters,
+				  std::shared_ptr<WaveTableData> _waveTableData,
+				  std::shared_ptr<WaveSampleData> _waveSampleData);
+
+	virtual ~WaveSampleOsc();
+
+	// --- ISynthOscillator
+	virtual bool reset(double _sampleRate);
+	virtual bool update(bool updateAllModRoutings = true);
+	virtual bool doNoteOn(double midiPitch, uint32_t _midiNoteNumber, uint32_t midiNoteVelocity);
+	virtual bool doNoteOff(double midiPitch, uint32_t _midiNoteNumber, uint32_t midiNoteVelocity);
+
+	// --- **7** one bank; the waveforms are the sample sets
+	virtual std::vector<std::string> getWaveformNames(uint32_t bankIndex) { return waveSampleData->getSampleSetNames(); }
+	virtual std::vector<std::string> getBankNames() { return std::vector<std::string>(1, "WAV Samples"); }
+
+	// --- main render function
+	virtual const OscillatorOutputData renderAudioOutput();
+
+	// --- times the stream was not ready when needed
+	uint32_t getUnderrunCount() { return underrunCount; }
+
+protected:
+	// --- shared samples and our stream from the I/O thread
+	std::shared_ptr<WaveSampleData> waveSampleData = nullptr;
+	std::shared_ptr<SampleStream> sampleStream = nullptr;
+
+	// --- the playing sample
+	const WaveData* selectedSample = nullptr;
+	const WaveSampleInfo* selectedSampleInfo = nullptr;
+	double unityFrequency = 261.63;
+	double sampleInc = 0.0;			///< file frames per output sample
+
+	// --- head playback: samplePosition is a file frame
+	const float* headBuffer = nullptr;
+	uint64_t headFrames = 0;
+	double playDirection = 1.0;
+	SampleLoopMode loopMode = SampleLoopMode::kSustain;
+	bool loopActive = false;		///< looping now (sustain mode turns it off at note-off)
+
+	// --- block playback: samplePosition is an offset into currentBlock
+	bool readingBlocks = false;
+	SampleStreamBlock* currentBlock = nullptr;
+
+	double samplePosition = 0.0;
+	bool sampleFinished = true;
+	uint32_t underrunCount = 0;
+
+	// --- read and advance; false when there is nothing to play
+	bool readHead(double& left, double& right);
+	bool readBlock(double& left, double& right);
+
+	// --- release whatever we are holding and stop the stream
+	void stopSample();
+};
+
+#endif /* defined(__waveSampleOscillator_h__) */
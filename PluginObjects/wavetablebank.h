@@ -6,6 +6,10 @@
 
 // --- wavetable objects and structs
 #include "wavetable.h"
+#include "brickfile.h"
+#include "bandlimitedtables.h"
+
+#include <map>
 
 // --- max banks per plugin
 // const uint32_t MAX_BANKS_PER_PLUGIN = 8;// 128;
@@ -47,9 +51,6 @@ const uint32_t MAX_TABLES_PER_BANK = 32;
 //	BANK_SET_30, BANK_SET_31
 //};
 
-// --- for burnt in or on-the-fly calculated tables
-enum wtWaveFormIndex { SINE_WAVE, PARABOLIC_WAVE, TRIANGLE_WAVE };
-
 // --- helper to make x4 bank sets
 inline uint32_t getBankIndex(uint32_t bankSet, uint32_t oscillatorBankIndex) { return (bankSet * MAX_BANKS_PER_OSCILLATOR) + oscillatorBankIndex; }
 
@@ -87,37 +88,75 @@ public:
 		enabled = true;
 	}
 
+	// --- from a directory of brick files (user banks); loads up to MAX_TABLES_PER_BANK
+	//     entries starting at firstEntry, skipping any that fail to load
+	inline uint32_t initializeWithBrickFileIndex(BrickFileIndex& brickFileIndex, uint32_t firstEntry = 0)
+	{
+		const std::vector<BrickFileInfo>& entries = brickFileIndex.getEntries();
+
+		for (uint32_t i = firstEntry; i < entries.size() && wavetables.size() < MAX_TABLES_PER_BANK; i++)
+		{
+			Wavetable* wt = new Wavetable;
+			if (wt->initWithBrickFile(entries[i].filePath))
+				this->addWaveTable(wt);
+			else
+				delete wt;
+		}
+
+		// --- we are enabled if anything loaded
+		enabled = wavetables.size() > 0;
+		return wavetables.size();
+	}
+
 	// ---- have tables destroy themselves
 	virtual ~WaveTableBank()
 	{
+		// --- generated tables belong to the shared table sets, not the Wavetable
+		for (uint32_t i = 0; i < generatedWaveTables.size(); i++)
+			memset(generatedWaveTables[i].wavetable->pdMultiTable128, 0, MAX_WAVE_TABLES*(sizeof(double*)));
+
 		for (int i = 0; i < wavetables.size(); i++)
 		{
-			wavetables[i]->destroyWaveTables();
+			delete wavetables[i];
 		}
 	}
 
 	// --- read a wavetable; this can vary considerably depending
 	//     on how you implement the wavetable itself; here I just
 	//     forward to the wavetable structure
-	inline virtual double readWaveTable(IWaveTable* selectedWT, double readIndex)
+	inline virtual double readWaveTable(IWaveTable* selectedWT, const WaveTableSelection& selection, double readIndex)
 	{
 		if (selectedWT == nullptr) return 0.0;
-		return selectedWT->readWaveTable(readIndex);
+		return selectedWT->readWaveTable(selection, readIndex);
 	}
 
 	// --- IWaveTable
+	//     HiResWTSets are remapped to the table slots that fit the new Nyquist; generated
+	//     multi-tables are swapped for a set built at this rate (kept, so switching back is instant)
+	//     NOTE: not realtime safe; call from reset() only
 	virtual bool resetWaveTables(double sampleRate)
 	{
 		if (!enabled)
 			return false;
 
+		for (uint32_t i = 0; i < wavetables.size(); i++)
+			wavetables[i]->setSampleRate(sampleRate);
+
+		for (uint32_t i = 0; i < generatedWaveTables.size(); i++)
+		{
+			GeneratedWaveTable& generated = generatedWaveTables[i];
+			const BandLimitedTableSet* tableSet = getGeneratedTableSet(generated, sampleRate);
+			if (tableSet)
+				memcpy(generated.wavetable->pdMultiTable128, tableSet->tables.data(), MAX_WAVE_TABLES*(sizeof(double*)));
+		}
+
 		return true;
 	}
 
 	// --- select a new table based on midi note and waveform
 	//     NOTE: the MIDI note number reflects the pitch-modulated oscillator value and always rounds
 	//           in the direction of NO aliasing (GUARANTEED)
-	virtual IWaveTable* selectTable(int oscillatorWaveformIndex, uint32_t midiNoteNumber, uint32_t& tableLen)
+	virtual IWaveTable* selectTable(int oscillatorWaveformIndex, uint32_t midiNoteNumber, WaveTableSelection& selection)
 	{
 		if (getNumWaveforms() <= 0)
 			return 0;
@@ -129,9 +168,7 @@ public:
 		IWaveTable* selectedWT = wavetables[oscillatorWaveformIndex];
 
 		// --- access Wavetable structure via vector container as array notation []
-		selectedWT->selectTable(midiNoteNumber);
-
-		tableLen = selectedWT->getWaveTableLength();
+		selection = selectedWT->selectTable(midiNoteNumber);
 
 		return selectedWT;
 	}
@@ -160,166 +197,49 @@ public:
 	virtual std::string getWaveBankName(){ return bankName; }
 	virtual void setWaveBankName(std::string _bankName){ bankName = _bankName; }
 
-	// --- create tables
-	bool createBandLimitedTables(uint32_t waveform, uint32_t tableInterval, double* multiTable128[MAX_WAVE_TABLES], uint32_t tableLength, double sampleRate)
+	// --- create tables: inverse FFT per table, spread over worker threads and cached on disk
+	//     (see BandLimitedTableGenerator); cacheDirectory = "" disables the cache
+	bool createBandLimitedTables(uint32_t waveform, uint32_t tableInterval, double* multiTable128[MAX_WAVE_TABLES], uint32_t tableLength, double sampleRate,
+								 std::string cacheDirectory = BandLimitedTableGenerator::getDefaultCacheDirectory())
 	{
-		unsigned int numTables = 0;
-		double seedFreq = 0.0;
-		uint32_t seedMIDINote = 0;
-
-		if (tableInterval == wtTableInterval::highRes)
-		{
-			seedFreq = pow(2.0, (-69.0 / 12.0)) * 440.0; // MIDI note 0 = 8.175.....
-			seedMIDINote = 0;
-			numTables = calculateNumTables(seedMIDINote, 1);
-		}
-		else if (tableInterval == wtTableInterval::octave)
-		{
-			seedFreq = 27.5; // --- Note A0, bottom of piano = 27.5Hz
-			seedMIDINote = 21;
-			numTables = calculateNumTables(seedMIDINote, 12);
-		}
-		else if (tableInterval == wtTableInterval::min3rd)
-		{
-			seedFreq = 27.5; // --- Note A0, bottom of piano = 27.5Hz
-			seedMIDINote = 21;
-			numTables = calculateNumTables(seedMIDINote, 3);
-		}
-
-		// --- create the tables
-		for (int j = 0; j < numTables; j++)
-		{
-			// --- create new buffer
-			double* tableAccumulator = new double[tableLength];
-			memset(tableAccumulator, 0, tableLength * sizeof(double));
-
-			int numHarmonics = (int)((sampleRate / 2.0 / seedFreq) - 1.0);
-
-			double maxTableValue = 0;
-			int halfNumHarmonics = (int)((double)numHarmonics / 2.0);
-
-			for (int i = 0; i < tableLength; i++)
-			{
-				// --- for bandlimited tables based on full harmonics
-				for (int g = 0; g <= numHarmonics; g++)
-				{
-					// --- some equations are based on half the total harmonics, such as triangle here
-					//     as it skips harmonics
-					if (waveform == wtWaveFormIndex::TRIANGLE_WAVE && g <= halfNumHarmonics)
-					{
-						// --- triangle
-						tableAccumulator[i] += generateTriangleHarmonic(i, double(g), tableLength);
-					}
-					if (waveform == wtWaveFormIndex::PARABOLIC_WAVE) // --- others are based on all harmonics in sequence
-					{
-						// --- Parabola Waveform
-						tableAccumulator[i] += generateParabolaHarmonic(i, double(g), tableLength);
-					}
-				}
-
-				// --- store the max values
-				if (i == 0)
-				{
-					maxTableValue = tableAccumulator[i];
-				}
-				else
-				{
-					// --- test and store
-					if (tableAccumulator[i] > maxTableValue)
-						maxTableValue = tableAccumulator[i];
-				}
-			}
-
-			// --- normalize
-			for (int i = 0; i < tableLength; i++)
-				tableAccumulator[i] /= maxTableValue;
-
-			// --- store on parabolix table set in one of 128 slots
-			multiTable128[seedMIDINote] = tableAccumulator;
-
-			// --- next table is one octave up
-			if (tableInterval == wtTableInterval::octave)
-			{
-				seedFreq *= 2.0;
-				seedMIDINote += 12;
-			}
-			else if (tableInterval == wtTableInterval::min3rd)
-			{
-				seedFreq *= pow(2.0, (3.0 / 12.0));
-				seedMIDINote += 3;
-			}
-			else if (tableInterval == wtTableInterval::highRes)
-			{
-				seedFreq *= pow(2.0, (1.0 / 12.0));
-				seedMIDINote += 1;
-			}
-		}
-
-		// --- for high-res, we are done!
-		if (tableInterval == wtTableInterval::highRes)
-			return true;
+		BandLimitedTableSpec spec;
+		spec.waveform = waveform;
+		spec.tableInterval = tableInterval;
+		spec.tableLength = tableLength;
+		spec.sampleRate = sampleRate;
 
-		// --- now replicate the table pointers
-		int nLastIndex = -1;
-		int numWaveTables = 128;
+		return BandLimitedTableGenerator::createTables(spec, multiTable128, cacheDirectory);
+	}
 
-		double* pLastTable = NULL;
-		for (int i = 0; i<128; i++)
+	// --- add a mathematically generated, band-limited waveform (wtWaveFormIndex) as a multi-table
+	inline bool addBandLimitedWaveTable(uint32_t waveform, uint32_t tableInterval, uint32_t tableLength, double sampleRate, std::string waveformName)
+	{
+		GeneratedWaveTable generated;
+		generated.spec.waveform = waveform;
+		generated.spec.tableInterval = tableInterval;
+		generated.spec.tableLength = tableLength;
+		generated.wavetable = new Wavetable;
+
+		const BandLimitedTableSet* tableSet = getGeneratedTableSet(generated, sampleRate);
+		if (!tableSet)
 		{
-			if (multiTable128[i])
-			{
-				nLastIndex = i;
-				pLastTable = multiTable128[i];
-			}
+			delete generated.wavetable;
+			return false;
 		}
 
-		if (!pLastTable)
-			return false;// no tables : (
-
-						 // upper part first
-		for (int i = 127; i >= nLastIndex; i--)
-			multiTable128[i] = pLastTable;
-
-		int index = nLastIndex - 1; // first index already has value in it
-		bool bWorking = index >= 0 ? true : false;
-
-		while (bWorking)
-		{
-			if (!multiTable128[index])
-				multiTable128[index] = pLastTable;
-			else
-				pLastTable = multiTable128[index];
-
-			index--;
-
-			if (index < 0)
-				bWorking = false;
-		}
+		Wavetable* wt = generated.wavetable;
+		memcpy(wt->pdMultiTable128, tableSet->tables.data(), MAX_WAVE_TABLES*(sizeof(double*)));
+		wt->tableType = wtTableType::kMultiTable;
+		wt->tableLength = tableLength;
+		wt->waveformName = waveformName;
+		this->addWaveTable(wt);
+		generatedWaveTables.push_back(generated);
 
+		// --- we are enabled!
+		enabled = true;
 		return true;
 	}
 
-
-	// --- generate a sample value based on the harmonic number; these will be accumulated
-	//     in band limited tables.
-	//     Parabola:
-	double generateParabolaHarmonic(uint32_t sampleNum, double harmonicNum, uint32_t tableLength)
-	{
-		// --- prevent divide by 0; no DC component here
-		if (harmonicNum == 0)
-			return 0.0;
-
-		return (1.0 / (harmonicNum*harmonicNum))*cos(2.0*kPi*sampleNum*harmonicNum / tableLength);
-	}
-
-	// --- generate a sample value based on the harmonic number; these will be accumulated
-	//     in band limited tables.
-	//     Triangle:
-	double generateTriangleHarmonic(uint32_t sampleNum, double harmonicNum, uint32_t tableLength)
-	{
-		return pow(-1.0, harmonicNum)*(1.0 / pow((2.0 * harmonicNum + 1.0), (float)2.0))*sin(2.0*kPi*(2.0*harmonicNum + 1)*sampleNum / tableLength);
-	}
-
 	// --- add more mathematical table generation
 
 
@@ -340,19 +260,32 @@ private:
 	// --- state (for user loading)
 	bool enabled = false;
 
-	// --- helper
-	inline uint32_t calculateNumTables(uint32_t seedMIDINote, uint32_t tableIntervalSemitones)
+	// --- a generated multi-table and its table sets, one per sample rate (1/100 Hz key);
+	//     the sets are shared with other plugin instances through the SharedTableStore
+	struct GeneratedWaveTable
 	{
-		uint32_t count = 0;
-		uint32_t nextMIDINote = seedMIDINote;
-		if (seedMIDINote > 127) return 0;
-		if (seedMIDINote == 127) return 1;
-		while (nextMIDINote < 128)
-		{
-			nextMIDINote += tableIntervalSemitones;
-			count++;
-		}
-		return count;
+		Wavetable* wavetable = nullptr;
+		BandLimitedTableSpec spec;
+		std::map<uint64_t, std::shared_ptr<const BandLimitedTableSet>> tableSetsByRate;
+	};
+	std::vector<GeneratedWaveTable> generatedWaveTables;
+
+	// --- find or build the set for this rate
+	const BandLimitedTableSet* getGeneratedTableSet(GeneratedWaveTable& generated, double sampleRate)
+	{
+		uint64_t rateKey = (uint64_t)(sampleRate * 100.0 + 0.5);
+		auto it = generated.tableSetsByRate.find(rateKey);
+		if (it != generated.tableSetsByRate.end())
+			return it->second.get();
+
+		BandLimitedTableSpec spec = generated.spec;
+		spec.sampleRate = sampleRate;
+		std::shared_ptr<const BandLimitedTableSet> tableSet = BandLimitedTableGenerator::acquireTables(spec, BandLimitedTableGenerator::getDefaultCacheDirectory());
+		if (!tableSet)
+			return nullptr;
+
+		generated.tableSetsByRate[rateKey] = tableSet;
+		return tableSet.get();
 	}
 };
 
@@ -0,0 +1,276 @@
+// --- Synth Core v1.0
+//
+#include "wavetabledata.h"
+
+// --- the factory tables; these are large and are included in this one translation unit only
+#include "wavetables\violin.h"
+#include "wavetables\oboe.h"
+#include "wavetables\e_organ.h"
+#include "wavetables\dirty.h"
+#include "wavetables\vox1.h"
+
+#include <chrono>
+
+// --- generated tables
+const uint32_t kBandLimitedTableLength = 1024;
+const std::string kBandLimitedWaveNames[] = { "sine", "parabola", "triangle" };
+
+WaveTableData::WaveTableData()
+	: currentBankSet(nullptr)
+	, activeReaders(0)
+	, stopLoading(false)
+	, loadComplete(false)
+	, currentSampleRate(44100.0)
+{
+	// --- declare the banks here; they are built on the loader thread in this order
+	//     THIS IS WHERE YOU ADD MORE BANKS!! must #include the .h file with the BankDescriptor above
+	bankSources.push_back({ "Violiny Table", &violin_BankDescriptor });
+	bankSources.push_back({ "Oboey Table", &oboe_BankDescriptor });
+	bankSources.push_back({ "Organ Table", &e_organ_BankDescriptor });
+	bankSources.push_back({ "Dirty Table", &dirty_BankDescriptor });
+	bankSources.push_back({ "Vox Table", &vox1_BankDescriptor });
+	bankSources.push_back({ "Classic Table", nullptr, { SINE_WAVE, PARABOLIC_WAVE, TRIANGLE_WAVE } });
+
+	// --- morphing banks: same table sets, scanned with precomputed adjacent pairs
+	morphBankSources.push_back({ "Violiny Morph", &violin_BankDescriptor });
+	morphBankSources.push_back({ "Oboey Morph", &oboe_BankDescriptor });
+
+	// --- sine fallback: one 1024 point table for every note; it is cheap so build it now
+	for (uint32_t i = 0; i < MAX_HIRES_TABLE_SET; i++)
+	{
+		sineTableLengths[i] = 1024;
+		sineTablePtrs[i] = &sin_n1024[0];
+	}
+	sineTableSet.waveformNameForGUI = "sine";
+	sineTableSet.tableLengths = &sineTableLengths[0];
+	sineTableSet.pp_dDecimalTableSet = &sineTablePtrs[0];
+	sineTableSet.tableDataType = wtDataType::decimal;
+
+	BankDescriptor sineBankDescriptor(1, &sineTableSetPtr, nullptr);
+
+	sineWaveBank = new WaveTableBank;
+	sineWaveBank->setWaveBankName("Sine (loading)");
+	sineWaveBank->initializeWithHiResWTBank(sineBankDescriptor);
+
+	sineMorphBank = new MorphingWaveTableBank;
+	sineMorphBank->setMorphWaveBankName("Sine (loading)");
+	sineMorphBank->initializeWithHiResWTBank(sineBankDescriptor);
+
+	// --- first snapshot: nothing loaded yet
+	WaveBankSet* bankSet = new WaveBankSet;
+	bankSet->waveBanks.resize(bankSources.size(), nullptr);
+	bankSet->morphBanks.resize(morphBankSources.size(), nullptr);
+	currentBankSet.store(bankSet, std::memory_order_release);
+
+	// --- start the loader
+	tableWorkerPool = BandLimitedTableGenerator::acquireWorkerPool();
+	bankLoader = std::thread(&WaveTableData::loadBanks, this);
+}
+
+WaveTableData::~WaveTableData()
+{
+	// --- stop and wait for the loader
+	stopLoading.store(true, std::memory_order_release);
+	if (bankLoader.joinable())
+		bankLoader.join();
+
+	// --- no more readers can exist here
+	reclaimRetiredBankSets(true);
+	delete currentBankSet.exchange(nullptr);
+
+	for (uint32_t i = 0; i < ownedWaveBanks.size(); i++)
+		delete ownedWaveBanks[i];
+	ownedWaveBanks.clear();
+
+	for (uint32_t i = 0; i < ownedMorphBanks.size(); i++)
+		delete ownedMorphBanks[i];
+	ownedMorphBanks.clear();
+
+	delete sineWaveBank;
+	delete sineMorphBank;
+}
+
+// --- loader thread
+void WaveTableData::loadBanks()
+{
+	for (uint32_t i = 0; i < bankSources.size(); i++)
+	{
+		if (stopLoading.load(std::memory_order_acquire))
+			return;
+
+		WaveTableBank* bank = new WaveTableBank;
+		bank->setWaveBankName(bankSources[i].bankName);
+		if (bankSources[i].bankDescriptor)
+			bank->initializeWithHiResWTBank(*bankSources[i].bankDescriptor);
+		else
+		{
+			for (uint32_t j = 0; j < bankSources[i].bandLimitedWaveforms.size(); j++)
+			{
+				uint32_t waveform = bankSources[i].bandLimitedWaveforms[j];
+				bank->addBandLimitedWaveTable(waveform, wtTableInterval::min3rd, kBandLimitedTableLength, currentSampleRate.load(), kBandLimitedWaveNames[waveform]);
+			}
+		}
+		ownedWaveBanks.push_back(bank);
+
+		// --- copy, modify, publish; resetWaveBanks() cannot change the rate in between
+		{
+			std::lock_guard<std::mutex> lock(sampleRateMutex);
+			bank->resetWaveTables(currentSampleRate.load());
+
+			WaveBankSet* bankSet = new WaveBankSet(*currentBankSet.load(std::memory_order_acquire));
+			bankSet->waveBanks[i] = bank;
+			publishBankSet(bankSet);
+		}
+		reclaimRetiredBankSets();
+	}
+
+	for (uint32_t i = 0; i < morphBankSources.size(); i++)
+	{
+		if (stopLoading.load(std::memory_order_acquire))
+			return;
+
+		MorphingWaveTableBank* morphBank = new MorphingWaveTableBank;
+		morphBank->setMorphWaveBankName(morphBankSources[i].bankName);
+		morphBank->initializeWithHiResWTBank(*morphBankSources[i].bankDescriptor);
+		ownedMorphBanks.push_back(morphBank);
+
+		{
+			std::lock_guard<std::mutex> lock(sampleRateMutex);
+			morphBank->resetWaveTables(currentSampleRate.load());
+
+			WaveBankSet* bankSet = new WaveBankSet(*currentBankSet.load(std::memory_order_acquire));
+			bankSet->morphBanks[i] = morphBank;
+			publishBankSet(bankSet);
+		}
+		reclaimRetiredBankSets();
+	}
+
+	loadComplete.store(true, std::memory_order_release);
+
+	// --- keep going until the last retired snapshot is gone
+	while (!stopLoading.load(std::memory_order_acquire))
+	{
+		reclaimRetiredBankSets();
+
+		{
+			std::lock_guard<std::mutex> lock(retiredMutex);
+			if (retiredBankSets.size() == 0)
+				return;
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+}
+
+void WaveTableData::publishBankSet(WaveBankSet* newBankSet)
+{
+	RetiredBankSet retired;
+	retired.bankSet = currentBankSet.exchange(newBankSet, std::memory_order_seq_cst);
+
+	std::lock_guard<std::mutex> lock(retiredMutex);
+	retiredBankSets.push_back(retired);
+}
+
+void WaveTableData::reclaimRetiredBankSets(bool force)
+{
+	std::lock_guard<std::mutex> lock(retiredMutex);
+
+	// --- anyone who entered before the swap may still hold the old snapshot; readers
+	//     that enter after the swap can only see the new one
+	if (!force && activeReaders.load(std::memory_order_seq_cst) != 0)
+		return;
+
+	for (uint32_t i = 0; i < retiredBankSets.size(); i++)
+		delete retiredBankSets[i].bankSet;
+	retiredBankSets.clear();
+}
+
+bool WaveTableData::resetWaveBanks(double sampleRate)
+{
+	// --- banks that are still loading will pick this up when they are published
+	std::lock_guard<std::mutex> lock(sampleRateMutex);
+	currentSampleRate.store(sampleRate);
+
+	BankSetReader reader(activeReaders);
+	WaveBankSet* bankSet = currentBankSet.load(std::memory_order_acquire);
+
+	for (uint32_t i = 0; i < bankSet->waveBanks.size(); i++)
+	{
+		if (bankSet->waveBanks[i])
+			bankSet->waveBanks[i]->resetWaveTables(sampleRate);
+	}
+
+	for (uint32_t i = 0; i < bankSet->morphBanks.size(); i++)
+	{
+		if (bankSet->morphBanks[i])
+			bankSet->morphBanks[i]->resetWaveTables(sampleRate);
+	}
+
+	sineWaveBank->resetWaveTables(sampleRate);
+	sineMorphBank->resetWaveTables(sampleRate);
+
+	return bankSources.size() > 0;
+}
+
+IWaveBank* WaveTableData::getInterface(uint32_t waveBankIndex)
+{
+	if (bankSources.size() == 0)
+		return sineWaveBank;
+
+	if (waveBankIndex >= bankSources.size() - 1)
+		waveBankIndex = bankSources.size() - 1;
+
+	BankSetReader reader(activeReaders);
+	WaveTableBank* bank = currentBankSet.load(std::memory_order_acquire)->waveBanks[waveBankIndex];
+
+	return bank ? bank : sineWaveBank;
+}
+
+std::vector<std::string> WaveTableData::getWaveBankNames(uint32_t bankSet)
+{
+	// --- names are known before the banks are loaded
+	std::vector<std::string> stringList;
+	uint32_t bankCount = getNumWaveBanks();
+	uint32_t start = bankSet*MAX_BANKS_PER_OSCILLATOR;
+
+	for (uint32_t i = start; i < start + MAX_BANKS_PER_OSCILLATOR; i++)
+	{
+		if (i < bankCount)
+			stringList.push_back(bankSources[i].bankName);
+		else
+			stringList.push_back("-- empty --");
+	}
+
+	return stringList;
+}
+
+IMorphingWaveBank* WaveTableData::getMorphInterface(uint32_t morphBankIndex)
+{
+	if (morphBankSources.size() == 0)
+		return sineMorphBank;
+
+	if (morphBankIndex >= morphBankSources.size() - 1)
+		morphBankIndex = morphBankSources.size() - 1;
+
+	BankSetReader reader(activeReaders);
+	MorphingWaveTableBank* morphBank = currentBankSet.load(std::memory_order_acquire)->morphBanks[morphBankIndex];
+
+	return morphBank ? morphBank : sineMorphBank;
+}
+
+std::vector<std::string> WaveTableData::getMorphWaveBankNames(uint32_t bankSet)
+{
+	std::vector<std::string> stringList;
+	uint32_t bankCount = getNumMorphWaveBanks();
+	uint32_t start = bankSet*MAX_BANKS_PER_OSCILLATOR;
+
+	for (uint32_t i = start; i < start + MAX_BANKS_PER_OSCILLATOR; i++)
+	{
+		if (i < bankCount)
+			stringList.push_back(morphBankSources[i].bankName);
+		else
+			stringList.push_back("-- empty --");
+	}
+
+	return stringList;
+}
@@ -6,101 +6,129 @@
 
 // --- wavetable objects and structs
 #include "wavetablebank.h"
-#include "wavetables\violin.h"
-#include "wavetables\oboe.h"
+#include "morphwavetablebank.h"
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+
+/**
+\struct WaveBankSet
+\ingroup SynthStructures
+\brief One published snapshot of the loaded banks. Immutable once published; a nullptr slot
+is a bank that has not been loaded yet.
+*/
+struct WaveBankSet
+{
+	std::vector<WaveTableBank*> waveBanks;
+	std::vector<MorphingWaveTableBank*> morphBanks;
+};
+
+/**
+\struct RetiredBankSet
+\ingroup SynthStructures
+\brief A replaced WaveBankSet waiting for reclamation; the banks themselves are owned by WaveTableData
+*/
+struct RetiredBankSet
+{
+	WaveBankSet* bankSet = nullptr;
+};
 
 // --- stores MAX_BANKS_PER_PLUGIN sets of IWaveBanks (128)
 //     NOTE: this is the ONE AND ONLY wavetable datasource for the entire synth
-//           So, initialize everything here. 
+//           So, initialize everything here.
+//
+//     Banks are built on a background thread after construction and published to the
+//     audio thread with an atomic pointer swap; until a bank arrives its slot returns
+//     the sine fallback bank. Banks are never freed before destruction; only the replaced
+//     snapshot containers are, once no reader is inside one.
 class WaveTableData : public IWaveData
 {
 public:
-	WaveTableData()
-	{
-		// --- create wave banks here --- all construction is in this function
-		WaveTableBank* bank_0 = new WaveTableBank;
-		bank_0->setWaveBankName("Violiny Table");
-
-		// --- init from bank; must #include the .h file with these variables inside; they will be different for each table in the bank
-		bank_0->initializeWithHiResWTBank(violin_BankDescriptor);
-
-		// --- add the bank to the container
-		waveBanks.push_back(bank_0);
+	WaveTableData();
+	~WaveTableData();
 
-		WaveTableBank* bank_1 = new WaveTableBank;
-		bank_1->setWaveBankName("Oboey Table");
+	virtual bool resetWaveBanks(double sampleRate);
 
-		// --- init from bank; must #include the .h file with these variables inside; they will be different for each table in the bank
-		bank_1->initializeWithHiResWTBank(oboe_BankDescriptor);
-
-		// --- add the bank to the container
-		waveBanks.push_back(bank_1);
+	// --- never returns nullptr; pending banks return the sine fallback
+	virtual IWaveBank* getInterface(uint32_t waveBankIndex);
 
+	// --- get the number of banks for this datasource (loaded or pending)
+	virtual uint32_t getNumWaveBanks() { return bankSources.size(); }
 
+	// --- returns the names of the waveforms, which are identical to the indexes of waveform selection on the GUI
+	//     If there is no waveform, returns "" for that
+	virtual std::vector<std::string> getWaveBankNames(uint32_t bankSet = 0);
 
-		// --- THIS IS WHERE YOU ADD MORE BANKS!!
-		//     follow above procedure
-	}
+	// --- morphing banks; index is clamped the same way as getInterface()
+	IMorphingWaveBank* getMorphInterface(uint32_t morphBankIndex);
 
-	~WaveTableData()
-	{
-		for (int i = 0; i < waveBanks.size(); i++)
-		{
-			WaveTableBank* wtBank = waveBanks[i];
-			delete wtBank;
-		}
-		waveBanks.clear();
-	}
-
-	virtual bool resetWaveBanks(double sampleRate)
-	{
-		uint32_t bankCount = getNumWaveBanks();
+	// --- get the number of morphing banks (loaded or pending)
+	uint32_t getNumMorphWaveBanks() { return morphBankSources.size(); }
 
-		for (int i = 0; i <bankCount; i++) {
-			WaveTableBank* wtBank = waveBanks[i];
-			wtBank->resetWaveTables(sampleRate);
-		}
+	// --- morphing bank names, padded like getWaveBankNames()
+	std::vector<std::string> getMorphWaveBankNames(uint32_t bankSet = 0);
 
-		return (bool)bankCount;
-	}
+	// --- true when the background loader has published every bank
+	bool isLoadComplete() { return loadComplete.load(std::memory_order_acquire); }
 
-	virtual IWaveBank* getInterface(uint32_t waveBankIndex)
+private:
+	// --- a bank waiting to be built
+	struct WaveBankSource
 	{
-		if (waveBankIndex >= waveBanks.size() - 1)
-			waveBankIndex = waveBanks.size() - 1;
-
-		if (waveBankIndex < 0)
-			return nullptr; // should never happen; will crash
-
-		return waveBanks[waveBankIndex];
-	}
-
-	// --- get the number of banks for this datasource
-	virtual uint32_t getNumWaveBanks() { return waveBanks.size(); }
-
-	// --- returns the names of the waveforms, which are identical to the indexes of waveform selection on the GUI
-	//     If there is no waveform, returns "" for that
-	virtual std::vector<std::string> getWaveBankNames(uint32_t bankSet = 0)
+		std::string bankName;
+		BankDescriptor* bankDescriptor = nullptr;
+
+		// --- when bankDescriptor is nullptr: wtWaveFormIndex list, generated at the current sample rate
+		std::vector<uint32_t> bandLimitedWaveforms;
+	};
+
+	// --- factory banks, in GUI order
+	std::vector<WaveBankSource> bankSources;
+	std::vector<WaveBankSource> morphBankSources;
+
+	// --- the published snapshot
+	std::atomic<WaveBankSet*> currentBankSet;
+
+	// --- readers inside a snapshot right now (audio and GUI threads)
+	std::atomic<int> activeReaders;
+
+	// --- fallback until a bank is loaded
+	uint32_t sineTableLengths[MAX_HIRES_TABLE_SET];
+	double* sineTablePtrs[MAX_HIRES_TABLE_SET];
+	HiResWTSet sineTableSet;
+	HiResWTSet* sineTableSetPtr = &sineTableSet;
+	WaveTableBank* sineWaveBank = nullptr;
+	MorphingWaveTableBank* sineMorphBank = nullptr;
+
+	// --- every bank ever built; owned here
+	std::vector<WaveTableBank*> ownedWaveBanks;
+	std::vector<MorphingWaveTableBank*> ownedMorphBanks;
+
+	// --- background loading; the generator threads are kept for the life of the banks
+	std::shared_ptr<SynthWorkerPool> tableWorkerPool;
+	std::thread bankLoader;
+	std::atomic<bool> stopLoading;
+	std::atomic<bool> loadComplete;
+	std::atomic<double> currentSampleRate;
+	std::mutex sampleRateMutex; // --- a bank is never published at a stale rate
+	void loadBanks();
+
+	// --- publish a new snapshot and retire the old one (loader side only)
+	void publishBankSet(WaveBankSet* newBankSet);
+
+	// --- delete retired snapshots that no one can still see (loader side only)
+	void reclaimRetiredBankSets(bool force = false);
+	std::mutex retiredMutex;
+	std::vector<RetiredBankSet> retiredBankSets;
+
+	// --- RAII reader registration
+	struct BankSetReader
 	{
-		// --- load up a vector of strings
-		std::vector<std::string> stringList;
-		uint32_t bankCount = getNumWaveBanks();
-		uint32_t start = bankSet*MAX_BANKS_PER_OSCILLATOR;
-
-		for (int i = start; i <MAX_BANKS_PER_OSCILLATOR; i++)
-		{
-			if (i < bankCount)
-				stringList.push_back(waveBanks[i]->getWaveBankName());
-			else
-				stringList.push_back("-- empty --");
-		}
-
-		return stringList;
-	}
-
-private:
-	// --- vector of wavetables
-	std::vector<WaveTableBank*> waveBanks;
+		BankSetReader(std::atomic<int>& _readers) : readers(_readers) { readers.fetch_add(1, std::memory_order_seq_cst); }
+		~BankSetReader() { readers.fetch_sub(1, std::memory_order_release); }
+		std::atomic<int>& readers;
+	};
 };
 
 
@@ -2,6 +2,11 @@
 //
 #include "wavetableoscillator.h"
 
+#include <algorithm>
+
+// --- unison lanes start this fraction of a cycle apart (golden ratio) so no two start together
+const double kUnisonPhaseSpread = 0.61803398875;
+
 // --- oscillator
 WaveTableOsc::WaveTableOsc(const std::shared_ptr<MidiInputData> _midiInputData, 
 							std::shared_ptr<SynthOscParameters> _parameters, 
@@ -36,6 +41,8 @@ bool WaveTableOsc::reset(double _sampleRate)
 	detuneInc = 0.0;
 	waveTableReadIndex1 = 0.0;
 	waveTableReadIndex2 = 0.0;
+	pendingSyncBLEP1 = 0.0;
+	pendingSyncBLEP2 = 0.0;
 
 	return true;
 }
@@ -65,10 +72,18 @@ bool WaveTableOsc::doNoteOn(double midiPitch, uint32_t _midiNoteNumber, uint32_t
 		modCounter = 0.0;
 		waveTableReadIndex1 = 0.0;
 		waveTableReadIndex2 = 0.0;
+
+		for (uint32_t i = 0; i < kMaxUnisonVoices; i++)
+		{
+			double phase = i * kUnisonPhaseSpread;
+			unisonReadIndex[i] = (phase - floor(phase)) * currentTableLength;
+		}
 	}
 
 	phaseInc = 0.0;
 	detuneInc = 0.0;
+	pendingSyncBLEP1 = 0.0;
+	pendingSyncBLEP2 = 0.0;
 
 	return true;
 }
@@ -88,6 +103,61 @@ bool WaveTableOsc::update(bool updateAllModRoutings)
 	if (!updateAllModRoutings)
 		return true;
 
+	// --- pitch calculation, shared with the morphing oscillator
+	calculateOscillatorFrequency();
+	setUnisonLanes();
+
+	// --- BANK is set here; can have any number of banks
+	selectedWaveBank = waveTableData->getInterface(getBankIndex(bankSet, parameters->oscillatorBankIndex));
+
+	// --- calculate phase inc; this uses FINAL oscFrequency variable above
+	//
+	//     NOTE: uses selected bank from line of code above; these must be in pairs.
+	waveTableSelection = WaveTableSelection();
+	waveTableSelection.tableLength = kDefaultWaveTableLength;
+
+	// --- with hard sync, the slave is what we hear so its pitch picks the band limit
+	uint32_t tableMidiNoteNumber = renderMidiNoteNumber;
+	if (parameters->enableHardSync)
+		tableMidiNoteNumber = midiNoteNumberFromOscFrequency(oscillatorFrequencySlaveOsc);
+	else if (unisonLaneCount > 1) // --- highest lane
+		tableMidiNoteNumber = midiNoteNumberFromOscFrequency(std::max(oscillatorFrequency, detunedOscFrequency) * unisonDetuneRatio[unisonLaneCount - 1]);
+
+	selectedWaveTable = selectedWaveBank->selectTable(parameters->oscillatorWaveformIndex, tableMidiNoteNumber, waveTableSelection);
+	uint32_t tableLen = waveTableSelection.tableLength;
+	
+	// --- if table size changed, need to reset the current read location
+	//     to be in the same relative location as before
+	if (tableLen != currentTableLength)
+	{
+		// --- need to reset the read location to reflect the new table
+		double position = waveTableReadIndex1 / (double)currentTableLength;
+		waveTableReadIndex1 = position*tableLen;
+		waveTableReadIndex2 = waveTableReadIndex1;
+
+		setUnisonTableLength(tableLen);
+		currentTableLength = tableLen;
+	}
+
+	// --- note that we neex the current table length for this calculation, and we save it
+	phaseInc = calculateWaveTablePhaseInc(oscillatorFrequency, sampleRate, currentTableLength);
+	if (parameters->detuneCents == 0.0) detuneInc = phaseInc;
+	else detuneInc = calculateWaveTablePhaseInc(detunedOscFrequency, sampleRate, currentTableLength);
+
+	// --- hard sync: master runs at the note pitch, slaves at hardSyncRatio times the table reads
+	masterPhaseInc = sampleRate > 0.0 ? oscillatorFrequency / sampleRate : 0.0;
+	slavePhaseInc = calculateWaveTablePhaseInc(oscillatorFrequencySlaveOsc, sampleRate, currentTableLength);
+	if (parameters->detuneCents == 0.0) slaveDetuneInc = slavePhaseInc;
+	else slaveDetuneInc = oscillatorFrequency > 0.0 ? detuneInc * (oscillatorFrequencySlaveOsc / oscillatorFrequency) : 0.0;
+
+	setUnisonPhaseInc(phaseInc, detuneInc);
+	return true;
+}
+
+// --- calculate the FINAL oscillator frequencies after all pitch modulations; also finds
+//     the render MIDI note number used for table selection
+void WaveTableOsc::calculateOscillatorFrequency()
+{
 	// --- calculate MIDI pitch bend range
 	double midiPitchBendRange = midiInputData->globalMIDIData[kMIDIMasterPBSensCoarse] +
 		(midiInputData->globalMIDIData[kMIDIMasterPBSensFine] / 100.0);
@@ -133,7 +203,7 @@ bool WaveTableOsc::update(bool updateAllModRoutings)
 
 	// --- direct calculation version 2^(n/12) - note that this is equal temperatment
 	double pitchShift = pow(2.0, currentPitchModSemitones / 12.0);
-	double detuneShift;
+	double detuneShift = pitchShift;
 	if (parameters->detuneCents != 0.0)
 	{
 		detunePitchModSemitones = glideMod +
@@ -159,33 +229,6 @@ bool WaveTableOsc::update(bool updateAllModRoutings)
 	
 	// --- find the midi note closest to the pitch to select the wavetable
 	renderMidiNoteNumber = midiNoteNumberFromOscFrequency(oscillatorFrequency);	// detune cents shouldn't make this too different
-
-	// --- BANK is set here; can have any number of banks
-	selectedWaveBank = waveTableData->getInterface(getBankIndex(bankSet, parameters->oscillatorBankIndex));
-
-	// --- calculate phase inc; this uses FINAL oscFrequency variable above
-	//
-	//     NOTE: uses selected bank from line of code above; these must be in pairs.
-	uint32_t tableLen = kDefaultWaveTableLength;
-		
-	selectedWaveTable = selectedWaveBank->selectTable(parameters->oscillatorWaveformIndex, renderMidiNoteNumber, tableLen);
-	
-	// --- if table size changed, need to reset the current read location
-	//     to be in the same relative location as before
-	if (tableLen != currentTableLength)
-	{
-		// --- need to reset the read location to reflect the new table
-		double position = waveTableReadIndex1 / (double)currentTableLength;
-		waveTableReadIndex1 = position*tableLen;
-		waveTableReadIndex2 = waveTableReadIndex1;
-		currentTableLength = tableLen;
-	}
-
-	// --- note that we neex the current table length for this calculation, and we save it
-	phaseInc = calculateWaveTablePhaseInc(oscillatorFrequency, sampleRate, currentTableLength);
-	if (parameters->detuneCents == 0.0) detuneInc = phaseInc;
-	else detuneInc = calculateWaveTablePhaseInc(detunedOscFrequency, sampleRate, currentTableLength);
-	return true;
 }
 
 const OscillatorOutputData WaveTableOsc::renderAudioOutput()
@@ -194,14 +237,23 @@ const OscillatorOutputData WaveTableOsc::renderAudioOutput()
 	oscillatorAudioData.outputs[0] = 0.0;
 	oscillatorAudioData.outputs[1] = 0.0;
 
-	// --- render into left channel
-	oscillatorAudioData.outputs[0] = 0.5 * (readWaveTable(waveTableReadIndex1, phaseInc) + readWaveTable(waveTableReadIndex2, detuneInc));
-
-	// --- scale by output amplitude
-	oscillatorAudioData.outputs[0] *= (parameters->outputAmplitude * modulators->modulationInputs[kAmpMod]);
+	// --- render into left channel; unison renders both
+	bool stereoOutput = !parameters->enableHardSync && unisonLaneCount > 1;
+	if (parameters->enableHardSync)
+		oscillatorAudioData.outputs[0] = renderHardSync();
+	else if (stereoOutput)
+		renderUnison(oscillatorAudioData.outputs[0], oscillatorAudioData.outputs[1]);
+	else
+		oscillatorAudioData.outputs[0] = 0.5 * (readWaveTable(waveTableReadIndex1, phaseInc) + readWaveTable(waveTableReadIndex2, detuneInc));
 
 	// --- copy to right channel
-	oscillatorAudioData.outputs[1] = oscillatorAudioData.outputs[0];
+	if (!stereoOutput)
+		oscillatorAudioData.outputs[1] = oscillatorAudioData.outputs[0];
+
+	// --- scale by output amplitude
+	double amplitude = parameters->outputAmplitude * modulators->modulationInputs[kAmpMod];
+	oscillatorAudioData.outputs[0] *= amplitude;
+	oscillatorAudioData.outputs[1] *= amplitude;
 
 	return oscillatorAudioData;
 }
@@ -213,22 +265,15 @@ double WaveTableOsc::readWaveTable(double& readIndex, double _phaseInc)
 	double output = 0.0;
 	double phaseModulator = modulators->modulationInputs[kPhaseMod];
 
-	// --- NOTE: when using hard-sync, phase distortion (oscillator shape) is turned off
-	if (parameters->enableHardSync)
-	{
-		// --- add your hard sync code here!
-	}
-	else
-	{
-		// --- apply phase modulation, if any -- HINT: you can sum phase modulations
-		double phaseModReadIndex = readIndex + phaseModulator * currentTableLength;
+	// --- apply phase modulation, if any -- HINT: you can sum phase modulations
+	//     NOTE: hard sync is rendered in readHardSyncWaveTable( ), without phase modulation
+	double phaseModReadIndex = readIndex + phaseModulator * currentTableLength;
 
-		// --- check for multi-wrapping on new read index
-		checkAndWrapWaveTableIndex(phaseModReadIndex, currentTableLength);
+	// --- check for multi-wrapping on new read index
+	checkAndWrapWaveTableIndex(phaseModReadIndex, currentTableLength);
 
-		// --- do the table read operation
-		output = selectedWaveBank->readWaveTable(selectedWaveTable, phaseModReadIndex);
-	}
+	// --- do the table read operation
+	output = selectedWaveBank->readWaveTable(selectedWaveTable, waveTableSelection, phaseModReadIndex);
 
 	// --- increment index
 	readIndex += _phaseInc;
@@ -236,4 +281,157 @@ double WaveTableOsc::readWaveTable(double& readIndex, double _phaseInc)
 
 	// --- adjust with final volume (amplitude)
 	return output;
-}
\ No newline at end of file
+}
+
+// --- hard sync: modCounter is the master (0 -> 1 at oscillatorFrequency) and the two table
+//     reads are slaves at hardSyncRatio times that; both restart where the master wraps
+double WaveTableOsc::renderHardSync()
+{
+	// --- where the master wraps before the next sample, if it does
+	double wrapFraction = hardSyncWrapFraction(modCounter, masterPhaseInc);
+
+	double output = 0.5 * (readHardSyncWaveTable(waveTableReadIndex1, slavePhaseInc, wrapFraction, pendingSyncBLEP1) +
+						   readHardSyncWaveTable(waveTableReadIndex2, slaveDetuneInc, wrapFraction, pendingSyncBLEP2));
+
+	// --- advance the master
+	modCounter += masterPhaseInc;
+	if (modCounter >= 1.0)
+		modCounter -= 1.0;
+
+	return output;
+}
+
+// --- read one slave and advance it; a restart is a step in the output, so it is smoothed with
+//     a polyBLEP split across this sample and the next (pendingBLEP carries the second half)
+double WaveTableOsc::readHardSyncWaveTable(double& readIndex, double _phaseInc, double wrapFraction, double& pendingBLEP)
+{
+	double output = selectedWaveBank->readWaveTable(selectedWaveTable, waveTableSelection, readIndex) + pendingBLEP;
+	pendingBLEP = 0.0;
+
+	if (wrapFraction > 0.0)
+	{
+		// --- slave value at the instant of the wrap, and where it restarts
+		double syncReadIndex = readIndex + _phaseInc * wrapFraction;
+		checkAndWrapWaveTableIndex(syncReadIndex, currentTableLength);
+		double stepHeight = selectedWaveBank->readWaveTable(selectedWaveTable, waveTableSelection, 0.0) -
+							selectedWaveBank->readWaveTable(selectedWaveTable, waveTableSelection, syncReadIndex);
+
+		output += polyBLEPBeforeStep(stepHeight, wrapFraction);
+		pendingBLEP = polyBLEPAfterStep(stepHeight, wrapFraction);
+
+		// --- restart, keeping the part of the sample interval after the wrap
+		readIndex = _phaseInc * (1.0 - wrapFraction);
+	}
+	else
+		readIndex += _phaseInc;
+
+	checkAndWrapWaveTableIndex(readIndex, currentTableLength);
+	return output;
+}
+
+// --- lane i of N sits at position -1 -> +1 across the spread; detune and pan both follow it.
+//     Only rebuilt when the settings change.
+void WaveTableOsc::setUnisonLanes()
+{
+	uint32_t laneCount = std::min(std::max(parameters->unisonVoices, (uint32_t)1), kMaxUnisonVoices);
+
+	if (laneCount == unisonLaneCount &&
+		parameters->unisonSpreadCents == unisonLaneSpreadCents &&
+		parameters->unisonStereoWidth == unisonLaneStereoWidth)
+		return;
+
+	unisonLaneCount = laneCount;
+	unisonLaneSpreadCents = parameters->unisonSpreadCents;
+	unisonLaneStereoWidth = parameters->unisonStereoWidth;
+
+	// --- uncorrelated lanes add in power; a centered lane has unity gain on each side
+	double laneGain = sqrt(2.0 / (double)laneCount);
+
+	for (uint32_t i = 0; i < laneCount; i++)
+	{
+		double position = laneCount > 1 ? -1.0 + 2.0 * (double)i / (double)(laneCount - 1) : 0.0;
+		unisonDetuneRatio[i] = pow(2.0, position * unisonLaneSpreadCents / 1200.0);
+
+		double pan = position * unisonLaneStereoWidth;
+		boundValue(pan, -1.0, 1.0);
+		calculatePanValues(pan, unisonLeftGain[i], unisonRightGain[i]);
+		unisonLeftGain[i] *= laneGain;
+		unisonRightGain[i] *= laneGain;
+	}
+}
+
+// --- unison lanes are spread around the note pitch; like the two reads of the plain
+//     oscillator, every other lane is at the detuned pitch
+void WaveTableOsc::setUnisonPhaseInc(double _phaseInc, double _detuneInc)
+{
+	for (uint32_t i = 0; i < unisonLaneCount; i++)
+		unisonPhaseInc[i] = ((i & 1) ? _detuneInc : _phaseInc) * unisonDetuneRatio[i];
+}
+
+// --- keep the lanes in the same relative location when the table length changes; call this
+//     before currentTableLength is updated
+void WaveTableOsc::setUnisonTableLength(uint32_t tableLength)
+{
+	if (currentTableLength == 0)
+		return;
+
+	for (uint32_t i = 0; i < kMaxUnisonVoices; i++)
+		unisonReadIndex[i] *= (double)tableLength / (double)currentTableLength;
+}
+
+// --- all lanes read the same table; the loops run over plain arrays so they vectorize, except
+//     for the table lookups themselves, which are gathers
+void WaveTableOsc::renderUnison(double& left, double& right)
+{
+	const uint32_t laneCount = unisonLaneCount;
+	const double tableLength = (double)currentTableLength;
+	const double phaseModOffset = modulators->modulationInputs[kPhaseMod] * tableLength;
+
+	// --- phase modulated read locations, wrapped to [0, tableLength)
+	double laneReadIndex[kMaxUnisonVoices];
+	for (uint32_t i = 0; i < laneCount; i++)
+	{
+		double readIndex = unisonReadIndex[i] + phaseModOffset;
+		laneReadIndex[i] = readIndex - tableLength * floor(readIndex / tableLength);
+	}
+
+	double laneOutput[kMaxUnisonVoices];
+	readUnisonLanes(laneReadIndex, laneOutput);
+
+	// --- pan, sum and advance
+	left = 0.0;
+	right = 0.0;
+	for (uint32_t i = 0; i < laneCount; i++)
+	{
+		left += laneOutput[i] * unisonLeftGain[i];
+		right += laneOutput[i] * unisonRightGain[i];
+
+		unisonReadIndex[i] += unisonPhaseInc[i];
+		unisonReadIndex[i] -= unisonReadIndex[i] >= tableLength ? tableLength : 0.0;
+	}
+}
+
+// --- read the selected table at each lane's location; interpolate straight from the table
+//     when it is stored as doubles
+void WaveTableOsc::readUnisonLanes(const double* laneReadIndex, double* laneOutput)
+{
+	const uint32_t laneCount = unisonLaneCount;
+	double outputScale = 1.0;
+	const double* table = selectedWaveTable->getTableSamples(waveTableSelection, outputScale);
+	if (table)
+	{
+		const uint32_t lastIndex = currentTableLength - 1;
+		for (uint32_t i = 0; i < laneCount; i++)
+		{
+			uint32_t readIndex = std::min((uint32_t)laneReadIndex[i], lastIndex);
+			uint32_t nextReadIndex = readIndex == lastIndex ? 0 : readIndex + 1;
+			double fraction = laneReadIndex[i] - (double)readIndex;
+			laneOutput[i] = outputScale * (table[readIndex] + fraction * (table[nextReadIndex] - table[readIndex]));
+		}
+	}
+	else
+	{
+		for (uint32_t i = 0; i < laneCount; i++)
+			laneOutput[i] = selectedWaveBank->readWaveTable(selectedWaveTable, waveTableSelection, laneReadIndex[i]);
+	}
+}
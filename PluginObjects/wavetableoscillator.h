@@ -13,6 +13,12 @@
 \ingroup SynthClasses
 \brief High_Accuracy wavetable oscillator with three waveforms: AK, FM and VS
 
+With SynthOscParameters::unisonVoices > 1 the oscillator renders that many detuned, phase-spread
+copies of the table read, panned across the stereo field, instead of the normal/detuned pair
+(detuneCents still applies: every other copy is at the detuned pitch); the copies are kept as
+arrays (lanes) so the per-sample loops vectorize. A voice then needs only one filter and EG set
+for a unison note.
+
 \author Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 24
@@ -45,7 +51,7 @@ public:
 	}
 
 	// --- main render function
-	const OscillatorOutputData renderAudioOutput();
+	virtual const OscillatorOutputData renderAudioOutput();
 
 	virtual std::shared_ptr<ModInputData> getModulators() {
 		return modulators;
@@ -69,9 +75,11 @@ protected:
 	// --- shared tables, in case they are huge or need a long creation time
 	std::shared_ptr<WaveTableData> waveTableData = nullptr;
 
-	// --- currently selected bank and wavetable
+	// --- currently selected bank and wavetable; the table for our note is kept here, not in
+	//     the (shared) wavetable
 	IWaveBank* selectedWaveBank = nullptr;
 	IWaveTable* selectedWaveTable = nullptr;
+	WaveTableSelection waveTableSelection;
 
 	// --- **7**
 	uint32_t bankSet = BANK_SET_0;
@@ -79,6 +87,22 @@ protected:
 	// --- for anything
 	double readWaveTable(double& readIndex, double _phaseInc);
 
+	// --- hard sync: modCounter is the master; the table reads are the slaves
+	double renderHardSync();
+	double readHardSyncWaveTable(double& readIndex, double _phaseInc, double wrapFraction, double& pendingBLEP);
+
+	// --- unison: set up the lanes from the parameters, and render them; the derived oscillators
+	//     that read tables share the lanes and supply their own table read
+	void setUnisonLanes();
+	void setUnisonPhaseInc(double _phaseInc, double _detuneInc);
+	void setUnisonTableLength(uint32_t tableLength);
+	void renderUnison(double& left, double& right);
+	virtual void readUnisonLanes(const double* laneReadIndex, double* laneOutput);
+
+	// --- pitch modulation; sets oscillatorFrequency, detunedOscFrequency,
+	//     oscillatorFrequencySlaveOsc and renderMidiNoteNumber
+	void calculateOscillatorFrequency();
+
 	// --- the FINAL frequncy after all modulations
 	double oscillatorFrequency = 440.0;
 	double detunedOscFrequency = 440.0;
@@ -101,6 +125,23 @@ protected:
 	double phaseInc = 0.0;							///<  phase inc = fo/fs
 	double detuneInc = 0.0;		// detuned phaseInc
 	double sampleRate = 0.0;						///<  fs
+
+	// --- hard sync
+	double masterPhaseInc = 0.0;					///<  master fo/fs, for modCounter
+	double slavePhaseInc = 0.0;						///<  table inc at oscillatorFrequencySlaveOsc
+	double slaveDetuneInc = 0.0;
+	double pendingSyncBLEP1 = 0.0;					///<  polyBLEP owed to the sample after a restart
+	double pendingSyncBLEP2 = 0.0;
+
+	// --- unison lanes; lane i is one copy of the table read
+	uint32_t unisonLaneCount = 1;
+	double unisonLaneSpreadCents = 0.0;				///<  settings the lanes were made with
+	double unisonLaneStereoWidth = 0.0;
+	double unisonDetuneRatio[kMaxUnisonVoices] = { 0.0 };	///<  pitch relative to oscillatorFrequency
+	double unisonLeftGain[kMaxUnisonVoices] = { 0.0 };
+	double unisonRightGain[kMaxUnisonVoices] = { 0.0 };
+	double unisonPhaseInc[kMaxUnisonVoices] = { 0.0 };
+	double unisonReadIndex[kMaxUnisonVoices] = { 0.0 };
 	
 	// --- WaveRable oscillator variables
 	double waveTableReadIndex1 = 0.0;		///< wavetable read location
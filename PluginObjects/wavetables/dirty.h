@@ -0,0 +1,80 @@
+#ifndef _dirty
+#define _dirty
+
+#include "dirty_0.h"
+#include "dirty_1.h"
+#include "dirty_2.h"
+#include "dirty_3.h"
+#include "dirty_4.h"
+#include "dirty_5.h"
+#include "dirty_6.h"
+#include "dirty_7.h"
+#include "dirty_8.h"
+#include "dirty_9.h"
+#include "dirty_10.h"
+#include "dirty_11.h"
+#include "dirty_12.h"
+#include "dirty_13.h"
+#include "dirty_14.h"
+#include "dirty_15.h"
+#include "dirty_16.h"
+#include "dirty_17.h"
+#include "dirty_18.h"
+#include "dirty_19.h"
+#include "dirty_20.h"
+#include "dirty_21.h"
+#include "dirty_22.h"
+#include "dirty_23.h"
+#include "dirty_24.h"
+#include "dirty_25.h"
+#include "dirty_26.h"
+#include "dirty_27.h"
+#include "dirty_28.h"
+#include "dirty_29.h"
+#include "dirty_30.h"
+#include "dirty_31.h"
+
+const unsigned int dirty_TablePtrs_tableCount = 32;
+
+static HiResWTSet* dirty_TablePtrs[dirty_TablePtrs_tableCount] = { &dirty_0_TableSet, &dirty_1_TableSet, &dirty_2_TableSet, &dirty_3_TableSet, &dirty_4_TableSet, &dirty_5_TableSet, &dirty_6_TableSet, &dirty_7_TableSet, &dirty_8_TableSet, &dirty_9_TableSet, &dirty_10_TableSet, &dirty_11_TableSet, &dirty_12_TableSet, &dirty_13_TableSet, &dirty_14_TableSet, &dirty_15_TableSet, &dirty_16_TableSet, &dirty_17_TableSet, &dirty_18_TableSet, &dirty_19_TableSet, &dirty_20_TableSet, &dirty_21_TableSet, &dirty_22_TableSet, &dirty_23_TableSet, &dirty_24_TableSet, &dirty_25_TableSet, &dirty_26_TableSet, &dirty_27_TableSet, &dirty_28_TableSet, &dirty_29_TableSet, &dirty_30_TableSet, &dirty_31_TableSet }; 
+
+// --- Define Wavform Names: Here is where you can override the table names all at once;
+//     Remember to keep the names short and simple, refrain from the underscore, and keep the character count below 32 for compatibiltiy with brick files.
+static std::string dirty_TableNames[dirty_TablePtrs_tableCount] = { 
+	"dirty 0",
+	"dirty 1",
+	"dirty 2",
+	"dirty 3",
+	"dirty 4",
+	"dirty 5",
+	"dirty 6",
+	"dirty 7",
+	"dirty 8",
+	"dirty 9",
+	"dirty 10",
+	"dirty 11",
+	"dirty 12",
+	"dirty 13",
+	"dirty 14",
+	"dirty 15",
+	"dirty 16",
+	"dirty 17",
+	"dirty 18",
+	"dirty 19",
+	"dirty 20",
+	"dirty 21",
+	"dirty 22",
+	"dirty 23",
+	"dirty 24",
+	"dirty 25",
+	"dirty 26",
+	"dirty 27",
+	"dirty 28",
+	"dirty 29",
+	"dirty 30",
+	"dirty 31" }; 
+
+// --- This is the bank descriptor; you can initialize the bank with it. 
+static BankDescriptor dirty_BankDescriptor(dirty_TablePtrs_tableCount, &dirty_TablePtrs[0], &dirty_TableNames[0]);
+
+#endif // definer
@@ -40,4 +40,43 @@ const unsigned int e_organ_TablePtrs_tableCount = 32;
 // the master table, full of pointers to the other tablesets
 static HiResWTSet* e_organ_TablePtrs[e_organ_TablePtrs_tableCount] = { &Organ_0_TableSet, &Organ_1_TableSet, &Organ_2_TableSet, &Organ_3_TableSet, &Organ_4_TableSet, &Organ_5_TableSet, &Organ_6_TableSet, &Organ_7_TableSet, &Organ_8_TableSet, &Organ_9_TableSet, &Organ_10_TableSet, &Organ_11_TableSet, &Organ_12_TableSet, &Organ_13_TableSet, &Organ_14_TableSet, &Organ_15_TableSet, &Organ_16_TableSet, &Organ_17_TableSet, &Organ_18_TableSet, &Organ_19_TableSet, &Organ_20_TableSet, &Organ_21_TableSet, &Organ_22_TableSet, &Organ_23_TableSet, &Organ_24_TableSet, &Organ_25_TableSet, &Organ_26_TableSet, &Organ_27_TableSet, &Organ_28_TableSet, &Organ_29_TableSet, &Organ_30_TableSet, &Organ_31_TableSet }; 
 
+// --- Define Wavform Names: Here is where you can override the table names all at once;
+//     Remember to keep the names short and simple, refrain from the underscore, and keep the character count below 32 for compatibiltiy with brick files.
+static std::string e_organ_TableNames[e_organ_TablePtrs_tableCount] = { 
+	"organ 0",
+	"organ 1",
+	"organ 2",
+	"organ 3",
+	"organ 4",
+	"organ 5",
+	"organ 6",
+	"organ 7",
+	"organ 8",
+	"organ 9",
+	"organ 10",
+	"organ 11",
+	"organ 12",
+	"organ 13",
+	"organ 14",
+	"organ 15",
+	"organ 16",
+	"organ 17",
+	"organ 18",
+	"organ 19",
+	"organ 20",
+	"organ 21",
+	"organ 22",
+	"organ 23",
+	"organ 24",
+	"organ 25",
+	"organ 26",
+	"organ 27",
+	"organ 28",
+	"organ 29",
+	"organ 30",
+	"organ 31" }; 
+
+// --- This is the bank descriptor; you can initialize the bank with it. 
+static BankDescriptor e_organ_BankDescriptor(e_organ_TablePtrs_tableCount, &e_organ_TablePtrs[0], &e_organ_TableNames[0]);
+
 #endif // definer
@@ -1,41 +0,0 @@
-#ifndef _new_sound
-#define _new_sound
-
-#include "dirty_0.h"
-#include "dirty_1.h"
-#include "dirty_2.h"
-#include "dirty_3.h"
-#include "dirty_4.h"
-#include "dirty_5.h"
-#include "dirty_6.h"
-#include "dirty_7.h"
-#include "dirty_8.h"
-#include "dirty_9.h"
-#include "dirty_10.h"
-#include "dirty_11.h"
-#include "dirty_12.h"
-#include "dirty_13.h"
-#include "dirty_14.h"
-#include "dirty_15.h"
-#include "dirty_16.h"
-#include "dirty_17.h"
-#include "dirty_18.h"
-#include "dirty_19.h"
-#include "dirty_20.h"
-#include "dirty_21.h"
-#include "dirty_22.h"
-#include "dirty_23.h"
-#include "dirty_24.h"
-#include "dirty_25.h"
-#include "dirty_26.h"
-#include "dirty_27.h"
-#include "dirty_28.h"
-#include "dirty_29.h"
-#include "dirty_30.h"
-#include "dirty_31.h"
-
-const unsigned int new_sound_TablePtrs_tableCount = 32;
-
-static HiResWTSet* new_sound_TablePtrs[new_sound_TablePtrs_tableCount] = { &dirty_0_TableSet, &dirty_1_TableSet, &dirty_2_TableSet, &dirty_3_TableSet, &dirty_4_TableSet, &dirty_5_TableSet, &dirty_6_TableSet, &dirty_7_TableSet, &dirty_8_TableSet, &dirty_9_TableSet, &dirty_10_TableSet, &dirty_11_TableSet, &dirty_12_TableSet, &dirty_13_TableSet, &dirty_14_TableSet, &dirty_15_TableSet, &dirty_16_TableSet, &dirty_17_TableSet, &dirty_18_TableSet, &dirty_19_TableSet, &dirty_20_TableSet, &dirty_21_TableSet, &dirty_22_TableSet, &dirty_23_TableSet, &dirty_24_TableSet, &dirty_25_TableSet, &dirty_26_TableSet, &dirty_27_TableSet, &dirty_28_TableSet, &dirty_29_TableSet, &dirty_30_TableSet, &dirty_31_TableSet }; 
-
-#endif // definer
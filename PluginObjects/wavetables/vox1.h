@@ -0,0 +1,80 @@
+#ifndef _vox1
+#define _vox1
+
+#include "vox1_0.h"
+#include "vox1_1.h"
+#include "vox1_2.h"
+#include "vox1_3.h"
+#include "vox1_4.h"
+#include "vox1_5.h"
+#include "vox1_6.h"
+#include "vox1_7.h"
+#include "vox1_8.h"
+#include "vox1_9.h"
+#include "vox1_10.h"
+#include "vox1_11.h"
+#include "vox1_12.h"
+#include "vox1_13.h"
+#include "vox1_14.h"
+#include "vox1_15.h"
+#include "vox1_16.h"
+#include "vox1_17.h"
+#include "vox1_18.h"
+#include "vox1_19.h"
+#include "vox1_20.h"
+#include "vox1_21.h"
+#include "vox1_22.h"
+#include "vox1_23.h"
+#include "vox1_24.h"
+#include "vox1_25.h"
+#include "vox1_26.h"
+#include "vox1_27.h"
+#include "vox1_28.h"
+#include "vox1_29.h"
+#include "vox1_30.h"
+#include "vox1_31.h"
+
+const unsigned int vox1_TablePtrs_tableCount = 32;
+
+static HiResWTSet* vox1_TablePtrs[vox1_TablePtrs_tableCount] = { &vox1_0_TableSet, &vox1_1_TableSet, &vox1_2_TableSet, &vox1_3_TableSet, &vox1_4_TableSet, &vox1_5_TableSet, &vox1_6_TableSet, &vox1_7_TableSet, &vox1_8_TableSet, &vox1_9_TableSet, &vox1_10_TableSet, &vox1_11_TableSet, &vox1_12_TableSet, &vox1_13_TableSet, &vox1_14_TableSet, &vox1_15_TableSet, &vox1_16_TableSet, &vox1_17_TableSet, &vox1_18_TableSet, &vox1_19_TableSet, &vox1_20_TableSet, &vox1_21_TableSet, &vox1_22_TableSet, &vox1_23_TableSet, &vox1_24_TableSet, &vox1_25_TableSet, &vox1_26_TableSet, &vox1_27_TableSet, &vox1_28_TableSet, &vox1_29_TableSet, &vox1_30_TableSet, &vox1_31_TableSet }; 
+
+// --- Define Wavform Names: Here is where you can override the table names all at once;
+//     Remember to keep the names short and simple, refrain from the underscore, and keep the character count below 32 for compatibiltiy with brick files.
+static std::string vox1_TableNames[vox1_TablePtrs_tableCount] = { 
+	"vox 0",
+	"vox 1",
+	"vox 2",
+	"vox 3",
+	"vox 4",
+	"vox 5",
+	"vox 6",
+	"vox 7",
+	"vox 8",
+	"vox 9",
+	"vox 10",
+	"vox 11",
+	"vox 12",
+	"vox 13",
+	"vox 14",
+	"vox 15",
+	"vox 16",
+	"vox 17",
+	"vox 18",
+	"vox 19",
+	"vox 20",
+	"vox 21",
+	"vox 22",
+	"vox 23",
+	"vox 24",
+	"vox 25",
+	"vox 26",
+	"vox 27",
+	"vox 28",
+	"vox 29",
+	"vox 30",
+	"vox 31" }; 
+
+// --- This is the bank descriptor; you can initialize the bank with it. 
+static BankDescriptor vox1_BankDescriptor(vox1_TablePtrs_tableCount, &vox1_TablePtrs[0], &vox1_TableNames[0]);
+
+#endif // definer